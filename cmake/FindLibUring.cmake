@@ -0,0 +1,75 @@
+################################################################################
+# 
+# MIT License
+# 
+# Copyright (c) 2024 Advanced Micro Devices, Inc.
+# 
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+# 
+################################################################################
+find_path(LIBURING_INCLUDE_DIRS
+    NAMES liburing.h
+    HINTS
+    $ENV{LIBURING_DIR}/include
+    PATHS
+    ${LIBURING_DIR}/include
+    /usr/include
+    /usr/local/include
+)
+mark_as_advanced(LIBURING_INCLUDE_DIRS)
+
+find_library(LIBURING_LIBRARIES
+    NAMES uring
+    HINTS
+    $ENV{LIBURING_DIR}/lib
+    $ENV{LIBURING_DIR}/lib64
+    PATHS
+    ${LIBURING_DIR}/lib
+    ${LIBURING_DIR}/lib64
+    /usr/local/lib
+    /usr/local/lib64
+    /usr/lib
+    /usr/lib64
+)
+mark_as_advanced(LIBURING_LIBRARIES)
+
+if(LIBURING_LIBRARIES AND LIBURING_INCLUDE_DIRS)
+    set(LIBURING_FOUND TRUE)
+endif( )
+
+include( FindPackageHandleStandardArgs )
+find_package_handle_standard_args( LibUring
+    FOUND_VAR  LIBURING_FOUND
+    REQUIRED_VARS
+        LIBURING_LIBRARIES
+        LIBURING_INCLUDE_DIRS
+)
+
+set(LIBURING_FOUND ${LIBURING_FOUND} CACHE INTERNAL "")
+set(LIBURING_LIBRARIES ${LIBURING_LIBRARIES} CACHE INTERNAL "")
+set(LIBURING_INCLUDE_DIRS ${LIBURING_INCLUDE_DIRS} CACHE INTERNAL "")
+
+if(LIBURING_FOUND)
+    message("-- ${White}Using liburing -- \n\tLibraries:${LIBURING_LIBRARIES} \n\tIncludes:${LIBURING_INCLUDE_DIRS}${ColourReset}")
+else()
+    if(LibUring_FIND_REQUIRED)
+        message(FATAL_ERROR "{Red}FindLibUring -- NOT FOUND${ColourReset}")
+    endif()
+    message( "-- ${Yellow}NOTE: FindLibUring failed to find -- liburing${ColourReset}" )
+endif()
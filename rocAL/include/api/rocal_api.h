@@ -50,9 +50,12 @@ THE SOFTWARE.
  * \param [in] cpu_thread_count number of cpu threads
  * \param [in] prefetch_queue_depth The depth of the prefetch queue.
  * \param [in] output_tensor_data_type RocalTensorOutputType: Defines whether the output of rocal tensor is FP32 or FP16.
+ * \param [in] numa_policy RocalNumaPolicy: Defines the NUMA node the loader, decode and graph threads and the host buffers of the pipeline are bound to.
+ * \param [in] numa_node NUMA node used with ROCAL_NUMA_NODE, ignored otherwise.
  * \return A \ref RocalContext - The context for the pipeline
  */
-extern "C" RocalContext ROCAL_API_CALL rocalCreate(size_t batch_size, RocalProcessMode affinity, int gpu_id = 0, size_t cpu_thread_count = 1, size_t prefetch_queue_depth = 3, RocalTensorOutputType output_tensor_data_type = RocalTensorOutputType::ROCAL_FP32);
+extern "C" RocalContext ROCAL_API_CALL rocalCreate(size_t batch_size, RocalProcessMode affinity, int gpu_id = 0, size_t cpu_thread_count = 1, size_t prefetch_queue_depth = 3, RocalTensorOutputType output_tensor_data_type = RocalTensorOutputType::ROCAL_FP32,
+                                                   RocalNumaPolicy numa_policy = ROCAL_NUMA_NONE, int numa_node = -1);
 
 /*!
  * \brief  rocalVerify function to verify the graph for all the inputs and outputs
@@ -63,6 +66,68 @@ extern "C" RocalContext ROCAL_API_CALL rocalCreate(size_t batch_size, RocalProce
  */
 extern "C" RocalStatus ROCAL_API_CALL rocalVerify(RocalContext context);
 
+/*!
+ * \brief  rocalSetPipelinedExecution function to overlap the metadata processing and the box encoding of a batch with the graph execution of the neighbouring batches. Must be called before rocalVerify.
+ * \ingroup group_rocal
+ *
+ * \param [in] context the rocal context
+ * \param [in] enable true to run the metadata processing and the box encoding on their own threads, false (default) to run them on the processing thread
+ * \return A \ref RocalStatus - A status code indicating the success or failure
+ */
+extern "C" RocalStatus ROCAL_API_CALL rocalSetPipelinedExecution(RocalContext context, bool enable);
+
+/*!
+ * \brief  rocalSetGraphReplicaCount function to process several batches concurrently, each on its own copy of the augmentation graph. The batches are still output in order. Must be called before the loader is created.
+ * \ingroup group_rocal
+ *
+ * \param [in] context the rocal context
+ * \param [in] replica_count number of graph copies, 1 (default) runs a single graph. Only used with the CPU affinity and image loaders when the metadata is not augmented, and limited to the prefetch queue depth minus one. The CPU threads of the context are split among the copies
+ * \return A \ref RocalStatus - A status code indicating the success or failure
+ */
+extern "C" RocalStatus ROCAL_API_CALL rocalSetGraphReplicaCount(RocalContext context, unsigned replica_count);
+
+/*!
+ * \brief  rocalSetGraphFusion function to replace each chain of brightness, contrast, exposure, hue, saturation and color twist augmentations whose intermediate outputs are not used elsewhere with a single augmentation applying the composed changes. Must be called before rocalVerify.
+ * \ingroup group_rocal
+ *
+ * \param [in] context the rocal context
+ * \param [in] enable true to fuse the chains, false (default) to run every augmentation. The intermediate values of a fused chain are not clipped nor rounded, so its output can differ slightly
+ * \return A \ref RocalStatus - A status code indicating the success or failure
+ */
+extern "C" RocalStatus ROCAL_API_CALL rocalSetGraphFusion(RocalContext context, bool enable);
+
+/*!
+ * \brief  rocalSetContinuousEpochs function to keep loading and processing the next epoch while the user drains the current one, so the first batches of an epoch are ready when rocalResetLoaders is called. Must be called before rocalVerify.
+ * \ingroup group_rocal
+ *
+ * \param [in] context the rocal context
+ * \param [in] enable true to go on with the next epoch, with its new shuffle, as soon as the current one is loaded, false (default) to wait for rocalResetLoaders. Not used when the readers loop over the data or an external source is read
+ * \return A \ref RocalStatus - A status code indicating the success or failure
+ */
+extern "C" RocalStatus ROCAL_API_CALL rocalSetContinuousEpochs(RocalContext context, bool enable);
+
+/*!
+ * \brief  rocalSetTaskPriority function to set the urgency of the decode, metadata and output copy tasks of the pipeline in the thread pool shared by all the pipelines of the process. Must be called before the loader is created.
+ * \ingroup group_rocal
+ *
+ * \param [in] context the rocal context
+ * \param [in] priority the priority of the tasks of the pipeline, ROCAL_TASK_PRIORITY_NORMAL by default
+ * \return A \ref RocalStatus - A status code indicating the success or failure
+ */
+extern "C" RocalStatus ROCAL_API_CALL rocalSetTaskPriority(RocalContext context, RocalTaskPriority priority);
+
+/*!
+ * \brief  rocalSetPrefetchAutotune function to let the pipeline adjust its prefetch queue depths and the split of its CPU threads between decoding and output processing to the stalls it measures between its stages. Must be called before the loader is created.
+ * \ingroup group_rocal
+ *
+ * \param [in] context the rocal context
+ * \param [in] enable true to autotune, false (default) to keep the prefetch queue depth and the thread count given to rocalCreate
+ * \param [in] warmup_batch_count number of batches over which the settings are adjusted every few batches, they are adjusted every warmup_batch_count batches after that
+ * \param [in] max_prefetch_memory bytes the loader and output buffers can take to deepen the prefetch queues beyond prefetch_queue_depth, 0 only lets them shrink
+ * \return A \ref RocalStatus - A status code indicating the success or failure
+ */
+extern "C" RocalStatus ROCAL_API_CALL rocalSetPrefetchAutotune(RocalContext context, bool enable, size_t warmup_batch_count, size_t max_prefetch_memory);
+
 /*!
  * \brief  rocalRun function to process and run the built and verified graph.
  * \ingroup group_rocal
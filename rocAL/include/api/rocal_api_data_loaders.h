@@ -790,6 +790,39 @@ extern "C" RocalTensor ROCAL_API_CALL rocalRawCIFAR10Source(RocalContext context
  */
 extern "C" RocalStatus ROCAL_API_CALL rocalResetLoaders(RocalContext context);
 
+/*! \brief Sets how the image loaders read the compressed files, must be called before the loader is created
+ * \ingroup group_rocal_data_loaders
+ * \param [in] context Rocal Context
+ * \param [in] file_read_mode ROCAL_FILE_READ_COPY (default) or one of the memory mapped modes. Mapped modes are honored by the file and MXNet RecordIO readers and ignored by the others
+ * \return Rocal status value
+ */
+extern "C" RocalStatus ROCAL_API_CALL rocalSetFileReadMode(RocalContext context, RocalFileReadMode file_read_mode);
+
+/*! \brief Enables the persistent dataset manifests, must be called before the loader and the label reader are created
+ * \ingroup group_rocal_data_loaders
+ * \param [in] context Rocal Context
+ * \param [in] manifest_dir Directory where the listing and the image dimensions of each dataset folder are kept between runs, an empty string disables the manifests. Used by the folder, COCO and sequence file readers and the folder label reader
+ * \return Rocal status value
+ */
+extern "C" RocalStatus ROCAL_API_CALL rocalSetDatasetManifestDir(RocalContext context, const char* manifest_dir);
+
+/*! \brief Sets the fraction of the images read to find the decode size of the image loaders not given a max width and height, must be called before the loader is created
+ * \ingroup group_rocal_data_loaders
+ * \param [in] context Rocal Context
+ * \param [in] sample_fraction Fraction in (0, 1] of the images, evenly spread over the data set, whose headers are read. 1 (default) reads all of them
+ * \param [in] safety_margin Relative margin added to the maximum size found when sampling with ROCAL_USE_MAX_SIZE and ROCAL_USE_MAX_SIZE_RESTRICTED, e.g. 0.1 for 10%
+ * \return Rocal status value
+ */
+extern "C" RocalStatus ROCAL_API_CALL rocalSetImageSizeEvaluationSampling(RocalContext context, float sample_fraction, float safety_margin);
+
+/*! \brief Forms the batches of the image loaders from images of similar size, must be called before the loader is created
+ * \ingroup group_rocal_data_loaders
+ * \param [in] context Rocal Context
+ * \param [in] pool_batch_count Number of batches of images read ahead, whose headers are decoded to sort them by area and cut them into batches. 0 (default) disables the bucketing. With shuffle the order of the buckets is shuffled
+ * \return Rocal status value
+ */
+extern "C" RocalStatus ROCAL_API_CALL rocalSetSizeBucketing(RocalContext context, size_t pool_batch_count);
+
 /*! \brief Creates JPEG image reader and partial decoder for Caffe LMDB records. It allocates the resources and objects required to read and decode Jpeg images stored in Caffe2 LMDB Records. It has internal sharding capability to load/decode in parallel is user wants.
  * \ingroup group_rocal_data_loaders
  * \param [in] rocal_context Rocal context
@@ -48,7 +48,7 @@ extern "C" RocalStatus ROCAL_API_CALL rocalCopyToOutput(RocalContext context, un
  * \param [in] rocal_context Rocal context
  * \param [in] out_ptr pointer to output buffer
  * \param [in] tensor_format the layout of the tensor data
- * \param [in] tensor_output_type the output type of the tensor data
+ * \param [in] tensor_output_type the output type of the tensor data, BF16 and UINT8 (rounded and saturated) are only supported in host memory
  * \param [in] multiplier0 the multiplier for channel 0
  * \param [in] multiplier1 the multiplier for channel 1
  * \param [in] multiplier2 the multiplier for channel 2
@@ -82,6 +82,39 @@ extern "C" void ROCAL_API_CALL rocalSetOutputs(RocalContext p_context, unsigned
  */
 extern "C" RocalTensorList ROCAL_API_CALL rocalGetOutputTensors(RocalContext p_context);
 
+/*!
+ * \brief Lends the output tensors of the last processed batch to the user, without copying them out of the internal ring buffer
+ * \ingroup group_rocal_data_transfer
+ * \param [in] p_context Rocal Context
+ * \return The borrowed outputs, nullptr on error. The ring buffer doesn't write into their memory again until rocalReleaseOutputTensors() is called,
+ *         they stay valid after the next rocalRun() and even after rocalRelease()
+ */
+extern "C" RocalBorrowedOutput ROCAL_API_CALL rocalBorrowOutputTensors(RocalContext p_context);
+
+/*!
+ * \brief gives the list of the borrowed output tensors, the buffer() of each tensor points at the memory of the ring buffer
+ * \ingroup group_rocal_data_transfer
+ * \param [in] borrowed_output The outputs returned by rocalBorrowOutputTensors()
+ * \return A RocalTensorList valid until rocalReleaseOutputTensors() is called
+ */
+extern "C" RocalTensorList ROCAL_API_CALL rocalGetBorrowedTensors(RocalBorrowedOutput borrowed_output);
+
+/*!
+ * \brief gives the id of the device the borrowed output tensors are on, for outputs in GPU memory
+ * \ingroup group_rocal_data_transfer
+ * \param [in] borrowed_output The outputs returned by rocalBorrowOutputTensors()
+ * \return The device id
+ */
+extern "C" int ROCAL_API_CALL rocalGetBorrowedDeviceId(RocalBorrowedOutput borrowed_output);
+
+/*!
+ * \brief Returns the borrowed outputs to the ring buffer, which can write the next batches into their memory again
+ * \ingroup group_rocal_data_transfer
+ * \param [in] borrowed_output The outputs returned by rocalBorrowOutputTensors(), not valid anymore after the call
+ * \return Rocal status indicating success or failure
+ */
+extern "C" RocalStatus ROCAL_API_CALL rocalReleaseOutputTensors(RocalBorrowedOutput borrowed_output);
+
 /*!
  * \brief Creates ExternalSourceFeedInput for data transfer
  * \ingroup group_rocal_data_transfer
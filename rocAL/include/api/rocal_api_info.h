@@ -89,6 +89,22 @@ extern "C" size_t ROCAL_API_CALL rocalGetImageHeight(RocalTensor image);
  */
 extern "C" size_t ROCAL_API_CALL rocalGetImagePlanes(RocalTensor image);
 
+/*!
+ * \brief Retrieves the largest ROI width of the samples of the current batch, e.g. the widest image of a size bucket.
+ * \ingroup group_rocal_info
+ * \param [in] image The RocalTensor data.
+ * \return The largest ROI width, at most rocalGetImageWidth().
+ */
+extern "C" size_t ROCAL_API_CALL rocalGetROIMaxWidth(RocalTensor image);
+
+/*!
+ * \brief Retrieves the largest ROI height of the samples of the current batch, e.g. the tallest image of a size bucket.
+ * \ingroup group_rocal_info
+ * \param [in] image The RocalTensor data.
+ * \return The largest ROI height, at most rocalGetImageHeight().
+ */
+extern "C" size_t ROCAL_API_CALL rocalGetROIMaxHeight(RocalTensor image);
+
 /*!
  * \brief Checks if the RocalContext is empty.
  * \ingroup group_rocal_info
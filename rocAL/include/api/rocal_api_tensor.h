@@ -41,6 +41,9 @@ class rocalTensor {
     virtual void* buffer() = 0;
     virtual unsigned copy_data(void* user_buffer, RocalOutputMemType external_mem_type = ROCAL_MEMCPY_HOST) = 0;
     virtual unsigned copy_data(void* user_buffer, uint x_offset, uint y_offset, uint max_cols, uint max_rows) = 0; // Copy only the ROI to the user_buffer [The padded region is not copied]
+    virtual size_t ragged_sample_count() = 0;  // Samples copied by copy_data_ragged, the frames of all the sequences for sequence layouts
+    virtual size_t ragged_data_size() = 0;  // Bytes the samples take when each keeps only its own ROI
+    virtual unsigned copy_data_ragged(void* user_buffer, size_t* sample_offsets, RocalOutputMemType external_mem_type = ROCAL_MEMCPY_HOST) = 0; // Copy the ROI of each sample packed one after the other [The padded region is not copied], the byte offset of each of the ragged_sample_count() samples is written to sample_offsets
     virtual unsigned num_of_dims() = 0;
     virtual unsigned batch_size() = 0;
     virtual std::vector<size_t> dims() = 0;
@@ -62,6 +62,11 @@ typedef void* RocalIntParam;
  */
 typedef void* RocalContext;
 
+/*! \brief typedef void* rocAL Borrowed Output, the output tensors of a batch lent to the user without a copy
+ * \ingroup group_rocal_types
+ */
+typedef void* RocalBorrowedOutput;
+
 /*! \brief typedef std::vectors
  * \ingroup group_rocal_types
  */
@@ -81,6 +86,7 @@ struct TimingInfo {
     long long unsigned decode_time;
     long long unsigned process_time;
     long long unsigned transfer_time;
+    long long unsigned decode_tail_time;  //!< Part of the decode time during which some decode threads are idle, waiting on the last images of the batches
 };
 
 // HRNet training expects meta data (joints_data) in below format, so added here as a type for exposing to user
@@ -255,7 +261,10 @@ enum RocalTensorOutputType {
     ROCAL_UINT32 = 4,
     /*! \brief AMD ROCAL_INT32
      */
-    ROCAL_INT32 = 5
+    ROCAL_INT32 = 5,
+    /*! \brief AMD ROCAL_BF16
+     */
+    ROCAL_BF16 = 6
 };
 
 /*! \brief rocAL Decoder Type enum
@@ -453,6 +462,51 @@ enum RocalLastBatchPolicy {
     ROCAL_LAST_BATCH_PARTIAL = 2
 };
 
+/*! \brief rocAL File Read Mode enum
+ * \ingroup group_rocal_types
+ */
+enum RocalFileReadMode {
+    /*! \brief ROCAL_FILE_READ_COPY - The compressed files are read into the reader's buffers
+     */
+    ROCAL_FILE_READ_COPY = 0,
+    /*! \brief ROCAL_FILE_READ_MMAP - The compressed files are memory mapped and consumed in place by the decoder, pages are prefetched with madvise(MADV_WILLNEED)
+     */
+    ROCAL_FILE_READ_MMAP = 1,
+    /*! \brief ROCAL_FILE_READ_MMAP_POPULATE - Same as ROCAL_FILE_READ_MMAP but the pages are faulted in when the file is mapped (MAP_POPULATE)
+     */
+    ROCAL_FILE_READ_MMAP_POPULATE = 2
+};
+
+/*! \brief rocAL Task Priority enum
+ * \ingroup group_rocal_types
+ */
+enum RocalTaskPriority {
+    /*! \brief ROCAL_TASK_PRIORITY_HIGH - The tasks of the pipeline run before the pending tasks of the other pipelines
+     */
+    ROCAL_TASK_PRIORITY_HIGH = 0,
+    /*! \brief ROCAL_TASK_PRIORITY_NORMAL - Default priority
+     */
+    ROCAL_TASK_PRIORITY_NORMAL = 1,
+    /*! \brief ROCAL_TASK_PRIORITY_LOW - The tasks of the pipeline run once the other pipelines have no pending tasks
+     */
+    ROCAL_TASK_PRIORITY_LOW = 2
+};
+
+/*! \brief rocAL NUMA Policy enum
+ * \ingroup group_rocal_types
+ */
+enum RocalNumaPolicy {
+    /*! \brief ROCAL_NUMA_NONE - The threads and the buffers of the pipeline are left to the operating system
+     */
+    ROCAL_NUMA_NONE = 0,
+    /*! \brief ROCAL_NUMA_GPU_LOCAL - The threads and the host buffers of the pipeline are kept on the NUMA node the GPU is attached to
+     */
+    ROCAL_NUMA_GPU_LOCAL = 1,
+    /*! \brief ROCAL_NUMA_NODE - The threads and the host buffers of the pipeline are kept on the NUMA node given by the user
+     */
+    ROCAL_NUMA_NODE = 2
+};
+
 /*! \brief  rocAL RocalShardingInfo enum
  * \ingroup group_rocal_types
  */
@@ -30,6 +30,7 @@ class ResampleNode : public Node {
     ResampleNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs);
     ResampleNode() = delete;
     void init(Tensor *resample_rate, float quality);
+    bool is_replicable() override { return false; }  // The resample rate tensor is not among the node inputs
 
    protected:
     void create_node() override;
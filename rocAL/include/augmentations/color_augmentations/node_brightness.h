@@ -25,14 +25,20 @@ THE SOFTWARE.
 #include "pipeline/node.h"
 #include "parameters/parameter_factory.h"
 #include "parameters/parameter_vx.h"
+#include "augmentations/color_augmentations/pointwise_color_node.h"
 
-class BrightnessNode : public Node {
+class BrightnessNode : public Node, public PointwiseColorNode {
    public:
     BrightnessNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs);
     BrightnessNode() = delete;
 
     void init(float alpha, float beta);
     void init(FloatParam *alpha_param, FloatParam *beta_param);
+    int color_transform_parts() override { return SCALE | OFFSET; }
+    void init_color_transforms() override;
+    void color_transforms(std::vector<ColorTransform> &transforms) override;
+    bool is_identity(size_t sample_idx) override { return _alpha.is_identity(sample_idx) && _beta.is_identity(sample_idx); }
+    bool always_identity() override { return _alpha.always_identity() && _beta.always_identity(); }
 
    protected:
     void create_node() override;
@@ -24,13 +24,19 @@ THE SOFTWARE.
 #include "pipeline/node.h"
 #include "parameters/parameter_factory.h"
 #include "parameters/parameter_vx.h"
+#include "augmentations/color_augmentations/pointwise_color_node.h"
 
-class ColorTwistNode : public Node {
+class ColorTwistNode : public Node, public PointwiseColorNode {
    public:
     ColorTwistNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs);
     ColorTwistNode() = delete;
     void init(float alpha, float beta, float hue, float sat);
     void init(FloatParam *alpha_param, FloatParam *beta_param, FloatParam *hue_param, FloatParam *sat_param);
+    int color_transform_parts() override { return SCALE | OFFSET | HUE_SATURATION; }
+    void init_color_transforms() override;
+    void color_transforms(std::vector<ColorTransform> &transforms) override;
+    bool is_identity(size_t sample_idx) override { return _alpha.is_identity(sample_idx) && _beta.is_identity(sample_idx) && _hue.is_identity(sample_idx) && _sat.is_identity(sample_idx); }
+    bool always_identity() override { return _alpha.always_identity() && _beta.always_identity() && _hue.always_identity() && _sat.always_identity(); }
 
    protected:
     void create_node() override;
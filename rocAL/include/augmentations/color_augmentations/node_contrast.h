@@ -26,13 +26,19 @@ THE SOFTWARE.
 #include "pipeline/graph.h"
 #include "pipeline/node.h"
 #include "parameters/parameter_vx.h"
+#include "augmentations/color_augmentations/pointwise_color_node.h"
 
-class ContrastNode : public Node {
+class ContrastNode : public Node, public PointwiseColorNode {
    public:
     ContrastNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs);
     ContrastNode() = delete;
     void init(float contrast_factor, float contrast_center);
     void init(FloatParam *contrast_factor_param, FloatParam *contrast_center_param);
+    int color_transform_parts() override { return SCALE | OFFSET; }
+    void init_color_transforms() override;
+    void color_transforms(std::vector<ColorTransform> &transforms) override;
+    bool is_identity(size_t sample_idx) override { return _factor.is_identity(sample_idx); }
+    bool always_identity() override { return _factor.always_identity(); }
 
    protected:
     void create_node() override;
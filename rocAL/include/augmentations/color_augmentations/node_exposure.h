@@ -25,13 +25,19 @@ THE SOFTWARE.
 #include "pipeline/node.h"
 #include "parameters/parameter_factory.h"
 #include "parameters/parameter_vx.h"
+#include "augmentations/color_augmentations/pointwise_color_node.h"
 
-class ExposureNode : public Node {
+class ExposureNode : public Node, public PointwiseColorNode {
    public:
     ExposureNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs);
     ExposureNode() = delete;
     void init(float exposure_factor);
     void init(FloatParam *exposure_factor_param);
+    int color_transform_parts() override { return SCALE; }
+    void init_color_transforms() override;
+    void color_transforms(std::vector<ColorTransform> &transforms) override;
+    bool is_identity(size_t sample_idx) override { return _exposure_factor.is_identity(sample_idx); }
+    bool always_identity() override { return _exposure_factor.always_identity(); }
 
    protected:
     void create_node() override;
@@ -0,0 +1,54 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "pipeline/node.h"
+#include "augmentations/color_augmentations/pointwise_color_node.h"
+
+/*! \class FusedColorNode Applies a chain of pointwise color nodes in one pass, with the transforms of the chain composed per sample on the host.
+ *  The chain runs as a brightness kernel when it only scales and offsets the pixels, and as a color twist kernel when it also changes the hue or the saturation.
+ *  The values the nodes of the chain would have clipped and rounded in between are not, so the output can differ slightly from the unfused chain.
+ */
+class FusedColorNode : public Node {
+   public:
+    FusedColorNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs);
+    FusedColorNode() = delete;
+    //! Sets the chain applied, in order, the nodes must implement PointwiseColorNode and are never created themselves
+    void init(const std::vector<std::shared_ptr<Node>> &chain);
+
+   protected:
+    void create_node() override;
+    void update_node() override;
+
+   private:
+    void compose_transforms();
+    void write_arrays();
+    std::vector<std::shared_ptr<Node>> _chain;
+    std::vector<PointwiseColorNode *> _stages;
+    std::vector<ColorTransform> _stage_transforms, _transforms;
+    std::vector<float> _values;
+    bool _hue_saturation = false;  //!< Runs the color twist kernel instead of the brightness one
+    vx_array _alpha = nullptr, _beta = nullptr, _hue = nullptr, _sat = nullptr;
+};
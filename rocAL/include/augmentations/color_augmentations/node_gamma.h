@@ -31,6 +31,8 @@ class GammaNode : public Node {
     GammaNode() = delete;
     void init(float gamma);
     void init(FloatParam *gamma_param);
+    bool is_identity(size_t sample_idx) override { return _gamma.is_identity(sample_idx); }
+    bool always_identity() override { return _gamma.always_identity(); }
 
    protected:
     void update_node() override;
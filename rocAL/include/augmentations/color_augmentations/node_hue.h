@@ -24,13 +24,19 @@ THE SOFTWARE.
 #include "pipeline/node.h"
 #include "parameters/parameter_factory.h"
 #include "parameters/parameter_vx.h"
+#include "augmentations/color_augmentations/pointwise_color_node.h"
 
-class HueNode : public Node {
+class HueNode : public Node, public PointwiseColorNode {
    public:
     HueNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs);
     HueNode() = delete;
     void init(float hue);
     void init(FloatParam *hue);
+    int color_transform_parts() override { return HUE_SATURATION; }
+    void init_color_transforms() override;
+    void color_transforms(std::vector<ColorTransform> &transforms) override;
+    bool is_identity(size_t sample_idx) override { return _hue.is_identity(sample_idx); }
+    bool always_identity() override { return _hue.always_identity(); }
 
    protected:
     void create_node() override;
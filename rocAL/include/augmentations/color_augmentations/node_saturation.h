@@ -24,13 +24,19 @@ THE SOFTWARE.
 #include "pipeline/node.h"
 #include "parameters/parameter_factory.h"
 #include "parameters/parameter_vx.h"
+#include "augmentations/color_augmentations/pointwise_color_node.h"
 
-class SaturationNode : public Node {
+class SaturationNode : public Node, public PointwiseColorNode {
    public:
     SaturationNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs);
     SaturationNode() = delete;
     void init(float sat);
     void init(FloatParam *sat);
+    int color_transform_parts() override { return HUE_SATURATION; }
+    void init_color_transforms() override;
+    void color_transforms(std::vector<ColorTransform> &transforms) override;
+    bool is_identity(size_t sample_idx) override { return _saturation.is_identity(sample_idx); }
+    bool always_identity() override { return _saturation.always_identity(); }
 
    protected:
     void create_node() override;
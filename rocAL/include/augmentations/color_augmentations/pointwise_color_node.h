@@ -0,0 +1,53 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <vector>
+
+/*! \brief Color change a pointwise node applies to one sample, out = alpha * hs(in) + beta, where hs shifts the hue by hue degrees and scales the saturation by saturation */
+struct ColorTransform {
+    float alpha = 1.0f;
+    float beta = 0.0f;
+    float hue = 0.0f;
+    float saturation = 1.0f;
+    //! Returns the transform applying this one and then next, which is exact as long as next has no hue or saturation change or this one has no offset
+    ColorTransform then(const ColorTransform &next) const {
+        return {next.alpha * alpha, next.alpha * beta + next.beta, hue + next.hue, saturation * next.saturation};
+    }
+};
+
+/*! \class PointwiseColorNode Implemented by the nodes whose output pixel only depends on the same input pixel through a ColorTransform, so the MasterGraph can fuse a chain of them into a single node */
+class PointwiseColorNode {
+   public:
+    //! Parts of the ColorTransform the node can set, known when the node is added
+    enum Parts {
+        SCALE = 1,
+        OFFSET = 2,
+        HUE_SATURATION = 4
+    };
+    virtual ~PointwiseColorNode() = default;
+    virtual int color_transform_parts() = 0;
+    //! Sizes the parameters of the node to the batch without creating its vx node, called once the node is fused into another one
+    virtual void init_color_transforms() = 0;
+    //! Writes the transform of each sample of the batch with the current parameter values
+    virtual void color_transforms(std::vector<ColorTransform> &transforms) = 0;
+};
@@ -42,6 +42,7 @@ class CropNode : public Node {
     void create_node() override;
     void update_node() override;
     void create_crop_tensor();
+    void detach_replica_state() override;
     void *_crop_coordinates = nullptr;
     vx_tensor _crop_tensor = nullptr;
 
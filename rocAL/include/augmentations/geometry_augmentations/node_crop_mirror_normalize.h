@@ -38,6 +38,7 @@ class CropMirrorNormalizeNode : public CropNode {
    protected:
     void create_node() override;
     void update_node() override;
+    void detach_replica_state() override;
 
    private:
     std::shared_ptr<RocalCropParam> _crop_param;
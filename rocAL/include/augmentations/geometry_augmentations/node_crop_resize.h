@@ -38,6 +38,7 @@ class CropResizeNode : public CropNode {
    protected:
     void create_node() override;
     void update_node() override;
+    void detach_replica_state() override;
 
    private:
     std::shared_ptr<RocalRandomCropParam> _crop_param;
@@ -33,6 +33,8 @@ class FlipNode : public Node {
     void init(IntParam *h_flag_param, IntParam *v_flag_param);
     vx_array get_horizontal_flip() { return _horizontal.default_array(); }
     vx_array get_vertical_flip() { return _vertical.default_array(); }
+    bool is_identity(size_t sample_idx) override { return _horizontal.is_identity(sample_idx) && _vertical.is_identity(sample_idx); }
+    bool always_identity() override { return _horizontal.always_identity() && _vertical.always_identity(); }
 
    protected:
     void create_node() override;
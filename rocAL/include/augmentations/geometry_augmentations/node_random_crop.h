@@ -38,6 +38,7 @@ class RandomCropNode : public CropNode {
    protected:
     void create_node() override;
     void update_node() override;
+    void detach_replica_state() override;
 
    private:
     int _num_of_attempts = 20;
@@ -44,6 +44,7 @@ class ResizeCropMirrorNode : public CropNode {
    protected:
     void create_node() override;
     void update_node() override;
+    void detach_replica_state() override;
 
    private:
     std::shared_ptr<RocalCropParam> _crop_param;
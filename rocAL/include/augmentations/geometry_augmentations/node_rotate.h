@@ -36,6 +36,8 @@ class RotateNode : public Node {
     unsigned int get_dst_width() { return _outputs[0]->info().max_shape()[0]; }
     unsigned int get_dst_height() { return _outputs[0]->info().max_shape()[1]; }
     vx_array get_angle() { return _angle.default_array(); }
+    bool is_identity(size_t sample_idx) override { return _angle.is_identity(sample_idx); }
+    bool always_identity() override { return _angle.always_identity(); }
 
    protected:
     void create_node() override;
@@ -32,6 +32,7 @@ class SliceNode : public Node {
     SliceNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs);
     SliceNode() = delete;
     void init(Tensor *anchor_param, Tensor *shape_param, std::vector<float> &fill_values_param, RocalOutOfBoundsPolicy policy);
+    bool is_replicable() override { return false; }  // The anchor and shape tensors are not among the node inputs
 
    protected:
     void create_node() override;
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "loaders/loader_module.h"
 #include "readers/image/reader_factory.h"
 #include "decoders/audio/generic_audio_decoder.h"
+#include "pipeline/task_scheduler.h"
 #include "pipeline/timing_debug.h"
 
 #ifdef ROCAL_AUDIO
@@ -73,6 +74,7 @@ class AudioReadAndDecode {
     std::vector<AudioMetaInfo> _audio_meta_info;
     TimingDbg _file_load_time, _decode_time;
     size_t _batch_size, _num_threads;
+    TaskPriority _task_priority = TaskPriority::NORMAL;  //!< Urgency of the decode tasks in the shared task scheduler
     DecoderConfig _decoder_config;
 };
 #endif
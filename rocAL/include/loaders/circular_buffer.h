@@ -21,18 +21,22 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <atomic>
 #include <condition_variable>
 #include <vector>
 #if ENABLE_OPENCL
 #include <CL/cl.h>
 #endif
+#include <map>
 #include <queue>
 
 #include "pipeline/commons.h"
 #include "device/device_manager.h"
 #include "device/device_manager_hip.h"
+#include "pipeline/numa_placement.h"
 struct DecodedDataInfo {
     std::vector<std::string> _data_names;
+    std::vector<uint32_t> _data_indices;  //!< Sample index the reader gave each data, empty if the loader doesn't provide them
     std::vector<uint32_t> _roi_width;
     std::vector<uint32_t> _roi_height;
     std::vector<uint32_t> _original_width;
@@ -50,7 +54,21 @@ class CircularBuffer {
    public:
     CircularBuffer(void* devres);
     ~CircularBuffer();
-    void init(RocalMemType output_mem_type, size_t output_mem_size, size_t buff_depth);
+    //! Allocates the buffers
+    /*!
+     \param buff_depth Number of loaded batches the writer can get ahead of the reader
+     \param reader_slots Number of read buffers the reader keeps using after popping them, one per batch being processed concurrently
+    */
+    void init(RocalMemType output_mem_type, size_t output_mem_size, size_t buff_depth, size_t reader_slots = 1);
+    void set_numa_placement(const NumaPlacement& placement) { _numa_placement = placement; }  // Node the host buffers are allocated on, must be set before init()
+    void reserve_depth(size_t max_buff_depth) { _max_buff_depth = max_buff_depth; }  // Allocates room for up to max_buff_depth loaded batches in init(), must be set before init()
+    //! Changes the number of loaded batches the writer can get ahead of the reader, within the depth allocated by init()
+    /*!
+     \param buff_depth Requested depth, the writer finishing the batch it is loading before a smaller depth takes effect
+     Returns the depth applied, clamped to [2, allocated depth] since a depth of 1 leaves the writer no buffer to fill
+    */
+    size_t set_depth(size_t buff_depth);
+    BufferStallTime stall_time() { return {_reader_wait_time, _writer_wait_time}; }
     void release();         // release resources
     void sync();            // Syncs device buffers with host
     void unblock_reader();  // Unblocks the thread currently waiting on a call to get_read_buffer
@@ -76,6 +94,7 @@ class CircularBuffer {
     bool full();
     bool empty();
     size_t _buff_depth;
+    size_t _reader_slots = 1;  //!< Number of popped buffers still being read, the writer leaves them untouched
     DecodedDataInfo _last_data_info;
     std::queue<DecodedDataInfo> _circ_buff_data_info;    //!< Stores the loaded data names, decoded_width and decoded_height(data is stored in the _circ_buff)
     CropImageInfo _last_crop_image_info;              // for Random BBox crop coordinates
@@ -98,7 +117,13 @@ class CircularBuffer {
     size_t _output_mem_size;
     bool _initialized = false;
     const size_t MEM_ALIGNMENT = 256;
+    static constexpr size_t MIN_BUFF_DEPTH = 2;  //!< One buffer being filled while the previous one is read
     size_t _write_ptr;
     size_t _read_ptr;
     size_t _level;
+    bool _writer_released = false;  //!< Set by unblock_writer(), the writer returns from block_if_full() without a free buffer
+    size_t _max_buff_depth = 0;  //!< Largest depth set_depth() can grow the buffer to
+    size_t _active_depth;        //!< Number of buffers in use out of the _buff_depth allocated ones, including the reader slots
+    std::atomic<long long unsigned> _reader_wait_time{0}, _writer_wait_time{0};
+    NumaPlacement _numa_placement;
 };
\ No newline at end of file
@@ -44,6 +44,7 @@ class CIFAR10DataLoader : public LoaderModule {
     CropImageInfo get_crop_image_info() override;
     Timing timing() override;
     void set_prefetch_queue_depth(size_t prefetch_queue_depth) override;
+    void set_in_flight_batch_count(size_t count) override { _in_flight_batch_count = count; }
     void shut_down() override;
     std::vector<std::vector<float>> &get_batch_random_bbox_crop_coords();
     void set_batch_random_bbox_crop_coords(std::vector<std::vector<float>> batch_crop_coords);
@@ -71,6 +72,7 @@ class CIFAR10DataLoader : public LoaderModule {
     std::vector<std::string> _output_names;
     CircularBuffer _circ_buff;
     size_t _prefetch_queue_depth;
+    size_t _in_flight_batch_count = 1;  //!< Number of loaded batches still being read after load_next() moved past them
     TimingDbg _file_load_time, _swap_handle_time;
     size_t _loader_idx;
     size_t _shard_count = 1;
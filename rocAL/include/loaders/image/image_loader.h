@@ -22,6 +22,9 @@ THE SOFTWARE.
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
@@ -52,6 +55,15 @@ class ImageLoader : public LoaderModule {
     DecodedDataInfo get_decode_data_info() override;
     CropImageInfo get_crop_image_info() override;
     void set_prefetch_queue_depth(size_t prefetch_queue_depth) override;
+    void set_file_read_mode(FileReadMode file_read_mode) override { _file_read_mode = file_read_mode; }
+    void set_size_bucketing(size_t pool_batch_count) override { _size_bucketing_pool_batch_count = pool_batch_count; }
+    void set_dataset_manifest_dir(const std::string& manifest_dir) override { _manifest_dir = manifest_dir; }
+    void set_in_flight_batch_count(size_t count) override { _in_flight_batch_count = count; }
+    void set_continuous_epochs(bool continuous) override;
+    void set_prefetch_memory_cap(size_t bytes) override { _prefetch_memory_cap = bytes; }
+    size_t resize_prefetch_queue(size_t depth) override { return _circ_buff.set_depth(depth); }
+    void set_decode_thread_count(size_t count) override { _image_loader->set_decode_thread_count(count); }
+    BufferStallTime prefetch_stall_time() override { return _circ_buff.stall_time(); }
     void shut_down() override;
     void feed_external_input(const std::vector<std::string>& input_images_names, const std::vector<unsigned char*>& input_buffer,
                              const std::vector<ROIxywh>& roi_xywh, unsigned int max_width, unsigned int max_height, unsigned int channels, ExternalSourceFileMode mode, bool eos) override;
@@ -61,6 +73,9 @@ class ImageLoader : public LoaderModule {
     bool is_out_of_data();
     void de_init();
     void stop_internal_thread();
+    void park_until_rewound();
+    void wait_for_rewind();
+    void wait_for_input(size_t feed_count);  // Sleeps until data is fed after feed_count feeds, a rewind is requested or the loader stops
     std::shared_ptr<ImageReadAndDecode> _image_loader;
     LoaderModuleStatus update_output_image();
     LoaderModuleStatus load_routine();
@@ -71,7 +86,7 @@ class ImageLoader : public LoaderModule {
     size_t _output_mem_size;
     MetaDataBatch* _meta_data = nullptr;  //!< The output of the meta_data_graph,
     std::vector<std::vector<float>> _bbox_coords;
-    bool _internal_thread_running;
+    std::atomic<bool> _internal_thread_running;
     size_t _batch_size;
     std::thread _load_thread;
     RocalMemType _mem_type;
@@ -83,13 +98,26 @@ class ImageLoader : public LoaderModule {
     bool _stopped = false;
     bool _loop;                     //<! If true the reader will wrap around at the end of the media (files/images/...) and wouldn't stop
     size_t _prefetch_queue_depth;   // Used for circular buffer's internal buffer
+    size_t _prefetch_memory_cap = 0;  //!< Memory the circular buffer can take to let the prefetch queue grow beyond _prefetch_queue_depth
+    static constexpr size_t MAX_PREFETCH_QUEUE_DEPTH = 32;
+    FileReadMode _file_read_mode = FileReadMode::COPY;  //!< How the reader fetches the compressed files
+    std::string _manifest_dir;      //!< Where the reader keeps the dataset manifests, none are used when empty
+    size_t _size_bucketing_pool_batch_count = 0;  //!< Batches read ahead to be regrouped by image size, no bucketing when 0
+    size_t _in_flight_batch_count = 1;  //!< Number of loaded batches still being read after load_next() moved past them
     size_t _image_counter = 0;      //!< How many images have been loaded already
     size_t _remaining_image_count;  //!< How many images are there yet to be loaded
+    size_t _epoch_image_count = 0;  //!< How many images are loaded in one epoch
+    std::atomic<bool> _continuous_epochs{false};  //!< If true the load thread rewinds the reader itself and keeps prefetching the next epoch
+    std::atomic<bool> _rewind_requested{false};   //!< Set by reset() to park the load thread while the reader is rewound
+    bool _load_thread_parked = false;              //!< Set by the load thread once it's waiting for the rewind to finish
+    std::mutex _rewind_lock;
+    std::condition_variable _rewind_cond;
     bool _decoder_keep_original = false;
     int _device_id;
     size_t _max_tensor_width, _max_tensor_height;
     bool _external_source_reader = false;  //!< Set to true if external source reader
     bool _external_input_eos = false;      //!< Set to true for last batch for the sequence
+    std::atomic<size_t> _external_feed_count{0};  //!< Number of feed_external_input() calls, changed under _rewind_lock
     RocalBatchPolicy _last_batch_policy;   //!< Last batch policy used for the reader
     bool _last_batch_padded;                //!< Used to decide whether to pad or wrap the last batch
 };
@@ -44,6 +44,15 @@ class ImageLoaderSharded : public LoaderModule {
     CropImageInfo get_crop_image_info() override;
     Timing timing() override;
     void set_prefetch_queue_depth(size_t prefetch_queue_depth) override;
+    void set_file_read_mode(FileReadMode file_read_mode) override { _file_read_mode = file_read_mode; }
+    void set_size_bucketing(size_t pool_batch_count) override { _size_bucketing_pool_batch_count = pool_batch_count; }
+    void set_dataset_manifest_dir(const std::string& manifest_dir) override { _manifest_dir = manifest_dir; }
+    void set_in_flight_batch_count(size_t count) override { _in_flight_batch_count = count; }
+    void set_continuous_epochs(bool continuous) override;
+    void set_prefetch_memory_cap(size_t bytes) override { _prefetch_memory_cap = bytes; }
+    size_t resize_prefetch_queue(size_t depth) override;
+    void set_decode_thread_count(size_t count) override;
+    BufferStallTime prefetch_stall_time() override;
     void shut_down() override;
     void feed_external_input(const std::vector<std::string>& input_images_names, const std::vector<unsigned char *>& input_buffer,
                              const std::vector<ROIxywh>& roi_xywh, unsigned int max_width, unsigned int max_height, unsigned int channels, ExternalSourceFileMode mode, bool eos) override;
@@ -58,6 +67,11 @@ class ImageLoaderSharded : public LoaderModule {
     size_t _shard_count = 1;
     void fast_forward_through_empty_loaders();
     size_t _prefetch_queue_depth;
+    FileReadMode _file_read_mode = FileReadMode::COPY;
+    std::string _manifest_dir;
+    size_t _size_bucketing_pool_batch_count = 0;
+    size_t _in_flight_batch_count = 1;
+    size_t _prefetch_memory_cap = 0;
 
     Tensor *_output_tensor;
     std::shared_ptr<RandomBBoxCrop_MetaDataReader> _randombboxcrop_meta_data_reader = nullptr;
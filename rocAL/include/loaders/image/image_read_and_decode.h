@@ -23,6 +23,7 @@ THE SOFTWARE.
 #pragma once
 #include <dirent.h>
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -30,6 +31,8 @@ THE SOFTWARE.
 #include "loaders/loader_module.h"
 #include "parameters/parameter_random_crop_decoder.h"
 #include "readers/image/reader_factory.h"
+#include "readers/async_file_reader.h"
+#include "pipeline/task_scheduler.h"
 #include "pipeline/timing_debug.h"
 #include "decoders/image/turbo_jpeg_decoder.h"
 
@@ -43,7 +46,11 @@ class ImageReadAndDecode {
     void create(ReaderConfig reader_config, DecoderConfig decoder_config, int batch_size, int device_id = 0);
     void set_bbox_vector(std::vector<std::vector<float>> bbox_coords) { _bbox_coords = bbox_coords; };
     void set_random_bbox_data_reader(std::shared_ptr<RandomBBoxCrop_MetaDataReader> randombboxcrop_meta_data_reader);
+    //! Limits the number of images decoded at once, up to the thread count given by the reader config, applied from the next batch on
+    void set_decode_thread_count(size_t count) { _decode_thread_count = std::min(std::max(count, static_cast<size_t>(1)), _num_threads); }
     std::vector<std::vector<float>> &get_batch_random_bbox_crop_coords();
+    //! Returns the sample_index() of the images of the last batch loaded, in the order of the names
+    const std::vector<uint32_t> &sample_indices() { return _sample_indices; }
     void set_batch_random_bbox_crop_coords(std::vector<std::vector<float>> batch_crop_coords);
     void feed_external_input(const std::vector<std::string>& input_images_names, const std::vector<unsigned char *>& input_buffer,
                              const std::vector<ROIxywh>& roi_xywh, unsigned int max_width, unsigned int max_height, unsigned int channels, ExternalSourceFileMode mode, bool eos);
@@ -72,20 +79,38 @@ class ImageReadAndDecode {
     size_t last_batch_padded_size();
 
    private:
-    std::vector<std::shared_ptr<Decoder>> _decoder;
+    void release_mapped_data();
+    //! Reads the next file of the reader at slab_offset in the compressed slab and advances slab_offset past it
+    /*!
+     \return The size of the file, 0 if it couldn't be accessed
+    */
+    size_t read_to_slab(size_t slot, size_t &slab_offset);
+    std::vector<std::shared_ptr<Decoder>> _decoder;  //!< One decoder per decode thread, shared by the images of the batch that thread decodes
     std::shared_ptr<Reader> _reader;
-    std::vector<std::vector<unsigned char>> _compressed_buff;
+    std::shared_ptr<AsyncFileReader> _async_file_reader = nullptr;  //!< Reads the compressed files of a batch in parallel when the reader supports deferred opens
+    std::vector<std::vector<unsigned char>> _compressed_buff;       //!< Per image buffers of the async reads, grown to the size of the files read
+    std::vector<unsigned char> _compressed_slab;                    //!< Compressed files of the batch read through the reader, back to back
+    std::vector<size_t> _compressed_offset;                         //!< Offset of each image in _compressed_slab
+    std::vector<unsigned char *> _compressed_data;  //!< Compressed data handed to the decoders, owned by _compressed_slab or _compressed_buff, or mapped by the reader
+    std::vector<unsigned char *> _mapped_data;      //!< Mappings of the current batch, released once the batch is decoded
+    std::vector<size_t> _mapped_size;
+    bool _mapped_read = false;                      //!< Set when the reader maps the compressed files instead of copying them
     std::vector<size_t> _actual_read_size;
     std::vector<std::string> _image_names;
+    std::vector<uint32_t> _sample_indices;
     std::vector<size_t> _compressed_image_size;
     std::vector<unsigned char *> _decompressed_buff_ptrs;
     std::vector<size_t> _actual_decoded_width;
     std::vector<size_t> _actual_decoded_height;
     std::vector<size_t> _original_width;
     std::vector<size_t> _original_height;
-    static const size_t MAX_COMPRESSED_SIZE = 1 * 1024 * 1024;  // 1 Meg
-    TimingDbg _file_load_time, _decode_time;
+    static const size_t MAX_READS_IN_FLIGHT = 64;
+    std::vector<size_t> _decode_order;  //!< Images of the batch in the order they are handed to the decode threads
+    std::vector<std::chrono::high_resolution_clock::time_point> _decode_thread_end;
+    TimingDbg _file_load_time, _decode_time, _decode_tail_time;
     size_t _batch_size, _shard_count, _num_threads;
+    std::atomic<size_t> _decode_thread_count{1};  //!< Number of decode slots in use out of the _num_threads created
+    TaskPriority _task_priority = TaskPriority::NORMAL;  //!< Urgency of the decode tasks in the shared task scheduler
     DecoderConfig _decoder_config;
     bool decoder_keep_original;
     std::vector<std::vector<float>> _bbox_coords, _crop_coords_batch;
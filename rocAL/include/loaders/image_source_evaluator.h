@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "readers/image/reader_factory.h"
 #include "pipeline/timing_debug.h"
 #include "decoders/image/turbo_jpeg_decoder.h"
+#include "readers/dataset_manifest.h"
 enum class ImageSourceEvaluatorStatus {
     OK = 0,
     UNSUPPORTED_DECODER_TYPE,
@@ -43,18 +44,32 @@ class ImageSourceEvaluator {
     ImageSourceEvaluatorStatus create(ReaderConfig reader_cfg, DecoderConfig decoder_cfg);
     void find_max_dimension();
     void set_size_evaluation_policy(MaxSizeEvaluationPolicy arg);
+    //! Evaluates only a fraction of the images, evenly spread over the data set
+    /*!
+     \param sample_fraction Fraction of the images to evaluate in (0, 1], all of them are evaluated when 1
+     \param safety_margin Relative margin added to the maximum size found when sampling, as the largest images may not be part of the sample
+    */
+    void set_sampling(float sample_fraction, float safety_margin);
+    void set_num_threads(unsigned num_threads) { _num_threads = num_threads ? num_threads : 1; }
     size_t max_width();
     size_t max_height();
 
    private:
+    //! Collects the paths of the files of readers supporting deferred open and reads their headers in parallel
+    void find_max_dimension_parallel();
+    //! Reads the next file of the reader and returns its dimensions
+    bool read_dimensions(int &width, int &height);
+    bool is_sampled(size_t index);
     class FindMaxSize {
        public:
         void set_policy(MaxSizeEvaluationPolicy arg) { _policy = arg; }
+        void set_safety_margin(float safety_margin) { _safety_margin = safety_margin; }
         void process_sample(unsigned val);
-        unsigned get_max() { return _max; };
+        unsigned get_max();
 
        private:
         MaxSizeEvaluationPolicy _policy = MaxSizeEvaluationPolicy::MOST_FREQUENT_SIZE;
+        float _safety_margin = 0;  //!< Only applied to the MAXIMUM_FOUND_SIZE policy
         std::map<unsigned, unsigned> _hist;
         unsigned _max = 0;
         unsigned _max_count = 0;
@@ -62,9 +77,15 @@ class ImageSourceEvaluator {
     FindMaxSize _width_max;
     FindMaxSize _height_max;
     DecoderConfig _decoder_cfg_cv;
+    DecoderConfig _decoder_cfg;
     std::shared_ptr<Decoder> _decoder;
     std::shared_ptr<Reader> _reader;
     std::shared_ptr<MetaDataReader> _meta_data_reader;
+    std::shared_ptr<DatasetManifest> _manifest;  //!< Dimensions found in previous runs, only used for folder readers
+    std::string _root_path;
     std::vector<unsigned char> _header_buff;
+    float _sample_fraction = 1.0f;
+    unsigned _num_threads = 1;
     static const size_t COMPRESSED_SIZE = 1024 * 1024;  // 1 MB
+    static const size_t HEADER_READ_SIZE = 16 * 1024;  //!< Initial read size of the parallel scan, JPEG frame headers are usually within the first few KB
 };
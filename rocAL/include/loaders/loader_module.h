@@ -56,6 +56,18 @@ class LoaderModule {
     virtual DecodedDataInfo get_decode_data_info() = 0;
     virtual CropImageInfo get_crop_image_info() { return {}; }
     virtual void set_prefetch_queue_depth(size_t prefetch_queue_depth) = 0;
+    virtual void set_file_read_mode(FileReadMode file_read_mode) {}  // Only honored by loaders whose readers can map their files
+    virtual void set_dataset_manifest_dir(const std::string& manifest_dir) {}  // Only honored by loaders whose readers list dataset folders
+    virtual void set_size_bucketing(size_t pool_batch_count) {}  // Batches of images read ahead to form the batches from images of similar size, only honored by the image loaders
+    virtual void set_in_flight_batch_count(size_t count) {}  // Number of loaded batches processed concurrently, only honored by the image loaders
+    virtual void set_continuous_epochs(bool continuous) {}  // Keeps loading the next epoch while the current one is drained, only honored by the image loaders
+    virtual void set_task_priority(TaskPriority priority) { _task_priority = priority; }  // Urgency of the decode tasks of the loader in the shared task scheduler
+    virtual void set_numa_placement(const NumaPlacement& placement) { _numa_placement = placement; }  // Node the load thread and the loaded batches are kept on
+    // Prefetch autotuning, only honored by the image loaders
+    virtual void set_prefetch_memory_cap(size_t bytes) {}  // Memory the loader can allocate up front to deepen its prefetch queue later, set before initialize()
+    virtual size_t resize_prefetch_queue(size_t depth) { return 0; }  // Returns the depth applied, 0 if the loader cannot change it
+    virtual void set_decode_thread_count(size_t count) {}  // Number of images decoded at once, within the thread count the loader was created with
+    virtual BufferStallTime prefetch_stall_time() { return {}; }  // Time the consumer and the load threads waited on the prefetch queue
     // introduce meta data reader
     virtual void set_random_bbox_data_reader(std::shared_ptr<RandomBBoxCrop_MetaDataReader> randombboxcrop_meta_data_reader) { THROW("set_random_bbox_data_reader is not compatible with this implementation") }
     virtual void shut_down() = 0;
@@ -68,6 +80,8 @@ class LoaderModule {
     virtual size_t last_batch_padded_size() { return 0; }
    protected:
     DecodedDataInfo _decoded_data_info, _output_decoded_data_info;  // Stores the decoded data info
+    TaskPriority _task_priority = TaskPriority::NORMAL;
+    NumaPlacement _numa_placement;
 };
 
 using pLoaderModule = std::shared_ptr<LoaderModule>;
\ No newline at end of file
@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "pipeline/commons.h"
 #include "decoders/video/ffmpeg_video_decoder.h"
 #include "readers/video/video_reader_factory.h"
+#include "pipeline/task_scheduler.h"
 #include "pipeline/timing_debug.h"
 #include "loaders/loader_module.h"
 #include "readers/video/video_properties.h"
@@ -108,6 +109,7 @@ class VideoReadAndDecode {
     size_t _max_decoded_width;
     size_t _max_decoded_height;
     size_t _max_decoded_stride;
+    TaskPriority _task_priority = TaskPriority::NORMAL;  //!< Urgency of the decode tasks in the shared task scheduler
     AVPixelFormat _out_pix_fmt;
     DecoderConfig _video_decoder_config;
 };
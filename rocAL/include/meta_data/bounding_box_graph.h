@@ -35,4 +35,7 @@ class BoundingBoxGraph : public MetaDataGraph {
     void update_random_bbox_meta_data(pMetaDataBatch input_meta_data, pMetaDataBatch output_meta_data, DecodedDataInfo decoded_image_info, CropImageInfo crop_image_info) override;
     void update_box_encoder_meta_data(std::vector<float> *anchors, pMetaDataBatch full_batch_meta_data, float criteria, bool offset, float scale, std::vector<float> &means, std::vector<float> &stds, float *encoded_boxes_data, int *encoded_labels_data) override;
     void update_box_iou_matcher(BoxIouMatcherInfo &iou_matcher_info, int *matches_idx_buffer, pMetaDataBatch full_batch_meta_data) override;
+
+   private:
+    pMetaDataBatch _intermediate_meta_data = nullptr;  //!< Input of the meta nodes after the first one, reused from batch to batch
 };
@@ -44,11 +44,13 @@ class LabelReaderFolders : public MetaDataReader {
 
    private:
     void read_files(const std::string& _path);
+    void read_manifest(const std::string& path);  //!< Same as read_all() but reads the folders from the dataset manifest
     bool exists(const std::string& image_name) override;
     void add(std::string image_name, int label);
     std::map<std::string, std::shared_ptr<MetaData>> _map_content;
     std::map<std::string, std::shared_ptr<MetaData>>::iterator _itr;
     std::string _path;
+    std::string _manifest_dir;
     pMetaDataBatch _output;
     DIR *_src_dir, *_sub_dir;
     struct dirent* _entity;
@@ -61,6 +61,8 @@ typedef std::vector<float> Joint, JointVisibility, ScoreBatch, RotationBatch;
 typedef std::vector<std::vector<float>> Joints, JointsVisibility, CenterBatch, ScaleBatch;
 typedef std::vector<std::vector<std::vector<float>>> JointsBatch, JointsVisibilityBatch;
 
+constexpr uint32_t INVALID_SAMPLE_INDEX = UINT32_MAX;  //!< Sample index of the items of the readers which don't number them
+
 enum class MetaDataType {
     Label,
     BoundingBox,
@@ -246,6 +248,8 @@ class MetaDataBatch {
         return this;
     }
     virtual std::shared_ptr<MetaDataBatch> clone(bool copy_contents = true) = 0;
+    //! Same as clone() but into target, a batch of the same class, whose vectors are reused so that a recycled batch doesn't allocate once they grew to the sizes of the data set
+    virtual void clone_into(MetaDataBatch& target, bool copy_contents = true) = 0;
     virtual int mask_size() = 0;
     virtual std::vector<Labels>& get_labels_batch() = 0;
     virtual std::vector<BoundingBoxCords>& get_bb_cords_batch() = 0;
@@ -270,9 +274,6 @@ class MetaDataBatch {
 class LabelBatch : public MetaDataBatch {
    public:
     void clear() override {
-        for (auto label : _label_ids) {
-            label.clear();
-        }
         _info_batch.clear();
         _label_ids.clear();
         _buffer_size.clear();
@@ -299,6 +300,16 @@ class LabelBatch : public MetaDataBatch {
             return label_batch_instance;
         }
     }
+    void clone_into(MetaDataBatch& target, bool copy_contents) override {
+        auto& batch = dynamic_cast<LabelBatch&>(target);
+        if (copy_contents) {
+            batch = *this;
+        } else {
+            batch.resize(size());
+            for (auto& labels : batch._label_ids) labels.clear();
+            batch._info_batch = _info_batch;
+        }
+    }
     explicit LabelBatch(std::vector<Labels>& labels) {
         _label_ids = std::move(labels);
     }
@@ -315,7 +326,7 @@ class LabelBatch : public MetaDataBatch {
     std::vector<size_t>& get_buffer_size() override {
         _buffer_size.clear();
         size_t size = 0;
-        for (auto label : _label_ids)
+        for (auto& label : _label_ids)
             size += label.size();
         _buffer_size.emplace_back(size * sizeof(int));
         return _buffer_size;
@@ -361,6 +372,17 @@ class BoundingBoxBatch : public LabelBatch {
             return bbox_batch_instance;
         }
     }
+    void clone_into(MetaDataBatch& target, bool copy_contents) override {
+        auto& batch = dynamic_cast<BoundingBoxBatch&>(target);
+        if (copy_contents) {
+            batch = *this;
+        } else {
+            batch.resize(size());
+            for (auto& bb_cords : batch._bb_cords) bb_cords.clear();
+            for (auto& labels : batch._label_ids) labels.clear();
+            batch._info_batch = _info_batch;
+        }
+    }
     void convert_ltrb_to_xywh(BoundingBoxCords& ltrb_bbox_list) {
         for (unsigned i = 0; i < ltrb_bbox_list.size(); i++) {
             auto& bbox = ltrb_bbox_list[i];
@@ -385,7 +407,7 @@ class BoundingBoxBatch : public LabelBatch {
     std::vector<size_t>& get_buffer_size() override {
         _buffer_size.clear();
         size_t size = 0;
-        for (auto label : _label_ids)
+        for (auto& label : _label_ids)
             size += label.size();
         _buffer_size.emplace_back(size * sizeof(int));
         _buffer_size.emplace_back(size * 4 * sizeof(float));
@@ -441,6 +463,20 @@ struct PolygonMaskBatch : public BoundingBoxBatch {
             return mask_batch_instance;
         }
     }
+    void clone_into(MetaDataBatch& target, bool copy_contents) override {
+        auto& batch = dynamic_cast<PolygonMaskBatch&>(target);
+        if (copy_contents) {
+            batch = *this;
+        } else {
+            batch.resize(size());
+            for (auto& bb_cords : batch._bb_cords) bb_cords.clear();
+            for (auto& labels : batch._label_ids) labels.clear();
+            for (auto& mask_cords : batch._mask_cords) mask_cords.clear();
+            for (auto& polygon_count : batch._polygon_counts) polygon_count.clear();
+            for (auto& vertices_count : batch._vertices_counts) vertices_count.clear();
+            batch._info_batch = _info_batch;
+        }
+    }
     void copy_data(std::vector<void*> buffer) override {
         if (buffer.size() < 2)
             THROW("The buffers are insufficient")  // TODO -change
@@ -460,12 +496,12 @@ struct PolygonMaskBatch : public BoundingBoxBatch {
     std::vector<size_t>& get_buffer_size() override {
         _buffer_size.clear();
         size_t size = 0;
-        for (auto label : _label_ids)
+        for (auto& label : _label_ids)
             size += label.size();
         _buffer_size.emplace_back(size * sizeof(int));
         _buffer_size.emplace_back(size * 4 * sizeof(float));
         size = 0;
-        for (auto mask : _mask_cords)
+        for (auto& mask : _mask_cords)
             size += mask.size();
         _buffer_size.emplace_back(size * sizeof(float));
         return _buffer_size;
@@ -523,6 +559,21 @@ class KeyPointBatch : public BoundingBoxBatch {
             return joints_batch_instance;
         }
     }
+    void clone_into(MetaDataBatch& target, bool copy_contents) override {
+        auto& batch = dynamic_cast<KeyPointBatch&>(target);
+        if (copy_contents) {
+            batch = *this;
+        } else {
+            batch.resize(size());
+            for (auto& center : batch._joints_data.center_batch) center.clear();
+            for (auto& scale : batch._joints_data.scale_batch) scale.clear();
+            for (auto& joints : batch._joints_data.joints_batch) joints.clear();
+            for (auto& joints_visibility : batch._joints_data.joints_visibility_batch) joints_visibility.clear();
+            for (auto& bb_cords : batch._bb_cords) bb_cords.clear();
+            for (auto& labels : batch._label_ids) labels.clear();
+            batch._info_batch = _info_batch;
+        }
+    }
     JointsDataBatch& get_joints_data_batch() override { return _joints_data; }
     void copy_data(std::vector<void*> buffer) override {}
     std::vector<size_t>& get_buffer_size() override { return _buffer_size; }
@@ -21,6 +21,7 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <atomic>
 #include <list>
 
 #include "loaders/circular_buffer.h"
@@ -29,6 +30,7 @@ THE SOFTWARE.
 #include "pipeline/node.h"
 #include "parameters/parameter_factory.h"
 #include "meta_data/randombboxcrop_meta_data_reader.h"
+#include "pipeline/task_scheduler.h"
 
 typedef struct {
     std::vector<float> *anchors;
@@ -45,5 +47,14 @@ class MetaDataGraph {
     virtual void update_random_bbox_meta_data(pMetaDataBatch input_meta_data, pMetaDataBatch output_meta_data, DecodedDataInfo decoded_data_info, CropImageInfo crop_image_info) = 0;
     virtual void update_box_encoder_meta_data(std::vector<float> *anchors, pMetaDataBatch full_batch_meta_data, float criteria, bool offset, float scale, std::vector<float> &means, std::vector<float> &stds, float *encoded_boxes_data, int *encoded_labels_data) = 0;
     virtual void update_box_iou_matcher(BoxIouMatcherInfo &iou_matcher_info, int *matches_idx_buffer, pMetaDataBatch full_batch_meta_data) = 0;
+    //! Bounds the threads the batch is processed on and sets the urgency of their tasks in the shared task scheduler
+    void set_task_budget(size_t max_parallelism, TaskPriority priority) {
+        _max_parallelism = max_parallelism;
+        _task_priority = priority;
+    }
     std::list<std::shared_ptr<MetaNode>> _meta_nodes;
+
+   protected:
+    std::atomic<size_t> _max_parallelism{1};  //!< Can be changed while a batch is processed, by the autotuner
+    std::atomic<TaskPriority> _task_priority{TaskPriority::NORMAL};
 };
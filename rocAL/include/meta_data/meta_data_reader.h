@@ -58,6 +58,7 @@ struct MetaDataConfig {
     unsigned _out_img_height;
     bool _avoid_class_remapping;
     bool _aspect_ratio_grouping;
+    std::string _manifest_dir;
 
    public:
     MetaDataConfig(const MetaDataType& type, const MetaDataReaderType& reader_type, const std::string& path, const std::map<std::string, std::string>& feature_key_map = std::map<std::string, std::string>(), const std::string file_prefix = std::string(), const unsigned& sequence_length = 3, const unsigned& frame_step = 3, const unsigned& frame_stride = 1)
@@ -79,11 +80,36 @@ struct MetaDataConfig {
     void set_out_img_height(unsigned out_img_height) { _out_img_height = out_img_height; }
     void set_avoid_class_remapping(bool avoid_class_remapping) { _avoid_class_remapping = avoid_class_remapping; }
     void set_aspect_ratio_grouping(bool aspect_ratio_grouping) { _aspect_ratio_grouping = aspect_ratio_grouping; }
+    std::string manifest_dir() const { return _manifest_dir; }
+    void set_manifest_dir(const std::string& manifest_dir) { _manifest_dir = manifest_dir; }
 };
 
 class MetaDataReader {
    protected:
     bool _aspect_ratio_grouping;
+    const std::vector<uint32_t>* _lookup_sample_indices = nullptr;                           //!< Sample indices of the images being looked up by lookup_indexed()
+    std::vector<std::pair<const std::string, std::shared_ptr<MetaData>>*> _entry_cache;  //!< Entries of the map content by sample index, filled as the images are looked up
+
+    //! Returns the entry of map_content for the image idx of the batch being looked up, from its sample index once the image was seen and else by searching its name
+    std::shared_ptr<MetaData>& find_entry(std::map<std::string, std::shared_ptr<MetaData>>& map_content, size_t idx, const std::string& image_name) {
+        uint32_t sample_index = (_lookup_sample_indices && idx < _lookup_sample_indices->size()) ? (*_lookup_sample_indices)[idx] : INVALID_SAMPLE_INDEX;
+        if (sample_index < _entry_cache.size()) {
+            auto cached = _entry_cache[sample_index];
+            if (cached && cached->first == image_name)  // Guards against readers which don't keep the indices of their items across epochs
+                return cached->second;
+        }
+        auto it = map_content.find(image_name);
+        if (map_content.end() == it)
+            THROW("ERROR: Given name not present in the map" + image_name)
+        if (sample_index != INVALID_SAMPLE_INDEX) {
+            if (sample_index >= _entry_cache.size())
+                _entry_cache.resize(sample_index + 1, nullptr);
+            _entry_cache[sample_index] = &*it;
+        }
+        return it->second;
+    }
+    //! Must be called when entries are removed from the map content
+    void clear_entry_cache() { _entry_cache.clear(); }
 
    public:
     enum class Status {
@@ -93,6 +119,12 @@ class MetaDataReader {
     virtual void init(const MetaDataConfig& cfg, pMetaDataBatch meta_data_batch) = 0;
     virtual void read_all(const std::string& path) = 0;                    // Reads all the meta data information
     virtual void lookup(const std::vector<std::string>& image_names) = 0;  // finds meta_data info associated with given names and fills the output
+    //! Same as lookup(), with the sample_index() the reader gave each image, which lets the readers using find_entry() skip the name search for the images seen before
+    void lookup_indexed(const std::vector<std::string>& image_names, const std::vector<uint32_t>& sample_indices) {
+        _lookup_sample_indices = &sample_indices;
+        lookup(image_names);
+        _lookup_sample_indices = nullptr;
+    }
     virtual void release() = 0;                                            // Deletes the loaded information
     virtual const std::map<std::string, std::shared_ptr<MetaData>>& get_map_content() = 0;
     virtual bool exists(const std::string& image_name) = 0;
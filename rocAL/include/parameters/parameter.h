@@ -21,6 +21,8 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <cstdint>
+#include <vector>
 
 template <typename T>
 class Parameter {
@@ -33,6 +35,9 @@ class Parameter {
     /// used to internally renew state of the parameter if needed (for random parameters)
     virtual void renew(){};
 
+    /// renews the values of the samples of a batch, random parameters draw the values of a sample from its index in the epoch
+    virtual void renew_batch(uint64_t epoch, uint64_t batch_idx) { renew(); };
+
     /// allocates memory for the array with specified size
     virtual void create_array(unsigned size){};
 
@@ -70,7 +70,8 @@ class ParameterFactory {
    public:
     static ParameterFactory* instance();
     ~ParameterFactory();
-    void renew_parameters();
+    //! Renews the random parameters for a batch, the values of a sample only depend on the seed, the parameter, the epoch and the index of the sample in the epoch
+    void renew_parameters(uint64_t epoch, uint64_t batch_idx);
     void set_seed(unsigned seed);
     unsigned get_seed();
     void generate_seed();
@@ -78,7 +79,7 @@ class ParameterFactory {
 
     template <typename T>
     Parameter<T>* create_uniform_rand_param(T start, T end) {
-        auto gen = new UniformRand<T>(start, end, _seed);
+        auto gen = new UniformRand<T>(start, end, _seed, _next_param_id++);
         _parameters.insert(gen);
         return gen;
     }
@@ -109,4 +110,5 @@ class ParameterFactory {
     ParameterFactory();
     std::vector<int64_t> _seed_vector;
     int _seed_sequence_idx = 0;
+    unsigned _next_param_id = 0;  //!< Keys the generators apart from their seed, the default parameters of the nodes all get _seed
 };
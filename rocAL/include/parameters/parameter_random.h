@@ -22,9 +22,12 @@ THE SOFTWARE.
 
 #pragma once
 #include <algorithm>  // std::remove_if
+#include <atomic>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
 #include <memory>
+#include <mutex>
 #include <numeric>  // std::inner_product, std::accumulate
 #include <random>
 #include <stdexcept>
@@ -34,10 +37,17 @@ THE SOFTWARE.
 
 #include "pipeline/log.h"
 #include "parameters/parameter.h"
+#include "parameters/philox.h"
+//! Streams of the counter based generator used by the random parameters, in the upper half of the counters
+enum RandomParameterStream : uint32_t {
+    BATCH_STREAM = 0,        //!< Values of the samples, drawn from the epoch and the index of the sample in the epoch
+    SINGLE_DRAW_STREAM = 1,  //!< Values drawn one after the other by renew(), e.g. for each crop
+};
+
 template <typename T>
 class UniformRand : public Parameter<T> {
    public:
-    UniformRand(T start, T end, unsigned seed = 0) : _generator(seed) {
+    UniformRand(T start, T end, unsigned seed = 0, unsigned id = 0) : _key{seed, id} {
         update(start, end);
         renew();
     }
@@ -57,35 +67,44 @@ class UniformRand : public Parameter<T> {
     }
 
     void renew_value() {
-        std::unique_lock<std::mutex> lock(_lock);
-        auto val = _generator();
+        uint32_t val;
+        philox::fill(_key, SINGLE_DRAW_STREAM, 0, _draw_count.fetch_add(1, std::memory_order_relaxed), &val, 1);
+        _updated_val = value(val, _start, _end);
+    }
 
-        if (single_value()) {
+    //! Draws the values of the samples of batch batch_idx of the epoch, from any thread without locking
+    void renew_array(uint64_t epoch, uint64_t batch_idx) {
+        T start = _start, end = _end;
+        if (start == end) {
             // If there is only a single value possible for the random variable
             // don't waste time on calling the rand function , just return it.
-            _updated_val = _start;
-        } else {
-            _updated_val = static_cast<T>(
-                ((double)val / (double)_generator.max()) * ((double)_end - (double)_start) + (double)_start);
+            std::fill(_param_values.begin(), _param_values.end(), start);
+            return;
         }
+        philox::fill(_key, BATCH_STREAM, static_cast<uint32_t>(epoch), batch_idx * _size, _random_values.data(), _size);
+        for (uint i = 0; i < _size; i++)
+            _param_values[i] = value(_random_values[i], start, end);
     }
 
-    void renew_array() {
-        for (uint i = 0; i < _size; i++) {
+    void renew() override {
+        if (_param_values.size()) {
+            philox::fill(_key, SINGLE_DRAW_STREAM, 0, _draw_count.fetch_add(_size, std::memory_order_relaxed), _random_values.data(), _size);
+            for (uint i = 0; i < _size; i++)
+                _param_values[i] = value(_random_values[i], _start, _end);
+        } else {
             renew_value();
-            _param_values[i] = _updated_val;
         }
     }
 
-    void renew() override {
+    void renew_batch(uint64_t epoch, uint64_t batch_idx) override {
         if (_param_values.size()) {
-            renew_array();
+            renew_array(epoch, batch_idx);
         } else {
             renew_value();
         }
     }
+
     int update(T start, T end) {
-        std::unique_lock<std::mutex> lock(_lock);
         if (end < start)
             end = start;
 
@@ -97,6 +116,7 @@ class UniformRand : public Parameter<T> {
     void create_array(unsigned vector_size) override {
         if (_param_values.size() == 0) {
             _param_values.resize(vector_size);
+            _random_values.resize(vector_size);
             _size = vector_size;
         }
     }
@@ -106,13 +126,19 @@ class UniformRand : public Parameter<T> {
     }
 
    private:
-    T _start;
-    T _end;
+    static T value(uint32_t val, T start, T end) {
+        if (start == end)
+            return start;
+        return static_cast<T>(philox::to_unit(val) * ((double)end - (double)start) + (double)start);
+    }
+    std::atomic<T> _start;
+    std::atomic<T> _end;
     T _updated_val;
     std::vector<T> _param_values;
-    std::mt19937 _generator;
-    std::mutex _lock;
-    unsigned _size;
+    std::vector<uint32_t> _random_values;
+    philox::Key _key;                          //!< Seed and id of the parameter
+    std::atomic<uint64_t> _draw_count = {0};  //!< Index of the next value of SINGLE_DRAW_STREAM
+    unsigned _size = 0;
 };
 
 template <typename T>
@@ -120,7 +146,7 @@ struct CustomRand : public Parameter<T> {
     CustomRand(
         const T values[],
         const double frequencies[],
-        size_t size, unsigned seed = 0) : _generator(seed) {
+        size_t size, unsigned seed = 0, unsigned id = 0) : _key{seed, id} {
         update(values, frequencies, size);
         renew();
     }
@@ -174,35 +200,34 @@ struct CustomRand : public Parameter<T> {
     }
 
     void renew_value() {
+        uint32_t val;
+        philox::fill(_key, SINGLE_DRAW_STREAM, 0, _draw_count.fetch_add(1, std::memory_order_relaxed), &val, 1);
         std::unique_lock<std::mutex> lock(_lock);
-        if (single_value()) {
-            // If there is only a single value possible for the random variable
-            // don't waste time on calling the rand function , just return it.
-            _updated_val = _values[0];
-        } else {
-            // Generate a value between [0 1]
-            double rand_val = (double)_generator() / (double)_generator.max();
-
-            // Find the iterators pointing to the first element bigger than idx
-            auto it = std::upper_bound(_comltv_dist.begin(), _comltv_dist.end(), rand_val);
-
-            // Get the index and return the associated value
-            unsigned idx = std::distance(_comltv_dist.begin(), it);
+        _updated_val = value(val);
+    }
 
-            _updated_val = _values[idx];
-        }
+    //! Draws the values of the samples of batch batch_idx of the epoch, the lock only keeps update() from changing the distribution meanwhile
+    void renew_array(uint64_t epoch, uint64_t batch_idx) {
+        philox::fill(_key, BATCH_STREAM, static_cast<uint32_t>(epoch), batch_idx * _size, _random_values.data(), _size);
+        std::unique_lock<std::mutex> lock(_lock);
+        for (uint i = 0; i < _size; i++)
+            _param_values[i] = value(_random_values[i]);
     }
 
-    void renew_array() {
-        for (uint i = 0; i < _size; i++) {
+    void renew() override {
+        if (_param_values.size()) {
+            philox::fill(_key, SINGLE_DRAW_STREAM, 0, _draw_count.fetch_add(_size, std::memory_order_relaxed), _random_values.data(), _size);
+            std::unique_lock<std::mutex> lock(_lock);
+            for (uint i = 0; i < _size; i++)
+                _param_values[i] = value(_random_values[i]);
+        } else {
             renew_value();
-            _param_values[i] = _updated_val;
         }
     }
 
-    void renew() override {
+    void renew_batch(uint64_t epoch, uint64_t batch_idx) override {
         if (_param_values.size()) {
-            renew_array();
+            renew_array(epoch, batch_idx);
         } else {
             renew_value();
         }
@@ -218,6 +243,7 @@ struct CustomRand : public Parameter<T> {
     void create_array(unsigned vector_size) override {
         if (_param_values.size() == 0) {
             _param_values.resize(vector_size);
+            _random_values.resize(vector_size);
             _size = vector_size;
         }
     }
@@ -233,7 +259,24 @@ struct CustomRand : public Parameter<T> {
     double _mean;
     T _updated_val;
     std::vector<T> _param_values;  //!< The values will be used in parameter_vx.h file after renewing
-    std::mt19937 _generator;
+    std::vector<uint32_t> _random_values;
+    philox::Key _key;                          //!< Seed and id of the parameter
+    std::atomic<uint64_t> _draw_count = {0};  //!< Index of the next value of SINGLE_DRAW_STREAM
     std::mutex _lock;
-    unsigned _size;
+    unsigned _size = 0;
+
+    //! Must be called with _lock held
+    T value(uint32_t val) const {
+        if (single_value()) {
+            // If there is only a single value possible for the random variable
+            // don't waste time on searching the distribution, just return it.
+            return _values[0];
+        }
+        // Find the iterators pointing to the first element bigger than the value in [0 1)
+        auto it = std::upper_bound(_comltv_dist.begin(), _comltv_dist.end(), philox::to_unit(val));
+
+        // Get the index and return the associated value, the last one if the rounding of the partial sums left it out
+        size_t idx = std::min(static_cast<size_t>(std::distance(_comltv_dist.begin(), it)), _values.size() - 1);
+        return _values[idx];
+    }
 };
\ No newline at end of file
@@ -60,16 +60,36 @@ class ParameterVX {
             THROW(" vxAddArrayItems failed in create_array (ParameterVX): " + TOSTR(status))
         update_array();
     }
+    //! Sizes the per sample values without creating the vx array, for the parameters of a node fused into another one
+    void create_host_array(unsigned batch_size) {
+        _batch_size = batch_size;
+        _param->create_array(_batch_size);
+    }
     void set_param(Parameter<T>* param) {
         if (!param)
             return;
 
         ParameterFactory::instance()->destroy_param(_param);
         _param = param;
+        _fixed = false;
     }
     void set_param(T val) {
         ParameterFactory::instance()->destroy_param(_param);
         _param = ParameterFactory::instance()->create_single_value_param(val);
+        _fixed = true;  // The user has no handle to update the parameter
+    }
+    //! Sets the value that leaves a sample unchanged
+    void set_identity(T value) {
+        _identity = value;
+        _has_identity = true;
+    }
+    //! Returns true if the sample got the identity value in the last update_array()
+    bool is_identity(size_t sample_idx) const {
+        return _has_identity && sample_idx < _values.size() && _values[sample_idx] == _identity;
+    }
+    //! Returns true if every sample of every batch gets the identity value
+    bool always_identity() const {
+        return _has_identity && _fixed && _param->default_value() == _identity;
     }
     T default_value() {
         return _param->default_value();
@@ -97,7 +117,8 @@ class ParameterVX {
     }
     void update_array() {
         vx_status status;
-        status = vxCopyArrayRange((vx_array)_array, 0, _batch_size, sizeof(T), get_array().data(), VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST);
+        _values = get_array();
+        status = vxCopyArrayRange((vx_array)_array, 0, _batch_size, sizeof(T), _values.data(), VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST);
         if (status != 0)
             THROW(" vxCopyArrayRange failed in update_array (ParameterVX): " + TOSTR(status))
     }
@@ -115,6 +136,10 @@ class ParameterVX {
     vx_array _array = nullptr;
     Parameter<T>* _param;
     T _val;
+    std::vector<T> _values;  //!< Values of the samples written by the last update_array()
+    T _identity = T();
+    bool _has_identity = false;
+    bool _fixed = false;
     unsigned _batch_size;
     unsigned OVX_PARAM_IDX;
     const T _DEFAULT_RANGE_START;
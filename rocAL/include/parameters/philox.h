@@ -0,0 +1,90 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+//! Philox4x32-10 counter based generator (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+//! Each 128 bit counter is turned into four independent 32 bit values under a 64 bit key, so any value of a stream
+//! can be computed on its own, from any thread and in any order, without state shared between the draws.
+namespace philox {
+
+constexpr uint32_t MULTIPLIER_0 = 0xD2511F53;
+constexpr uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+constexpr uint32_t WEYL_0 = 0x9E3779B9;
+constexpr uint32_t WEYL_1 = 0xBB67AE85;
+constexpr unsigned ROUNDS = 10;
+
+using Key = std::array<uint32_t, 2>;
+
+//! Fills out[i] with the value of index first + i of a stream, value index coming from the counter index / 4 in the low 64 bits and the stream in the high 64 bits
+/*!
+ The rounds are run over lanes of consecutive counters kept in separate arrays, which the compiler turns into SIMD code
+ \param key Key of the generator, e.g. the seed and the id of the parameter
+ \param stream_hi, stream_lo The upper 64 bits of the counters, e.g. the epoch and the purpose of the stream
+*/
+inline void fill(Key key, uint32_t stream_hi, uint32_t stream_lo, uint64_t first, uint32_t* out, size_t count) {
+    constexpr size_t LANES = 16;
+    uint64_t block = first / 4;
+    size_t skip = first % 4;
+    size_t filled = 0;
+    while (filled < count) {
+        uint32_t c0[LANES], c1[LANES], c2[LANES], c3[LANES];
+        for (size_t lane = 0; lane < LANES; lane++) {
+            c0[lane] = static_cast<uint32_t>(block + lane);
+            c1[lane] = static_cast<uint32_t>((block + lane) >> 32);
+            c2[lane] = stream_lo;
+            c3[lane] = stream_hi;
+        }
+        uint32_t k0 = key[0], k1 = key[1];
+        for (unsigned round = 0; round < ROUNDS; round++) {
+            for (size_t lane = 0; lane < LANES; lane++) {
+                uint64_t product_0 = static_cast<uint64_t>(MULTIPLIER_0) * c0[lane];
+                uint64_t product_1 = static_cast<uint64_t>(MULTIPLIER_1) * c2[lane];
+                uint32_t n0 = static_cast<uint32_t>(product_1 >> 32) ^ c1[lane] ^ k0;
+                uint32_t n2 = static_cast<uint32_t>(product_0 >> 32) ^ c3[lane] ^ k1;
+                c1[lane] = static_cast<uint32_t>(product_1);
+                c3[lane] = static_cast<uint32_t>(product_0);
+                c0[lane] = n0;
+                c2[lane] = n2;
+            }
+            k0 += WEYL_0;
+            k1 += WEYL_1;
+        }
+        for (size_t lane = 0; lane < LANES && filled < count; lane++) {
+            const uint32_t values[4] = {c0[lane], c1[lane], c2[lane], c3[lane]};
+            for (size_t idx = skip; idx < 4 && filled < count; idx++)
+                out[filled++] = values[idx];
+            skip = 0;
+        }
+        block += LANES;
+    }
+}
+
+//! Maps a 32 bit value to [0, 1)
+inline double to_unit(uint32_t value) {
+    return value * (1.0 / 4294967296.0);
+}
+
+}  // namespace philox
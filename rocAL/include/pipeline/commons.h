@@ -63,7 +63,8 @@ enum class RocalTensorDataType {
     UINT8,
     INT8,
     UINT32,
-    INT32
+    INT32,
+    BF16
 };
 
 enum class RocalAffinity {
@@ -145,6 +146,7 @@ struct Timing {
     // The following timings are accumulated timing not just the most recent activity
     long long unsigned read_time = 0;
     long long unsigned decode_time = 0;
+    long long unsigned decode_tail_time = 0;  // Time decode threads wait on the last images of a batch, from the first thread running out of images to the last one finishing
     long long unsigned to_device_xfer_time = 0;
     long long unsigned from_device_xfer_time = 0;
     long long unsigned copy_to_output = 0;
@@ -159,6 +161,12 @@ struct Timing {
     long long unsigned video_process_time= 0;
 };
 
+//! Time the reader and the writer of a buffer between two pipeline stages spent blocked on it, accumulated since the buffer was created, in microseconds
+struct BufferStallTime {
+    long long unsigned reader_wait = 0;  // Waiting for the writer to fill a slot
+    long long unsigned writer_wait = 0;  // Waiting for the reader to free a slot
+};
+
 /*! \brief Tensor Last Batch Policy Type enum
  These policies the last batch policies determine the behavior when there are not enough samples in the epoch to fill the last batch
         FILL - The last batch is filled by either repeating the last sample or by wrapping up the data set.
@@ -27,10 +27,11 @@ THE SOFTWARE.
 #include "pipeline/master_graph.h"
 
 struct Context {
-    explicit Context(size_t batch_size, RocalAffinity affinity, int gpu_id, size_t cpu_thread_count, size_t prefetch_queue_depth, RocalTensorDataType output_tensor_type) : affinity(affinity),
-                                                                                                                                                                            _user_batch_size(batch_size) {
-        LOG("Processing on " + STR(((affinity == RocalAffinity::CPU) ? " CPU" : " GPU")))
-        master_graph = std::make_shared<MasterGraph>(batch_size, affinity, cpu_thread_count, gpu_id, prefetch_queue_depth, output_tensor_type);
+    explicit Context(size_t batch_size, RocalAffinity affinity, int gpu_id, size_t cpu_thread_count, size_t prefetch_queue_depth, RocalTensorDataType output_tensor_type,
+                     const NumaPlacement& numa_placement = NumaPlacement()) : affinity(affinity),
+                                                                              _user_batch_size(batch_size) {
+        LOG("Processing on " + STR(((affinity == RocalAffinity::CPU) ? " CPU" : " GPU")) + ", " + numa_placement.description())
+        master_graph = std::make_shared<MasterGraph>(batch_size, affinity, cpu_thread_count, gpu_id, prefetch_queue_depth, output_tensor_type, numa_placement);
     }
     ~Context() {
         clear_errors();
@@ -0,0 +1,65 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "pipeline/commons.h"
+#include "pipeline/numa_placement.h"
+
+/*! \class ExecutionStage Runs the jobs submitted to it one after the other, in submission order, on its own thread.
+ *  Used by the MasterGraph to run parts of the processing of a batch concurrently with the processing of the neighbouring batches.
+ */
+class ExecutionStage {
+   public:
+    //! Constructor
+    /*!
+     \param name Name of the stage, used in the log messages
+     \param placement NUMA node the thread of the stage runs on
+    */
+    explicit ExecutionStage(const std::string &name, const NumaPlacement &placement = NumaPlacement());
+    ~ExecutionStage();
+    //! Queues the job, the returned future becomes ready once the job ran and rethrows the exception the job threw if any
+    std::future<void> submit(std::function<void()> job);
+    //! Blocks until all the jobs submitted so far ran
+    void drain();
+    //! Returns the number of jobs queued or running
+    size_t pending();
+
+   private:
+    void routine();
+    std::deque<std::packaged_task<void()>> _queue;
+    std::mutex _lock;
+    std::condition_variable _wait_for_job;
+    std::condition_variable _wait_for_drain;
+    std::thread _thread;
+    std::string _name;
+    NumaPlacement _placement;
+    size_t _pending = 0;
+    bool _running = true;
+};
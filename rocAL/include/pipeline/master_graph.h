@@ -21,9 +21,13 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <variant>
 
 #include "pipeline/graph.h"
@@ -41,7 +45,10 @@ THE SOFTWARE.
 #include "loaders/audio/node_audio_loader.h"
 #include "loaders/audio/node_audio_loader_single_shard.h"
 #endif
+#include "pipeline/execution_stage.h"
+#include "pipeline/prefetch_autotuner.h"
 #include "pipeline/ring_buffer.h"
+#include "pipeline/task_scheduler.h"
 #include "pipeline/timing_debug.h"
 #if ENABLE_HIP
 #include "box_encoder_hip.h"
@@ -56,25 +63,6 @@ THE SOFTWARE.
 #define MAX_MASK_BUFFER 10000
 #define MAX_RETINANET_ANCHORS 120087  // Num of bbox achors used in Retinanet training
 
-#if ENABLE_SIMD
-#if _WIN32
-#include <intrin.h>
-#else
-#include <immintrin.h>
-#include <smmintrin.h>
-#include <x86intrin.h>
-#endif
-#endif
-
-#if (ENABLE_SIMD && __AVX2__)
-const __m256i avx_pkdMaskR = _mm256_setr_epi32(0x80808000, 0x80808003, 0x80808006, 0x80808009, 0x80808000,
-                                               0x80808003, 0x80808006, 0x80808009);
-const __m256i avx_pkdMaskG = _mm256_setr_epi32(0x80808001, 0x80808004, 0x80808007, 0x8080800A, 0x80808001,
-                                               0x80808004, 0x80808007, 0x8080800A);
-const __m256i avx_pkdMaskB = _mm256_setr_epi32(0x80808002, 0x80808005, 0x80808008, 0x8080800B, 0x80808002,
-                                               0x80808005, 0x80808008, 0x8080800B);
-#endif
-
 class MasterGraph {
    public:
     enum class Status { OK = 0,
@@ -82,7 +70,7 @@ class MasterGraph {
                         NO_MORE_DATA = 2,
                         NOT_IMPLEMENTED = 3,
                         INVALID_ARGUMENTS };
-    MasterGraph(size_t batch_size, RocalAffinity affinity, size_t cpu_thread_count, int gpu_id, size_t prefetch_queue_depth, RocalTensorDataType output_tensor_data_type);
+    MasterGraph(size_t batch_size, RocalAffinity affinity, size_t cpu_thread_count, int gpu_id, size_t prefetch_queue_depth, RocalTensorDataType output_tensor_data_type, const NumaPlacement &numa_placement = NumaPlacement());
     ~MasterGraph();
     Status reset();
     size_t remaining_count();
@@ -92,6 +80,15 @@ class MasterGraph {
     Status copy_out_tensor_planar(void *out_ptr, RocalTensorlayout format, float multiplier0, float multiplier1, float multiplier2,
                                   float offset0, float offset1, float offset2, bool reverse_channels, RocalTensorDataType output_data_type);
     TensorList *get_output_tensors();
+    //! Output tensors of a processed batch lent to the user, they point at the ring buffer slot instead of a copy of it
+    struct BorrowedOutput {
+        std::shared_ptr<SlotLease> lease;  //!< Keeps the writer off the slot until the borrow is released
+        TensorList tensors;
+        int device_id = 0;
+        ~BorrowedOutput() { tensors.release(); }
+    };
+    //! Lends the outputs of the batch read last, the slot stays valid after the next run() until the returned object is deleted
+    BorrowedOutput *borrow_output_tensors();
     size_t output_width();
     size_t output_height();
     void sequence_start_frame_number(std::vector<size_t> &sequence_start_framenum);             // Returns the starting frame number of the sequences
@@ -129,6 +126,36 @@ class MasterGraph {
     TensorList *mask_meta_data();
     TensorList *matched_index_meta_data();
     void set_loop(bool val) { _loop = val; }
+    void set_file_read_mode(FileReadMode file_read_mode) { _file_read_mode = file_read_mode; }
+    void set_dataset_manifest_dir(const std::string &manifest_dir) { _manifest_dir = manifest_dir; }
+    const std::string &dataset_manifest_dir() { return _manifest_dir; }
+    //! Forms the batches from images of similar size, must be called before the loader is created
+    /*!
+     \param pool_batch_count Number of batches of images read ahead and sorted by size, bucketing is disabled when 0
+    */
+    void set_size_bucketing(size_t pool_batch_count) { _size_bucketing_pool_batch_count = pool_batch_count; }
+    void set_size_evaluation_sampling(float sample_fraction, float safety_margin) {
+        _size_evaluation_sample_fraction = sample_fraction;
+        _size_evaluation_safety_margin = safety_margin;
+    }
+    float size_evaluation_sample_fraction() { return _size_evaluation_sample_fraction; }
+    float size_evaluation_safety_margin() { return _size_evaluation_safety_margin; }
+    void set_pipelined_execution(bool enable) { _pipelined_execution = enable; }
+    void set_continuous_epochs(bool enable) { _continuous_epochs = enable; }
+    void set_task_priority(TaskPriority priority) { _task_priority = priority; }
+    //! Lets the pipeline adapt its prefetch queue depths and the split of its CPU threads to the stalls it measures, must be called before the loader is created
+    /*!
+     \param warmup_batch_count Number of batches the settings are adjusted quickly over, they are adjusted every warmup_batch_count batches after that
+     \param memory_cap Bytes the loader and output buffers can take to deepen the prefetch queues, half for each, 0 only lets them shrink
+    */
+    void set_prefetch_autotune(bool enable, size_t warmup_batch_count, size_t memory_cap) {
+        _autotune = enable;
+        _autotune_warmup_batch_count = warmup_batch_count;
+        _autotune_memory_cap = memory_cap;
+    }
+    void set_graph_replica_count(size_t replica_count);
+    //! Fuses the chains of pointwise color nodes into single nodes when the pipeline is built
+    void set_graph_fusion(bool enable) { _graph_fusion = enable; }
     void set_output(Tensor *output_tensor);
     size_t calculate_cpu_num_threads(size_t shard_count);
     bool empty() { return (remaining_count() < (_is_sequence_reader_output ? _sequence_batch_size : _user_batch_size)); }
@@ -149,18 +176,32 @@ class MasterGraph {
     cl_command_queue get_ocl_cmd_q() { return _device.resources()->cmd_queue; }
 #endif
    private:
-    Status update_node_parameters();
+    Status update_node_parameters(const std::list<std::shared_ptr<Node>> &nodes);
+    void bypass_identity_nodes();
+    void fuse_pointwise_color_nodes();
     void create_single_graph();
+    size_t usable_graph_replica_count();
+    void create_graph_replicas(size_t replica_count, size_t cpu_num_threads);
     void start_processing();
     void stop_processing();
     void output_routine();
+    void pipelined_output_routine();
+    void replicated_output_routine();
+    void park_output_routine();
+    void start_next_epoch();  //!< Tells the loader the epoch is over in the continuous epochs mode, called by the output routine
+    void wait_for_rewind();
+    pMetaDataBatch process_meta_data(const DecodedDataInfo &decode_data_info, const CropImageInfo &crop_image_info);
+    pMetaDataBatch recycled_output_meta_data();  //!< Returns a batch of _output_meta_data_pool nobody holds anymore, adding one if they are all in use
+    void encode_and_push(ImageNameBatch names, pMetaDataBatch output_meta_data);
     void decrease_image_count();
+    void autotune();  //!< Applies the settings the autotuner picks once a window of batches is complete
     /// notify_user_thread() is called when the internal processing thread is done with processing all available tensors
     void notify_user_thread();
     /// no_more_processed_data() is logically linked to the notify_user_thread() and is used to tell the user they've already consumed all the processed tensors
     bool no_more_processed_data();
     RingBuffer _ring_buffer;                                                      //!< The queue that keeps the tensors that have benn processed by the internal thread (_output_thread) asynchronous to the user's thread
     pMetaDataBatch _augmented_meta_data = nullptr;                                //!< The output of the meta_data_graph,
+    std::vector<pMetaDataBatch> _output_meta_data_pool;                           //!< Output metadata batches, reused once the ring buffer and the user released them
     std::shared_ptr<CropCordBatch> _random_bbox_crop_cords_data = nullptr;
     std::thread _output_thread;
     TensorList _internal_tensor_list;                                             //!< Keeps a list of ovx tensors that are used to store the augmented outputs (there is an augmentation output batch per element in the list)
@@ -197,12 +238,48 @@ class MasterGraph {
     std::shared_ptr<MetaDataGraph> _meta_data_graph = nullptr;
     std::shared_ptr<RandomBBoxCrop_MetaDataReader> _randombboxcrop_meta_data_reader = nullptr;
     bool _first_run = true;
+    uint64_t _parameter_epoch = 0;                                                //!< Number of rewinds, the random parameters of each epoch are drawn from a stream of their own
+    uint64_t _parameter_batch_idx = 0;                                            //!< Index in the epoch of the next batch the random parameters are renewed for
     bool _processing;                                                             //!< Indicates if internal processing thread should keep processing or not
     const static unsigned SAMPLE_SIZE = sizeof(unsigned char);
     int _remaining_count;                                                         //!< Keeps the count of remaining tensors yet to be processed for the user,
     bool _loop;                                                                   //!< Indicates if user wants to indefinitely loops through tensors or not
     size_t _prefetch_queue_depth;
+    FileReadMode _file_read_mode = FileReadMode::COPY;                            //!< How the loaders created afterwards read the compressed files
+    std::string _manifest_dir;                                                    //!< Where the readers created afterwards keep their dataset manifests
+    size_t _size_bucketing_pool_batch_count = 0;                                  //!< Batches of images the loaders created afterwards read ahead to bucket them by size
+    float _size_evaluation_sample_fraction = 1.0f;                                //!< Fraction of the images read to find the decode size when not given by the user
+    float _size_evaluation_safety_margin = 0.0f;                                  //!< Relative margin added to the maximum decode size found when sampling
+    bool _pipelined_execution = false;                                            //!< Overlaps the metadata processing and the box encoding with the graph execution of the neighbouring batches
+    std::unique_ptr<ExecutionStage> _meta_data_stage, _encode_stage;              //!< Stages running the metadata processing and the box encoding when _pipelined_execution is set
+    /*! \brief A copy of the augmentation graph over its own tensors, the batches are dispatched to the replicas in turn */
+    struct GraphReplica {
+        std::shared_ptr<Graph> graph;
+        std::list<std::shared_ptr<Node>> nodes;
+        std::vector<std::pair<Tensor *, Tensor *>> loader_tensors;  //!< Loader output tensors paired with their replicas, which are given the loaded batch
+        std::vector<Tensor *> output_tensors;                       //!< Replicas of the tensors of _internal_tensor_list, in the same order
+        std::unique_ptr<ExecutionStage> stage;                      //!< Runs the graph of the replica
+        std::shared_future<void> done;                              //!< Ready once the replica finished processing its last batch
+        TimingDbg process_time = TimingDbg("Process Time", DBG_TIMING);
+    };
+    size_t _graph_replica_count = 1;                                              //!< Number of augmentation graphs requested by the user, each processing its own batch
+    std::vector<std::unique_ptr<GraphReplica>> _graph_replicas;                   //!< The augmentation graphs used instead of _graph when more than one can be run
+    bool _graph_fusion = false;                                                   //!< Replaces the chains of pointwise color nodes with single nodes applying the composed transforms
     bool _output_routine_finished_processing = false;
+    TaskPriority _task_priority = TaskPriority::NORMAL;                           //!< Urgency of the tasks of this pipeline in the task scheduler shared by all the pipelines
+    std::atomic<size_t> _output_thread_count{1};                                  //!< Threads of the output copies and the metadata processing, _cpu_num_threads unless autotuned
+    bool _autotune = false;                                                       //!< Adjusts the prefetch queue depths and the thread split to the measured stalls
+    size_t _autotune_warmup_batch_count = 0;
+    size_t _autotune_memory_cap = 0;                                              //!< Bytes the loader and output buffers can take to deepen the prefetch queues
+    std::unique_ptr<PrefetchAutotuner> _autotuner;
+    std::chrono::steady_clock::time_point _autotune_window_start;
+    static constexpr size_t MAX_AUTOTUNE_RING_DEPTH = 32;
+    bool _continuous_epochs = false;                                              //!< The output routine goes on with the next epoch while the user drains the current one, the loader rewinds itself
+    int _epoch_sample_count = 0;                                                  //!< Count of the tensors processed for the user in one epoch
+    std::atomic<bool> _rewind_requested{false};                                   //!< Set by reset() to park the output routine while the buffers and the loader are rewound
+    bool _output_routine_parked = false;                                          //!< Set by the output routine once it's waiting for the rewind to finish
+    std::mutex _rewind_lock;
+    std::condition_variable _rewind_cond;
     const RocalTensorDataType _out_data_type;
     bool _is_random_bbox_crop = false;
     std::vector<std::vector<size_t>> _sequence_start_framenum_vec;                //!< Stores the starting frame number of the sequences.
@@ -226,12 +303,14 @@ class MasterGraph {
 #if ENABLE_HIP
     BoxEncoderGpu *_box_encoder_gpu = nullptr;
 #endif
+    NumaPlacement _numa_placement;  //!< Node the loader, decode and graph threads and the host buffers of this pipeline are kept on
     TimingDbg _rb_block_if_empty_time, _rb_block_if_full_time;
 };
 
 template <typename T>
 std::shared_ptr<T> MasterGraph::add_node(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) {
     auto node = std::make_shared<T>(inputs, outputs);
+    node->set_copy_function([](const Node &original) -> std::shared_ptr<Node> { return std::make_shared<T>(static_cast<const T &>(original)); });
     _nodes.push_back(node);
 
     for (auto &input : inputs) {
@@ -254,6 +333,7 @@ std::shared_ptr<T> MasterGraph::meta_add_node(std::shared_ptr<M> node) {
     auto meta_node = std::make_shared<T>();
     _meta_data_graph->_meta_nodes.push_back(meta_node);
     meta_node->_node = node;
+    node->set_has_meta_node();
     meta_node->_batch_size = _user_batch_size;
     _augmentation_metanode = true;
     return meta_node;
@@ -273,6 +353,13 @@ inline std::shared_ptr<ImageLoaderNode> MasterGraph::add_node(const std::vector<
 #endif
     _loader_module = node->get_loader_module();
     _loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    _loader_module->set_file_read_mode(_file_read_mode);
+    _loader_module->set_dataset_manifest_dir(_manifest_dir);
+    _loader_module->set_size_bucketing(_size_bucketing_pool_batch_count);
+    _loader_module->set_in_flight_batch_count(_graph_replica_count);
+    _loader_module->set_task_priority(_task_priority);
+    _loader_module->set_numa_placement(_numa_placement);
+    _loader_module->set_prefetch_memory_cap(_autotune ? _autotune_memory_cap / 2 : 0);
     _root_nodes.push_back(node);
     for (auto &output : outputs)
         _tensor_map.insert(std::make_pair(output, node));
@@ -291,6 +378,13 @@ inline std::shared_ptr<ImageLoaderSingleShardNode> MasterGraph::add_node(const s
 #endif
     _loader_module = node->get_loader_module();
     _loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    _loader_module->set_file_read_mode(_file_read_mode);
+    _loader_module->set_dataset_manifest_dir(_manifest_dir);
+    _loader_module->set_size_bucketing(_size_bucketing_pool_batch_count);
+    _loader_module->set_in_flight_batch_count(_graph_replica_count);
+    _loader_module->set_task_priority(_task_priority);
+    _loader_module->set_numa_placement(_numa_placement);
+    _loader_module->set_prefetch_memory_cap(_autotune ? _autotune_memory_cap / 2 : 0);
     _root_nodes.push_back(node);
     for (auto &output : outputs)
         _tensor_map.insert(std::make_pair(output, node));
@@ -309,6 +403,13 @@ inline std::shared_ptr<FusedJpegCropNode> MasterGraph::add_node(const std::vecto
 #endif
     _loader_module = node->get_loader_module();
     _loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    _loader_module->set_file_read_mode(_file_read_mode);
+    _loader_module->set_dataset_manifest_dir(_manifest_dir);
+    _loader_module->set_size_bucketing(_size_bucketing_pool_batch_count);
+    _loader_module->set_in_flight_batch_count(_graph_replica_count);
+    _loader_module->set_task_priority(_task_priority);
+    _loader_module->set_numa_placement(_numa_placement);
+    _loader_module->set_prefetch_memory_cap(_autotune ? _autotune_memory_cap / 2 : 0);
     _loader_module->set_random_bbox_data_reader(_randombboxcrop_meta_data_reader);
     _root_nodes.push_back(node);
     for (auto &output : outputs)
@@ -328,6 +429,13 @@ inline std::shared_ptr<FusedJpegCropSingleShardNode> MasterGraph::add_node(const
 #endif
     _loader_module = node->get_loader_module();
     _loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    _loader_module->set_file_read_mode(_file_read_mode);
+    _loader_module->set_dataset_manifest_dir(_manifest_dir);
+    _loader_module->set_size_bucketing(_size_bucketing_pool_batch_count);
+    _loader_module->set_in_flight_batch_count(_graph_replica_count);
+    _loader_module->set_task_priority(_task_priority);
+    _loader_module->set_numa_placement(_numa_placement);
+    _loader_module->set_prefetch_memory_cap(_autotune ? _autotune_memory_cap / 2 : 0);
     _loader_module->set_random_bbox_data_reader(_randombboxcrop_meta_data_reader);
     _root_nodes.push_back(node);
     for (auto &output : outputs)
@@ -350,6 +458,13 @@ inline std::shared_ptr<Cifar10LoaderNode> MasterGraph::add_node(const std::vecto
 #endif
     _loader_module = node->get_loader_module();
     _loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    _loader_module->set_file_read_mode(_file_read_mode);
+    _loader_module->set_dataset_manifest_dir(_manifest_dir);
+    _loader_module->set_size_bucketing(_size_bucketing_pool_batch_count);
+    _loader_module->set_in_flight_batch_count(_graph_replica_count);
+    _loader_module->set_task_priority(_task_priority);
+    _loader_module->set_numa_placement(_numa_placement);
+    _loader_module->set_prefetch_memory_cap(_autotune ? _autotune_memory_cap / 2 : 0);
     _root_nodes.push_back(node);
     for (auto &output : outputs)
         _tensor_map.insert(std::make_pair(output, node));
@@ -372,6 +487,13 @@ inline std::shared_ptr<VideoLoaderNode> MasterGraph::add_node(const std::vector<
 #endif
     _loader_module = node->get_loader_module();
     _loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    _loader_module->set_file_read_mode(_file_read_mode);
+    _loader_module->set_dataset_manifest_dir(_manifest_dir);
+    _loader_module->set_size_bucketing(_size_bucketing_pool_batch_count);
+    _loader_module->set_in_flight_batch_count(_graph_replica_count);
+    _loader_module->set_task_priority(_task_priority);
+    _loader_module->set_numa_placement(_numa_placement);
+    _loader_module->set_prefetch_memory_cap(_autotune ? _autotune_memory_cap / 2 : 0);
     _root_nodes.push_back(node);
     for (auto &output : outputs)
         _tensor_map.insert(std::make_pair(output, node));
@@ -390,6 +512,13 @@ inline std::shared_ptr<VideoLoaderSingleShardNode> MasterGraph::add_node(const s
 #endif
     _loader_module = node->get_loader_module();
     _loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    _loader_module->set_file_read_mode(_file_read_mode);
+    _loader_module->set_dataset_manifest_dir(_manifest_dir);
+    _loader_module->set_size_bucketing(_size_bucketing_pool_batch_count);
+    _loader_module->set_in_flight_batch_count(_graph_replica_count);
+    _loader_module->set_task_priority(_task_priority);
+    _loader_module->set_numa_placement(_numa_placement);
+    _loader_module->set_prefetch_memory_cap(_autotune ? _autotune_memory_cap / 2 : 0);
     _root_nodes.push_back(node);
     for (auto &output : outputs)
         _tensor_map.insert(std::make_pair(output, node));
@@ -412,6 +541,13 @@ template<> inline std::shared_ptr<AudioLoaderNode> MasterGraph::add_node(const s
 #endif
     _loader_module = node->GetLoaderModule();
     _loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    _loader_module->set_file_read_mode(_file_read_mode);
+    _loader_module->set_dataset_manifest_dir(_manifest_dir);
+    _loader_module->set_size_bucketing(_size_bucketing_pool_batch_count);
+    _loader_module->set_in_flight_batch_count(_graph_replica_count);
+    _loader_module->set_task_priority(_task_priority);
+    _loader_module->set_numa_placement(_numa_placement);
+    _loader_module->set_prefetch_memory_cap(_autotune ? _autotune_memory_cap / 2 : 0);
     _root_nodes.push_back(node);
     for(auto& output: outputs)
         _tensor_map.insert(make_pair(output, node));
@@ -429,6 +565,13 @@ template<> inline std::shared_ptr<AudioLoaderSingleShardNode> MasterGraph::add_n
 #endif
     _loader_module = node->GetLoaderModule();
     _loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    _loader_module->set_file_read_mode(_file_read_mode);
+    _loader_module->set_dataset_manifest_dir(_manifest_dir);
+    _loader_module->set_size_bucketing(_size_bucketing_pool_batch_count);
+    _loader_module->set_in_flight_batch_count(_graph_replica_count);
+    _loader_module->set_task_priority(_task_priority);
+    _loader_module->set_numa_placement(_numa_placement);
+    _loader_module->set_prefetch_memory_cap(_autotune ? _autotune_memory_cap / 2 : 0);
     _root_nodes.push_back(node);
     for(auto& output: outputs)
         _tensor_map.insert(make_pair(output, node));
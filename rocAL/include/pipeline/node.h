@@ -21,6 +21,9 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <algorithm>
+#include <functional>
+#include <map>
 #include <memory>
 #include <set>
 
@@ -44,14 +47,40 @@ class Node {
     bool _is_ssd = false;
     const Roi2DCords *get_src_roi() { return _inputs[0]->info().roi().get_2D_roi(); }
     const Roi2DCords *get_dst_roi() { return _outputs[0]->info().roi().get_2D_roi(); }
+    //! Sets the function copying the node as its actual type, set by the MasterGraph when the node is added
+    void set_copy_function(std::function<std::shared_ptr<Node>(const Node &)> copy) { _copy = std::move(copy); }
+    //! Returns false if the node reads tensors other than its inputs or shares state with other nodes, and cannot be replicated
+    virtual bool is_replicable() { return _copy != nullptr && !_is_ssd; }
+    //! Returns a copy of the node reading and writing the given replicas of its tensors, to be created in another graph
+    /*!
+     \param replica_tensors Maps each input and output tensor of the node to its replica
+    */
+    std::shared_ptr<Node> replicate(const std::map<Tensor *, Tensor *> &replica_tensors);
+    //! Returns true if the node leaves the sample of the current batch unchanged
+    virtual bool is_identity(size_t sample_idx) { return false; }
+    //! Returns true if the node leaves every sample of every batch unchanged, so the MasterGraph can take it out of the graph
+    virtual bool always_identity() { return false; }
+    //! Number of samples the node left unchanged and the number it processed since the pipeline started
+    size_t identity_sample_count() { return _identity_sample_count; }
+    size_t sample_count() { return _sample_count; }
+    //! Makes the node read the given tensor instead of one of its inputs, used when the node producing that input is taken out of the graph
+    void replace_input(Tensor *input, Tensor *replacement) { std::replace(_inputs.begin(), _inputs.end(), input, replacement); }
+    //! Set once a meta node reads the parameters of the node, the node has to stay in the graph then
+    void set_has_meta_node() { _has_meta_node = true; }
+    bool has_meta_node() { return _has_meta_node; }
 
    protected:
     virtual void create_node() = 0;
     virtual void update_node() = 0;
-    const std::vector<Tensor *> _inputs;
-    const std::vector<Tensor *> _outputs;
+    //! Gives a copy of the node its own instance of the objects the copy constructor shares with the original node
+    virtual void detach_replica_state() {}
+    std::vector<Tensor *> _inputs;
+    std::vector<Tensor *> _outputs;
     std::shared_ptr<Graph> _graph = nullptr;
     vx_node _node = nullptr;
     size_t _batch_size;
     pMetaDataBatch _meta_data_info;
+    std::function<std::shared_ptr<Node>(const Node &)> _copy;
+    size_t _identity_sample_count = 0, _sample_count = 0;
+    bool _has_meta_node = false;
 };
@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <sched.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "pipeline/commons.h"
+
+/*! \class NumaPlacement NUMA node the threads and the host buffers of a pipeline are kept on.
+ *  A default constructed placement is unbound, the threads then run anywhere and the memory follows the default policy of the process.
+ */
+class NumaPlacement {
+   public:
+    //! Memory policy of a thread, saved before a placement changes it for a few allocations
+    struct MemoryPolicy {
+        int mode = 0;                      //!< Policy and mode flags as returned by get_mempolicy, MPOL_DEFAULT by default
+        std::vector<unsigned long> nodes;  //!< Node mask of the policy
+    };
+    NumaPlacement() = default;
+    //! Returns the placement on the cores and the memory of \p node, throws if the node does not exist
+    static NumaPlacement for_node(int node);
+    //! Returns the placement on the node the GPU \p gpu_id is attached to, unbound when it cannot be found out
+    static NumaPlacement for_gpu(int gpu_id);
+    //! Returns the number of NUMA nodes of the host, 1 when the kernel exposes no topology
+    static int node_count();
+    //! Returns the node the calling thread was bound to with bind_current_thread(), -1 if it is not bound
+    static int current_thread_node();
+    bool bound() const { return _node >= 0; }
+    int node() const { return _node; }
+    size_t cpu_count() const { return bound() ? CPU_COUNT(&_cpus) : 0; }
+    //! Restricts the calling thread to the cores of the node and makes it allocate its memory there, does nothing if the placement is unbound
+    void bind_current_thread() const;
+    //! Makes the memory the calling thread allocates from now on come from the node if possible, does nothing if the placement is unbound
+    void set_thread_memory_policy() const;
+    //! Returns the memory policy of the calling thread, to be given back with restore_thread_memory_policy()
+    static MemoryPolicy thread_memory_policy();
+    //! Gives the calling thread back a memory policy saved with thread_memory_policy()
+    static void restore_thread_memory_policy(const MemoryPolicy &policy);
+    //! Binds the whole pages of [ptr, ptr + size) to the node and touches the range so that it gets allocated there right away
+    void place_memory(void *ptr, size_t size) const;
+    //! Returns the alignment of the host buffers given to place_memory(), whole pages when bound so that the buffers own all the pages they span
+    size_t buffer_alignment(size_t min_alignment) const;
+    //! Adds the number of pages of [ptr, ptr + size) resident on each node to \p pages_per_node, the pages not allocated yet are counted on node -1
+    static void count_pages(const void *ptr, size_t size, std::map<int, size_t> &pages_per_node);
+    //! Returns a one line summary of the pages count per node, used by the placement reports
+    static std::string describe_pages(const std::map<int, size_t> &pages_per_node);
+    std::string description() const;
+
+   private:
+    int _node = -1;
+    cpu_set_t _cpus;
+};
@@ -0,0 +1,70 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <string>
+
+#include "pipeline/commons.h"
+
+/*! \class PrefetchAutotuner Picks the prefetch queue depths and the split of the CPU threads between the decoders and the output processing from the time the pipeline stages stall on each other.
+ *  The stall times are sampled over short windows during the first batches so that the pipeline reaches its steady state quickly, and over longer ones after that to follow slow changes without oscillating.
+ */
+class PrefetchAutotuner {
+   public:
+    struct Settings {
+        size_t ring_depth;      //!< Processed batches the output routine can get ahead of the user
+        size_t loader_depth;    //!< Loaded batches the load threads can get ahead of the output routine
+        size_t decode_threads;  //!< Images decoded at once
+        size_t graph_threads;   //!< Threads of the output copies and the metadata processing
+    };
+    //! Stall times accumulated since the pipeline started, in microseconds
+    struct Stalls {
+        long long unsigned user_wait = 0;    //!< The user waiting in run() for a processed batch
+        long long unsigned output_wait = 0;  //!< The output routine waiting for a free slot in the ring buffer
+        long long unsigned loader_wait = 0;  //!< The output routine waiting for a loaded batch
+        long long unsigned load_wait = 0;    //!< The load threads waiting for a free slot in the loader buffers
+    };
+    //! Constructor
+    /*!
+     \param warmup_batch_count Number of batches sampled over short windows, it is also the length of the windows used after them
+     \param initial Settings the pipeline starts with
+     \param max Largest settings the pipeline has room for, the depths being bounded by the memory allocated for them and the threads by the thread budget
+    */
+    PrefetchAutotuner(size_t warmup_batch_count, const Settings &initial, const Settings &max);
+    //! Counts one more batch given to the user, returns true once a window is complete and update() should be called
+    bool batch_done();
+    //! Returns the settings to apply given the stall times accumulated till the end of the window and the time it took
+    Settings update(const Stalls &stalls, long long unsigned elapsed_us);
+    //! Records the settings actually applied, the pipeline can clamp the requested ones
+    void applied(const Settings &settings) { _current = settings; }
+    const Settings &current() { return _current; }
+    static std::string describe(const Settings &settings);
+
+   private:
+    static constexpr size_t WARMUP_WINDOW = 4;  //!< Batches per window during the warmup
+    static constexpr double STALL_FRACTION = 0.05;  //!< Part of a window a stage has to stall for before the settings are changed
+    size_t _warmup_batch_count;
+    size_t _batch_count = 0;
+    size_t _window_batch_count = 0;
+    Settings _current, _max;
+    Stalls _last;  //!< Stall times at the start of the current window
+};
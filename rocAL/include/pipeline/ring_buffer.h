@@ -21,7 +21,12 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
 #include <vector>
 
 #if ENABLE_OPENCL
@@ -33,8 +38,47 @@ THE SOFTWARE.
 #include "device/device_manager.h"
 #include "device/device_manager_hip.h"
 #include "meta_data/meta_data.h"
+#include "pipeline/numa_placement.h"
 
 using MetaDataNamePair = std::pair<ImageNameBatch, pMetaDataBatch>;
+class RingBuffer;
+
+/*! \brief Counts the borrows of each slot of a RingBuffer by the consumer
+ * Shared by the ring buffer and the borrows, so that a slot still borrowed when the ring buffer lets its memory go is freed on its last return
+ */
+class SlotLeases {
+   public:
+    SlotLeases(RingBuffer *ring, unsigned slot_count);
+    bool lent(size_t slot) const { return _counts[slot].load() > 0; }
+    void acquire(size_t slot) { _counts[slot]++; }
+    //! Returns a borrow of the slot, waking up the writer of the ring buffer or freeing the slot if the ring buffer has let it go
+    void release(size_t slot);
+    //! Hands the freeing of a lent slot over to its last return, returns false if the slot is not lent and must be freed by the caller
+    bool defer_free(size_t slot, std::function<void()> free_slot);
+    //! Called by the ring buffer once its writer doesn't wait for the returns anymore
+    void detach();
+
+   private:
+    std::mutex _lock;  //!< Guards _ring and _deferred_free, the counts are read by the writer without it
+    RingBuffer *_ring;
+    std::unique_ptr<std::atomic<unsigned>[]> _counts;
+    std::vector<std::function<void()>> _deferred_free;
+};
+
+/*! \brief A slot of the RingBuffer lent to the consumer, the writer doesn't fill it again until the lease is destroyed */
+class SlotLease {
+   public:
+    SlotLease(std::shared_ptr<SlotLeases> leases, size_t slot) : _leases(std::move(leases)), _slot(slot) { _leases->acquire(_slot); }
+    ~SlotLease() { _leases->release(_slot); }
+    SlotLease(const SlotLease &) = delete;
+    SlotLease &operator=(const SlotLease &) = delete;
+    size_t slot() const { return _slot; }
+
+   private:
+    std::shared_ptr<SlotLeases> _leases;
+    size_t _slot;
+};
+
 class RingBuffer {
    public:
     explicit RingBuffer(unsigned buffer_depth);
@@ -46,11 +90,27 @@ class RingBuffer {
     ///\param sub_buffer_size
     ///\param sub_buffer_count
     void init(RocalMemType mem_type, void *dev, std::vector<size_t> &sub_buffer_size, std::vector<size_t> &roi_buffer_size);
+    //! Allocates room for up to \p max_buffer_depth slots in init(), so that set_depth() can grow the buffer later, must be called before init()
+    void reserve_depth(unsigned max_buffer_depth);
+    //! Changes the number of slots the writer can fill ahead of the reader within the allocated ones, returns the depth applied
+    unsigned set_depth(unsigned buffer_depth);
+    unsigned depth() { return _depth; }
+    unsigned max_depth() { return _buff_depth; }
+    BufferStallTime stall_time() { return {_reader_wait_time, _writer_wait_time}; }
+    //! Sets the NUMA node the host buffers are allocated on, must be called before init()
+    void set_numa_placement(const NumaPlacement &placement) { _numa_placement = placement; }
     void initBoxEncoderMetaData(RocalMemType mem_type, size_t encoded_bbox_size, size_t encoded_labels_size);
     void init_metadata(RocalMemType mem_type, std::vector<size_t> &sub_buffer_size);
     void release_gpu_res();
     std::pair<std::vector<void *>, std::vector<unsigned *>> get_read_buffers();
     std::pair<std::vector<void *>, std::vector<unsigned *>> get_write_buffers();
+    //! Reserves the next free slot for a batch whose processing is still in flight while the previously reserved batches get pushed
+    /*! Blocks while all the free slots are already reserved, the reservations are released in order by push()
+     * \return The output and ROI buffers of the reserved slot
+     */
+    std::pair<std::vector<void *>, std::vector<unsigned *>> reserve_write_buffers();
+    //! Lends the slot read last to the consumer, which can keep using its buffers after the next pop() as long as it holds the lease
+    std::shared_ptr<SlotLease> lend_read_slot();
     std::pair<void *, void *> get_box_encode_write_buffers();
     std::pair<void *, void *> get_box_encode_read_buffers();
     MetaDataNamePair &get_meta_data();
@@ -68,6 +128,8 @@ class RingBuffer {
     void block_if_empty();
     void block_if_full();
     void release_if_empty();
+    //! Wakes up the writer waiting for a slot the consumer has returned
+    void slot_returned();
 
    private:
     std::queue<MetaDataNamePair> _meta_ring_buffer;
@@ -75,7 +137,9 @@ class RingBuffer {
     void increment_read_ptr();
     void increment_write_ptr();
     bool full();
-    const unsigned BUFF_DEPTH;
+    bool lent(size_t slot) { return _leases && _leases->lent(slot); }
+    unsigned _buff_depth;  //!< Number of allocated slots
+    unsigned _depth;       //!< Number of slots in use out of the allocated ones, the ring cycling over all of them
     std::vector<size_t> _sub_buffer_size;
     unsigned _sub_buffer_count;
     std::vector<std::vector<size_t>> _meta_data_sub_buffer_size;
@@ -96,7 +160,11 @@ class RingBuffer {
     size_t _write_ptr;
     size_t _read_ptr;
     size_t _level;
+    size_t _reserved = 0;  //!< Number of slots handed out by reserve_write_buffers() and not pushed yet
+    std::shared_ptr<SlotLeases> _leases;  //!< Slots lent to the consumer, the writer waits for them to be returned
     std::mutex _names_buff_lock;
     const size_t MEM_ALIGNMENT = 256;
     bool _box_encoder = false;
+    NumaPlacement _numa_placement;
+    std::atomic<long long unsigned> _reader_wait_time{0}, _writer_wait_time{0};
 };
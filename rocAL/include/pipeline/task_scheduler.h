@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "pipeline/commons.h"
+#include "pipeline/numa_placement.h"
+
+//! Urgency of the tasks of a pipeline, the scheduler runs the pending tasks of the most urgent pipelines first
+enum class TaskPriority {
+    HIGH = 0,
+    NORMAL,
+    LOW
+};
+
+/*! \class TaskScheduler Process-wide pool of worker threads shared by the readers, the decoders, the metadata processing and the output copies of all the pipelines.
+ *  Each worker keeps a queue of tasks per priority, runs its own tasks last in first out and steals from the other workers first in first out once it has none.
+ *  The pool only grows up to the largest thread budget given to a pipeline, the threads calling parallel_for() counting as part of it.
+ *  There is one pool per NUMA node the pipelines are bound to, whose workers only run on the cores of the node, and one unbound pool.
+ */
+class TaskScheduler {
+   public:
+    //! Returns the pool of \p numa_node, by default the one of the node the calling thread is bound to or the unbound pool if it is not bound
+    static TaskScheduler &instance(int numa_node = NumaPlacement::current_thread_node());
+    ~TaskScheduler();
+    TaskScheduler(const TaskScheduler &) = delete;
+    TaskScheduler &operator=(const TaskScheduler &) = delete;
+    //! Grows the pool so that a pipeline can run \p thread_budget tasks at once, the calling thread being one of them
+    void reserve(size_t thread_budget);
+    //! Runs func(index, slot) for every index in [0, count), handing the indices out in order to at most \p max_parallelism threads, the calling thread being one of them
+    /*!
+     \param count Number of indices to run
+     \param max_parallelism Maximum number of threads running the indices at once
+     \param priority Urgency of the helper tasks queued to the workers
+     \param func Function run for each index, slot is in [0, max_parallelism) and identifies the thread among the ones running the indices, so that per thread state can be indexed by it
+     Returns once all the indices ran, rethrows the first exception thrown by func, the indices not started yet are skipped then
+    */
+    void parallel_for(size_t count, size_t max_parallelism, TaskPriority priority, const std::function<void(size_t, size_t)> &func);
+    //! Returns the number of worker threads in the pool
+    size_t worker_count() { return _worker_count; }
+
+   private:
+    explicit TaskScheduler(const NumaPlacement &placement);
+    using Task = std::function<void()>;
+    static constexpr size_t PRIORITY_LEVELS = 3;
+    struct Worker {
+        std::mutex lock;
+        std::deque<Task> queues[PRIORITY_LEVELS];
+    };
+    void push(Task task, TaskPriority priority);
+    bool pop_or_steal(size_t worker_idx, Task &task);
+    void routine(size_t worker_idx);
+    NumaPlacement _placement;                       //!< Cores the workers run on
+    std::vector<std::unique_ptr<Worker>> _workers;  //!< Allocated for the largest pool up front, so the workers can steal while the pool grows
+    std::vector<std::thread> _threads;
+    std::atomic<size_t> _worker_count{0};
+    std::atomic<size_t> _next_worker{0};  //!< Worker the next task pushed from outside the pool is queued to
+    std::mutex _lock;
+    std::condition_variable _wait_for_task;
+    size_t _pending = 0;
+    bool _running = true;
+};
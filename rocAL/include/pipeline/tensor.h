@@ -327,6 +327,15 @@ class Tensor : public rocalTensor {
     unsigned copy_data(void* user_buffer, RocalOutputMemType external_mem_type) override;
     //! Copying the output buffer with specified max_cols and max_rows values for the 2D buffer of size batch_size
     unsigned copy_data(void* user_buffer, uint x_offset, uint y_offset, uint max_rows, uint max_cols); 
+    //! Number of samples copy_data_ragged() copies, each frame of a sequence having its own ROI
+    size_t ragged_sample_count() override;
+    //! Bytes the samples take packed one after the other, each sample keeping only its ROI
+    size_t ragged_data_size() override;
+    //! Copies the ROI of each sample packed one after the other, so the copy and the user buffer do not pay for the padding up to the max shape
+    /*!
+     \param sample_offsets Receives the byte offset of each sample in user_buffer, ragged_sample_count() values
+    */
+    unsigned copy_data_ragged(void* user_buffer, size_t* sample_offsets, RocalOutputMemType external_mem_type) override;
     //! Default destructor
     /*! Releases the OpenVX Tensor object */
     ~Tensor();
@@ -365,6 +374,17 @@ class Tensor : public rocalTensor {
     }
 
    private:
+    //! Where the ROI of a sample lies in the padded buffer
+    struct RaggedSample {
+        size_t offset;      //!< Byte offset of the first row of the ROI
+        size_t row_size;    //!< Bytes of a row of the ROI
+        size_t row_count;   //!< Rows of the ROI in each plane
+        size_t row_pitch;   //!< Bytes between two rows in the padded buffer
+        size_t plane_count; //!< Channel planes of a planar layout, 1 otherwise
+        size_t plane_pitch; //!< Bytes between two planes in the padded buffer
+        size_t size() const { return row_size * row_count * plane_count; }
+    };
+    RaggedSample ragged_sample(unsigned sample_idx);
     vx_tensor _vx_handle = nullptr;  //!< The OpenVX tensor
     void* _mem_handle = nullptr;     //!< Pointer to the tensor's internal buffer (opencl or host)
     TensorInfo _info;                //!< The structure holding the info related to the stored OpenVX tensor
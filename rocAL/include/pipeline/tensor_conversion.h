@@ -0,0 +1,76 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "pipeline/commons.h"
+
+//! Conversion of uint8 host images into normalized output tensors, out = in * multiplier[c] + offset[c] per channel
+//! The kernels are built once per instruction set and the fastest one the CPU supports is picked at run time from CPUID
+namespace tensor_conversion {
+
+//! Instruction sets the kernels are built for, from the slowest to the fastest
+enum class Isa {
+    SCALAR = 0,
+    SSE42,
+    AVX2,
+    AVX512
+};
+
+//! One image copied out of a uint8 buffer into a dense output image
+struct ConvertArgs {
+    const uint8_t *src = nullptr;         //!< First pixel of the region copied
+    size_t src_row_stride = 0;            //!< Bytes between two rows of the source
+    size_t src_plane_stride = 0;          //!< Bytes between two planes of a planar source, 0 if the channels are interleaved
+    unsigned channels = 3;                //!< 1 or 3
+    unsigned width = 0;                   //!< Width of the region copied, which is also the width of the output image
+    unsigned height = 0;                  //!< Height of the region copied, which is also the height of the output image
+    void *dst = nullptr;                  //!< First element of the output image
+    RocalTensorlayout dst_layout = RocalTensorlayout::NCHW;    //!< NHWC or NCHW
+    RocalTensorDataType dst_type = RocalTensorDataType::FP32;  //!< FP32, FP16, BF16 or UINT8, the UINT8 values are rounded and saturated
+    float multiplier[3] = {1.0f, 1.0f, 1.0f};                  //!< Per output channel
+    float offset[3] = {0.0f, 0.0f, 0.0f};                      //!< Per output channel
+    bool reverse_channels = false;        //!< Output channel c reads the source channel channels - 1 - c
+};
+
+//! Returns the size in bytes of one element of the output type
+size_t output_element_size(RocalTensorDataType data_type);
+//! Returns the name of the instruction set as printed in the logs
+const char *isa_name(Isa isa);
+//! Returns true if the CPU and the OS support the instruction set
+bool is_supported(Isa isa);
+//! Returns the fastest instruction set supported, the one used by convert(args)
+Isa best_supported_isa();
+//! Converts the image with the fastest kernel supported
+void convert(const ConvertArgs &args);
+//! Converts the image with the kernel of the given instruction set, which has to be supported
+void convert(const ConvertArgs &args, Isa isa);
+
+//! Kernels of each instruction set, called through convert() once the arguments are checked
+void convert_scalar(const ConvertArgs &args);
+void convert_sse42(const ConvertArgs &args);
+void convert_avx2(const ConvertArgs &args);
+void convert_avx512(const ConvertArgs &args);
+
+}  // namespace tensor_conversion
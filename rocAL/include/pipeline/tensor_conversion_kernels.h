@@ -0,0 +1,294 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "pipeline/tensor_conversion.h"
+
+//! Row loops of the conversion kernels, included by the translation unit of each instruction set
+/*!
+ The loops are templates over a vector type V giving the pixel count handled per step (P), the loads that turn uint8
+ pixels into float vectors and the stores into each output type. The pixels left at the end of a row go through
+ ScalarVec, which is also the whole of the scalar kernel. Everything is in an unnamed namespace so that code built for
+ one instruction set never replaces the same function of another one at link time.
+*/
+namespace {
+
+template <RocalTensorDataType T>
+struct OutputElement;
+template <>
+struct OutputElement<RocalTensorDataType::FP32> { using type = float; };
+template <>
+struct OutputElement<RocalTensorDataType::FP16> { using type = uint16_t; };
+template <>
+struct OutputElement<RocalTensorDataType::BF16> { using type = uint16_t; };
+template <>
+struct OutputElement<RocalTensorDataType::UINT8> { using type = uint8_t; };
+
+template <RocalTensorDataType T>
+using Out = typename OutputElement<T>::type;
+
+inline uint32_t float_bits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float bits_float(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+//! Rounds to the nearest even half, overflows to infinity (F. Giesen, float_to_half_fast3_rtne)
+inline uint16_t float_to_half(float value) {
+    constexpr uint32_t f32_infinity = 255u << 23;
+    constexpr uint32_t f16_max = (127u + 16u) << 23;
+    constexpr uint32_t subnormal_magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+    uint32_t f = float_bits(value);
+    const uint32_t sign = f & 0x80000000u;
+    f ^= sign;
+    uint16_t half;
+    if (f >= f16_max) {
+        half = (f > f32_infinity) ? 0x7E00 : 0x7C00;
+    } else if (f < (113u << 23)) {
+        half = static_cast<uint16_t>(float_bits(bits_float(f) + bits_float(subnormal_magic)) - subnormal_magic);
+    } else {
+        const uint32_t mantissa_odd = (f >> 13) & 1;
+        f += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFF + mantissa_odd;
+        half = static_cast<uint16_t>(f >> 13);
+    }
+    return half | static_cast<uint16_t>(sign >> 16);
+}
+
+//! Rounds to the nearest even bfloat16
+inline uint16_t float_to_bfloat16(float value) {
+    uint32_t bits = float_bits(value);
+    bits += 0x7FFF + ((bits >> 16) & 1);
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+//! Rounds to the nearest even integer and saturates to [0, 255]
+inline uint8_t float_to_uint8(float value) {
+    return static_cast<uint8_t>(std::nearbyint(std::min(std::max(value, 0.0f), 255.0f)));
+}
+
+//! One pixel per step, used for the pixels left at the end of the rows and by the scalar kernel
+struct ScalarVec {
+    static constexpr unsigned P = 1;
+    static constexpr unsigned OVERREAD_PIXELS = 0;  //!< Pixels read past the last pixel converted by a 3 channel step
+    using F = float;
+    using Mask = bool;
+
+    static F set1(float value) { return value; }
+    static F load(const float *src) { return *src; }
+    static F fmadd(F x, F multiplier, F offset) { return x * multiplier + offset; }
+    static F load_u8(const uint8_t *src) { return *src; }
+    static Mask deinterleave_mask(bool reverse_channels) { return reverse_channels; }
+    static Mask reverse_mask() { return true; }
+    //! Splits P interleaved 3 channel pixels into one vector per output channel
+    static void deinterleave(const uint8_t *src, Mask reverse_channels, F out[3]) {
+        out[0] = src[reverse_channels ? 2 : 0];
+        out[1] = src[1];
+        out[2] = src[reverse_channels ? 0 : 2];
+    }
+    //! Reverses the channels of P interleaved 3 channel pixels, out[g] holds the elements g * P to g * P + P - 1
+    static void reverse(const uint8_t *src, Mask, F out[3]) {
+        out[0] = src[2];
+        out[1] = src[1];
+        out[2] = src[0];
+    }
+    //! Interleaves P pixels of three planes, out[g] holds the elements g * P to g * P + P - 1
+    static void interleave(const uint8_t *src0, const uint8_t *src1, const uint8_t *src2, F out[3]) {
+        out[0] = *src0;
+        out[1] = *src1;
+        out[2] = *src2;
+    }
+    template <RocalTensorDataType T>
+    static void store(Out<T> *dst, F value) {
+        if constexpr (T == RocalTensorDataType::FP32)
+            *dst = value;
+        else if constexpr (T == RocalTensorDataType::FP16)
+            *dst = float_to_half(value);
+        else if constexpr (T == RocalTensorDataType::BF16)
+            *dst = float_to_bfloat16(value);
+        else
+            *dst = float_to_uint8(value);
+    }
+};
+
+//! Multipliers and offsets laid out for the vector loads, pattern[i] applies to the element i of a row
+struct Coefficients {
+    static constexpr unsigned PATTERN_LENGTH = 3 * 16 + 3;  // Three steps of the widest vector plus the phase of the tail
+    float packed_multiplier[PATTERN_LENGTH];                 //!< Interleaved output, the channel of element i is i % 3
+    float packed_offset[PATTERN_LENGTH];
+    float channel_multiplier[3][PATTERN_LENGTH];             //!< Single channel rows
+    float channel_offset[3][PATTERN_LENGTH];
+
+    explicit Coefficients(const tensor_conversion::ConvertArgs &args) {
+        for (unsigned i = 0; i < PATTERN_LENGTH; i++) {
+            packed_multiplier[i] = args.multiplier[i % 3];
+            packed_offset[i] = args.offset[i % 3];
+            for (unsigned channel = 0; channel < 3; channel++) {
+                channel_multiplier[channel][i] = args.multiplier[channel];
+                channel_offset[channel][i] = args.offset[channel];
+            }
+        }
+    }
+};
+
+//! dst[i] = src[i] * multiplier[i] + offset[i] for i in [first, count), the patterns repeating every 3 elements
+template <class V, RocalTensorDataType T>
+size_t convert_contiguous(const uint8_t *src, Out<T> *dst, size_t first, size_t count, const float *multiplier, const float *offset) {
+    constexpr unsigned STEP = 3 * V::P;
+    typename V::F mul[3], add[3];
+    for (unsigned g = 0; g < 3; g++) {
+        mul[g] = V::load(multiplier + first % 3 + g * V::P);
+        add[g] = V::load(offset + first % 3 + g * V::P);
+    }
+    size_t i = first;
+    for (; i + STEP <= count; i += STEP)
+        for (unsigned g = 0; g < 3; g++)
+            V::template store<T>(dst + i + g * V::P, V::fmadd(V::load_u8(src + i + g * V::P), mul[g], add[g]));
+    for (; i < count; i++)
+        ScalarVec::store<T>(dst + i, ScalarVec::fmadd(src[i], multiplier[i % 3], offset[i % 3]));
+    return i;
+}
+
+//! Interleaved 3 channel row into three output planes
+template <class V, RocalTensorDataType T>
+size_t convert_deinterleave(const uint8_t *src, Out<T> *dst[3], size_t x, size_t width, bool reverse_channels, const tensor_conversion::ConvertArgs &args) {
+    typename V::F mul[3], add[3], pixels[3];
+    for (unsigned channel = 0; channel < 3; channel++) {
+        mul[channel] = V::set1(args.multiplier[channel]);
+        add[channel] = V::set1(args.offset[channel]);
+    }
+    const auto mask = V::deinterleave_mask(reverse_channels);
+    for (; x + V::P + V::OVERREAD_PIXELS <= width; x += V::P) {
+        V::deinterleave(src + 3 * x, mask, pixels);
+        for (unsigned channel = 0; channel < 3; channel++)
+            V::template store<T>(dst[channel] + x, V::fmadd(pixels[channel], mul[channel], add[channel]));
+    }
+    return x;
+}
+
+//! Interleaved 3 channel row into an interleaved output with the channels reversed
+template <class V, RocalTensorDataType T>
+size_t convert_reverse(const uint8_t *src, Out<T> *dst, size_t x, size_t width, const Coefficients &coeffs) {
+    typename V::F mul[3], add[3], elements[3];
+    for (unsigned g = 0; g < 3; g++) {
+        mul[g] = V::load(coeffs.packed_multiplier + g * V::P);
+        add[g] = V::load(coeffs.packed_offset + g * V::P);
+    }
+    const auto mask = V::reverse_mask();
+    for (; x + V::P + V::OVERREAD_PIXELS <= width; x += V::P) {
+        V::reverse(src + 3 * x, mask, elements);
+        for (unsigned g = 0; g < 3; g++)
+            V::template store<T>(dst + 3 * x + g * V::P, V::fmadd(elements[g], mul[g], add[g]));
+    }
+    return x;
+}
+
+//! Three source planes into an interleaved output
+template <class V, RocalTensorDataType T>
+size_t convert_interleave(const uint8_t *src[3], Out<T> *dst, size_t x, size_t width, const Coefficients &coeffs) {
+    typename V::F mul[3], add[3], elements[3];
+    for (unsigned g = 0; g < 3; g++) {
+        mul[g] = V::load(coeffs.packed_multiplier + g * V::P);
+        add[g] = V::load(coeffs.packed_offset + g * V::P);
+    }
+    for (; x + V::P <= width; x += V::P) {
+        V::interleave(src[0] + x, src[1] + x, src[2] + x, elements);
+        for (unsigned g = 0; g < 3; g++)
+            V::template store<T>(dst + 3 * x + g * V::P, V::fmadd(elements[g], mul[g], add[g]));
+    }
+    return x;
+}
+
+template <class V, RocalTensorDataType T>
+void convert_image(const tensor_conversion::ConvertArgs &args) {
+    const Coefficients coeffs(args);
+    const size_t width = args.width;
+    const size_t plane_size = width * args.height;
+    const bool planar_source = args.src_plane_stride != 0;
+    const bool planar_output = args.dst_layout == RocalTensorlayout::NCHW;
+    auto dst = static_cast<Out<T> *>(args.dst);
+    for (size_t row = 0; row < args.height; row++) {
+        const uint8_t *src_row = args.src + row * args.src_row_stride;
+        if (args.channels == 1) {
+            convert_contiguous<V, T>(src_row, dst + row * width, 0, width, coeffs.channel_multiplier[0], coeffs.channel_offset[0]);
+            continue;
+        }
+        const uint8_t *src_planes[3];
+        for (unsigned channel = 0; channel < 3; channel++)
+            src_planes[channel] = src_row + (args.reverse_channels ? 2 - channel : channel) * args.src_plane_stride;
+        if (planar_output) {
+            Out<T> *dst_planes[3];
+            for (unsigned channel = 0; channel < 3; channel++)
+                dst_planes[channel] = dst + channel * plane_size + row * width;
+            if (planar_source) {
+                for (unsigned channel = 0; channel < 3; channel++)
+                    convert_contiguous<V, T>(src_planes[channel], dst_planes[channel], 0, width, coeffs.channel_multiplier[channel], coeffs.channel_offset[channel]);
+            } else {
+                size_t x = convert_deinterleave<V, T>(src_row, dst_planes, 0, width, args.reverse_channels, args);
+                convert_deinterleave<ScalarVec, T>(src_row, dst_planes, x, width, args.reverse_channels, args);
+            }
+        } else {
+            Out<T> *dst_row = dst + row * width * 3;
+            if (planar_source) {
+                size_t x = convert_interleave<V, T>(src_planes, dst_row, 0, width, coeffs);
+                convert_interleave<ScalarVec, T>(src_planes, dst_row, x, width, coeffs);
+            } else if (args.reverse_channels) {
+                size_t x = convert_reverse<V, T>(src_row, dst_row, 0, width, coeffs);
+                convert_reverse<ScalarVec, T>(src_row, dst_row, x, width, coeffs);
+            } else {
+                convert_contiguous<V, T>(src_row, dst_row, 0, 3 * width, coeffs.packed_multiplier, coeffs.packed_offset);
+            }
+        }
+    }
+}
+
+//! Instantiates the kernel of the output type
+template <class V>
+void convert_with(const tensor_conversion::ConvertArgs &args) {
+    switch (args.dst_type) {
+        case RocalTensorDataType::FP32:
+            convert_image<V, RocalTensorDataType::FP32>(args);
+            break;
+        case RocalTensorDataType::FP16:
+            convert_image<V, RocalTensorDataType::FP16>(args);
+            break;
+        case RocalTensorDataType::BF16:
+            convert_image<V, RocalTensorDataType::BF16>(args);
+            break;
+        case RocalTensorDataType::UINT8:
+            convert_image<V, RocalTensorDataType::UINT8>(args);
+            break;
+        default:
+            THROW("Unsupported output data type " + TOSTR(args.dst_type))
+    }
+}
+
+}  // namespace
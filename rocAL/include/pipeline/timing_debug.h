@@ -53,6 +53,14 @@ class TimingDbg {
         _t_start = std::chrono::high_resolution_clock::now();
     }
 
+    //! Starts the timer at a time point recorded elsewhere
+    inline void start(std::chrono::high_resolution_clock::time_point t_start) {
+        if (!_enable)
+            return;
+
+        _t_start = t_start;
+    }
+
     //! Stops the timer
     inline void end() {
         if (!_enable)
@@ -68,6 +76,18 @@ class TimingDbg {
         }
     }
 
+    //! Stops the timer at a time point recorded elsewhere, e.g. when the last asynchronous operation completed
+    inline void end(std::chrono::high_resolution_clock::time_point t_end) {
+        if (!_enable)
+            return;
+
+        if (_t_start < t_end) {
+            _instantaneous_time = t_end - _t_start;
+            _accumulated_time = _accumulated_time + _instantaneous_time;
+            _count++;
+        }
+    }
+
     //! Prints total elapsed time
     unsigned long long get_timing() {
         if (!_enable)
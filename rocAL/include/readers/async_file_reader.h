@@ -0,0 +1,96 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#if ENABLE_IO_URING
+#include <liburing.h>
+#endif
+
+#include "pipeline/commons.h"
+
+/*! \class AsyncFileReader Keeps a bounded number of whole-file reads in flight and lets the caller wait on each of them individually.
+ *  Uses io_uring when rocAL is built with liburing and the kernel supports it, a pool of reader threads otherwise.
+ */
+class AsyncFileReader {
+   public:
+    enum class Backend {
+        IO_URING = 0,
+        THREAD_POOL
+    };
+    //! Constructor
+    /*!
+     \param queue_depth Maximum number of reads in flight
+     \param num_threads Number of reader threads used by the thread pool backend
+    */
+    AsyncFileReader(size_t queue_depth, size_t num_threads);
+    ~AsyncFileReader();
+    //! Prepares slot_count slots for a new round of reads, must not be called while reads are pending
+    void reset(size_t slot_count);
+    //! Queues the read of the whole file at path into buffer, buffer is grown to the file size if needed
+    void submit(size_t slot, const std::string &path, std::vector<unsigned char> *buffer);
+    //! Blocks until the read queued on slot has landed
+    /*!
+     \return The number of bytes read, 0 if the file couldn't be accessed
+    */
+    size_t wait(size_t slot);
+    //! Blocks until all the reads queued since the last reset() have landed
+    void wait_all();
+    //! Returns the time point the last read queued since the last reset() landed
+    std::chrono::high_resolution_clock::time_point last_completion_time();
+    Backend backend() { return _backend; }
+
+   private:
+    struct Request {
+        std::string path;
+        std::vector<unsigned char> *buffer = nullptr;
+        size_t size = 0;
+        size_t read_size = 0;
+        int fd = -1;
+        bool pending = false;
+    };
+    void worker_routine();
+    size_t read_file(Request &request);
+    void complete(size_t slot, size_t read_size);
+#if ENABLE_IO_URING
+    void reap_completion();
+    struct io_uring _ring;
+    size_t _in_flight = 0;
+#endif
+    Backend _backend;
+    const size_t _queue_depth;
+    std::vector<Request> _requests;
+    std::deque<size_t> _queue;
+    std::vector<std::thread> _workers;
+    std::mutex _lock;
+    std::condition_variable _wait_for_request;
+    std::condition_variable _wait_for_completion;
+    std::chrono::high_resolution_clock::time_point _last_completion;
+    size_t _pending_count = 0;
+    bool _running = true;
+};
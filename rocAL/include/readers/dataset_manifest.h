@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "pipeline/commons.h"
+
+/*! \class DatasetManifest Cached listing of a dataset folder, persisted in a manifest directory so that pipelines can be created without walking the dataset.
+ *  It holds the sorted entries of the root folder and, for the root and each of its sub folders, the sorted regular files with their size and decoded dimensions.
+ *  Folders are re-listed only when their modification time changed, the dimensions of the files whose name and size are unchanged are kept.
+ */
+class DatasetManifest {
+   public:
+    struct File {
+        std::string name;
+        uint64_t size = 0;
+        uint32_t width = 0;  //!< Decoded dimensions, 0 until found by the ImageSourceEvaluator
+        uint32_t height = 0;
+    };
+    struct Folder {
+        std::string name;  //!< Name of the sub folder, empty for the root folder
+        int64_t mtime_sec = -1;
+        int64_t mtime_nsec = -1;
+        int label = 0;  //!< Index of the sub folder among the sorted sub folders of the root, as assigned by the folder label reader
+        std::vector<File> files;
+    };
+    struct RootEntry {
+        std::string name;
+        bool is_directory = false;
+        size_t folder_idx = 0;  //!< Index of the folder for sub folders, 0 (the root folder) for files
+    };
+    //! Returns the manifest of root_path kept in manifest_dir, loading and refreshing it or creating it if needed
+    static std::shared_ptr<DatasetManifest> get(const std::string &manifest_dir, const std::string &root_path);
+    //! Returns true if the file name has one of the extensions the file readers load, the one list the readers and the manifest filter the files with
+    static bool is_supported_file(const std::string &file_name);
+    const std::string &root_path() const { return _root_path; }
+    const std::vector<RootEntry> &root_entries() const { return _root_entries; }
+    const Folder &folder(size_t folder_idx) const { return _folders[folder_idx]; }
+    //! Returns the path of the file relative to the root folder
+    std::string relative_path(size_t folder_idx, size_t file_idx) const;
+    //! Finds the file at relative_path as returned by relative_path()
+    bool find(const std::string &relative_path, size_t &folder_idx, size_t &file_idx);
+    void set_dimensions(size_t folder_idx, size_t file_idx, uint32_t width, uint32_t height);
+    //! Writes the manifest back if it changed since it was loaded
+    void save();
+    DatasetManifest(const std::string &manifest_path, const std::string &root_path) : _manifest_path(manifest_path), _root_path(root_path) {}
+
+   private:
+    bool load();
+    void refresh();
+    void scan_folder(Folder &folder, const std::string &path);
+    std::string folder_path(size_t folder_idx) const;
+    std::string _manifest_path;
+    std::string _root_path;
+    int64_t _root_mtime_sec = -1;
+    int64_t _root_mtime_nsec = -1;
+    std::vector<RootEntry> _root_entries;
+    std::vector<Folder> _folders;  //!< _folders[0] holds the files of the root folder
+    std::unordered_map<std::string, std::pair<size_t, size_t>> _path_map;  //!< Built on the first find()
+    bool _dirty = false;
+    std::mutex _lock;
+    static const uint32_t VERSION = 1;
+};
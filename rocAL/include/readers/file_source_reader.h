@@ -50,12 +50,27 @@ class FileSourceReader : public Reader {
     */
     size_t open() override;
 
+    //! Advances to the next file in the folder without opening it
+    void open_deferred() override;
+
+    bool supports_deferred_open() override { return true; }
+
+    bool supports_mapped_read() override { return _file_read_mode != FileReadMode::COPY; }
+
+    //! Advances to the next file and maps it into memory
+    unsigned char *map_data(size_t &size) override;
+
+    void unmap_data(unsigned char *data, size_t size) override;
+
     //! Resets the object's state to read from the first file in the folder
     void reset() override;
 
     //! Returns the name of the latest file opened
     std::string id() override { return _last_id; };
 
+    //! Returns the position of the latest file opened in the listing of the folder, which shuffling doesn't change
+    uint32_t sample_index() override { return _last_sample_index; }
+
     //! Returns the name of the latest file_path opened
     const std::string file_path() override { return _last_file_path; }
 
@@ -76,18 +91,23 @@ class FileSourceReader : public Reader {
     //! opens the folder containnig the images
     Reader::Status open_folder();
     Reader::Status subfolder_reading();
+    //! Lists the files from the dataset manifest instead of walking the folder
+    Reader::Status manifest_reading();
     std::string _folder_path;
+    std::string _manifest_dir;
     std::string _file_list_path;
     DIR *_src_dir;
     DIR *_sub_dir;
     struct dirent *_entity;
     std::vector<std::string> _file_names;
+    std::vector<uint32_t> _file_order;  //!< Indices of _file_names in read order, shuffled instead of the names so that the index of a file is its sample index
     unsigned _curr_file_idx;
     FILE *_current_fPtr;
     unsigned _current_file_size;
     unsigned _shard_start_idx;
     std::vector<unsigned> _shard_start_idx_vector, _shard_end_idx_vector;
     std::string _last_id;
+    uint32_t _last_sample_index = INVALID_SAMPLE_INDEX;
     std::string _last_file_name, _last_file_path, _absolute_file_path;
     size_t _shard_id = 0;
     size_t _shard_count = 1;  // equivalent of batch size
@@ -96,10 +116,12 @@ class FileSourceReader : public Reader {
     size_t _padded_samples = 0;
     bool _loop;
     bool _shuffle;
+    FileReadMode _file_read_mode = FileReadMode::COPY;
     int _read_counter = 0;
     //!< _file_count_all_shards total_number of files in to figure out the max_batch_size (usually needed for distributed training).
     size_t _file_count_all_shards;
     void incremenet_read_ptr();
+    std::string advance_to_next_file();
     void increment_curr_file_idx();
     int release();
     void fill_last_batch();
@@ -22,16 +22,15 @@ THE SOFTWARE.
 
 #pragma once
 #include <dirent.h>
-#include <google/protobuf/message_lite.h>
 
 #include <algorithm>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-#include "caffe2_protos.pb.h"
 #include <lmdb.h>
 #include "readers/image/image_reader.h"
 #include "pipeline/timing_debug.h"
@@ -62,10 +61,18 @@ class Caffe2LMDBRecordReader : public Reader {
 
     unsigned count_items() override;
 
+    //! The image bytes are always served in place from LMDB's memory map
+    bool supports_mapped_read() override { return true; }
+
+    unsigned char* map_data(size_t& size) override;
+
     ~Caffe2LMDBRecordReader() override;
 
     int close() override;
 
+    //! Moves to the next record without reading it, open() doesn't move forward
+    void skip() override { incremenet_read_ptr(); }
+
     Caffe2LMDBRecordReader();
 
    private:
@@ -105,15 +112,16 @@ class Caffe2LMDBRecordReader : public Reader {
     void incremenet_file_id() { _file_id++; }
     void replicate_last_image_to_fill_last_shard();
     void replicate_last_batch_to_pad_partial_shard();
-    void read_image(unsigned char* buff, std::string file_name);
+    void read_image(unsigned char* buff, const std::string& file_name);
     void read_image_names();
-    std::map<std::string, uint> _image_record_starting;
-    int _open_env = 1;
-    int rc;
-    MDB_env* _read_mdb_env;
+    MDB_env* _read_mdb_env = nullptr;
     MDB_dbi _read_mdb_dbi;
-    MDB_val _read_mdb_key, _read_mdb_value;
-    MDB_txn* _read_mdb_txn;
-    MDB_cursor* _read_mdb_cursor;
+    MDB_txn* _read_mdb_txn = nullptr;  //!< Read transaction kept open for the lifetime of the reader, the values it returned stay valid until it ends
+    //! Location of the image bytes of a record inside LMDB's memory map
+    struct RecordData {
+        unsigned char* data;
+        size_t size;
+    };
+    std::unordered_map<std::string, RecordData> _record_data;
     void open_env_for_read_image();
 };
@@ -22,7 +22,6 @@ THE SOFTWARE.
 
 #pragma once
 #include <dirent.h>
-#include <google/protobuf/message_lite.h>
 #include <lmdb.h>
 
 #include <algorithm>
@@ -30,9 +29,9 @@ THE SOFTWARE.
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-#include "caffe_protos.pb.h"
 #include "readers/image/image_reader.h"
 #include "pipeline/timing_debug.h"
 
@@ -62,10 +61,18 @@ class CaffeLMDBRecordReader : public Reader {
 
     unsigned count_items() override;
 
+    //! The image bytes are always served in place from LMDB's memory map
+    bool supports_mapped_read() override { return true; }
+
+    unsigned char* map_data(size_t& size) override;
+
     ~CaffeLMDBRecordReader() override;
 
     int close() override;
 
+    //! Moves to the next record without reading it, open() doesn't move forward
+    void skip() override { incremenet_read_ptr(); }
+
     CaffeLMDBRecordReader();
 
    private:
@@ -94,11 +101,15 @@ class CaffeLMDBRecordReader : public Reader {
     bool _loop;
     bool _shuffle;
     int _read_counter = 0;
-    MDB_env *_mdb_env, *_read_mdb_env;
-    MDB_dbi _mdb_dbi, _read_mdb_dbi;
-    MDB_val _mdb_key, _mdb_value, _read_mdb_key, _read_mdb_value;
-    MDB_txn *_mdb_txn, *_read_mdb_txn;
-    MDB_cursor *_mdb_cursor, *_read_mdb_cursor;
+    MDB_env* _read_mdb_env = nullptr;
+    MDB_dbi _read_mdb_dbi;
+    MDB_txn* _read_mdb_txn = nullptr;  //!< Read transaction kept open for the lifetime of the reader, the values it returned stay valid until it ends
+    //! Location of the image bytes of a record inside LMDB's memory map
+    struct RecordData {
+        unsigned char* data;
+        size_t size;
+    };
+    std::unordered_map<std::string, RecordData> _record_data;
     uint _file_byte_size;
     void incremenet_read_ptr();
     int release();
@@ -108,11 +119,8 @@ class CaffeLMDBRecordReader : public Reader {
     void incremenet_file_id() { _file_id++; }
     void replicate_last_image_to_fill_last_shard();
     void replicate_last_batch_to_pad_partial_shard();
-    void read_image(unsigned char* buff, std::string _file_name);
+    void read_image(unsigned char* buff, const std::string& file_name);
     void read_image_names();
-    std::map<std::string, uint> _image_record_starting;
-    int _open_env = 1;
-    int rc;
     void open_env_for_read_image();
     std::shared_ptr<MetaDataReader> _meta_data_reader = nullptr;
 };
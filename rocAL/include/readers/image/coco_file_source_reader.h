@@ -52,12 +52,20 @@ class COCOFileSourceReader : public Reader {
     */
     size_t open() override;
 
+    //! Advances to the next file in the folder without opening it
+    void open_deferred() override;
+
+    bool supports_deferred_open() override { return true; }
+
     //! Resets the object's state to read from the first file in the folder
     void reset() override;
 
     //! Returns the name of the latest file opened
     std::string id() override { return _last_id; };
 
+    //! Returns the name of the latest file_path opened
+    const std::string file_path() override { return _last_file_path; }
+
     unsigned count_items() override;
 
     ~COCOFileSourceReader() override;
@@ -71,7 +79,10 @@ class COCOFileSourceReader : public Reader {
     //! opens the folder containnig the images
     Reader::Status open_folder();
     Reader::Status subfolder_reading();
+    //! Lists the files from the dataset manifest instead of walking the folder
+    Reader::Status manifest_reading();
     std::string _folder_path;
+    std::string _manifest_dir;
     std::string _json_path;
     DIR *_src_dir;
     DIR *_sub_dir;
@@ -83,7 +94,7 @@ class COCOFileSourceReader : public Reader {
     std::ifstream _current_ifs;
     unsigned _current_file_size;
     std::string _last_id;
-    std::string _last_file_name;
+    std::string _last_file_name, _last_file_path;
     size_t _shard_id = 0;
     size_t _shard_count = 1;  // equivalent of batch size
     //!< _batch_count Defines the quantum count of the images to be read. It's usually equal to the user's batch size.
@@ -98,6 +109,7 @@ class COCOFileSourceReader : public Reader {
     //!< _file_count_all_shards total_number of files in to figure out the max_batch_size (usually needed for distributed training).
     size_t _file_count_all_shards;
     void incremenet_read_ptr();
+    std::string advance_to_next_file();
     int release();
     size_t get_file_shard_id();
     void incremenet_file_id() { _file_id++; }
@@ -28,6 +28,7 @@ THE SOFTWARE.
 
 #include <lmdb.h>
 #include "meta_data/meta_data_reader.h"
+#include "pipeline/task_scheduler.h"
 #include "readers/video/video_properties.h"
 
 #define CHECK_LMDB_RETURN_STATUS(status)                                                          \
@@ -57,6 +58,12 @@ enum class ExternalSourceFileMode {
     NONE = 3,
 };
 
+enum class FileReadMode {
+    COPY = 0,           // Files are read into the reader's buffers
+    MMAP,               // Files are memory mapped and prefetched with madvise(MADV_WILLNEED)
+    MMAP_POPULATE       // Files are memory mapped with MAP_POPULATE
+};
+
 struct ShardingInfo {
     RocalBatchPolicy last_batch_policy;
     bool pad_last_batch_repeated;
@@ -101,6 +108,10 @@ struct ReaderConfig {
     void set_frame_step(unsigned step) { _sequence_frame_step = step; }
     void set_frame_stride(unsigned stride) { _sequence_frame_stride = stride; }
     void set_external_filemode(ExternalSourceFileMode mode) { _file_mode = mode; }
+    void set_file_read_mode(FileReadMode file_read_mode) { _file_read_mode = file_read_mode; }
+    void set_manifest_dir(const std::string &manifest_dir) { _manifest_dir = manifest_dir; }
+    void set_task_priority(TaskPriority task_priority) { _task_priority = task_priority; }
+    void set_size_bucketing(size_t pool_batch_count) { _size_bucketing_pool_batch_count = pool_batch_count; }
     void set_sharding_info(const ShardingInfo& sharding_info) {
         _sharding_info = sharding_info;
     }
@@ -125,6 +136,10 @@ struct ReaderConfig {
     std::shared_ptr<MetaDataReader> meta_data_reader() { return _meta_data_reader; }
     ExternalSourceFileMode mode() { return _file_mode; }
     const ShardingInfo& get_sharding_info() { return _sharding_info; }
+    FileReadMode file_read_mode() { return _file_read_mode; }
+    std::string manifest_dir() { return _manifest_dir; }
+    TaskPriority task_priority() { return _task_priority; }
+    size_t size_bucketing_pool_batch_count() { return _size_bucketing_pool_batch_count; }
 
    private:
     StorageType _type = StorageType::FILE_SYSTEM;
@@ -145,6 +160,10 @@ struct ReaderConfig {
     std::shared_ptr<MetaDataReader> _meta_data_reader = nullptr;
     ExternalSourceFileMode _file_mode = ExternalSourceFileMode::NONE;
     ShardingInfo _sharding_info;
+    FileReadMode _file_read_mode = FileReadMode::COPY;
+    std::string _manifest_dir;  //!< Directory of the persistent dataset manifests, the dataset folder is walked at every start when empty
+    TaskPriority _task_priority = TaskPriority::NORMAL;  //!< Urgency of the read and decode tasks of the pipeline in the shared task scheduler
+    size_t _size_bucketing_pool_batch_count = 0;  //!< Number of batches read ahead and regrouped by image size, bucketing is disabled when 0
 #ifdef ROCAL_VIDEO
     VideoProperties _video_prop;
 #endif
@@ -194,11 +213,42 @@ class Reader {
     //! Closes the opened item
     virtual int close() = 0;
 
+    //! Moves past the next item without reading its data, readers moving forward in read_data() instead of open() override it
+    virtual void skip() {
+        open();
+        close();
+    }
+
+    //! Returns true if the reader can advance without accessing the item, leaving the read of file_path() to an asynchronous I/O engine
+    virtual bool supports_deferred_open() { return false; }
+
+    //! Advances to the next item without accessing it, id() and file_path() refer to this item afterwards
+    virtual void open_deferred() { THROW("Deferred open is not supported by the reader") }
+
+    //! Returns true if the reader is set to map the items into memory instead of copying them
+    virtual bool supports_mapped_read() { return false; }
+
+    //! Advances to the next item and maps it into memory, id() refers to this item afterwards
+    /*!
+     \param size Set to the size of the mapped item, 0 if it couldn't be mapped
+     \return Pointer to the mapped item, valid until unmap_data() is called on it, nullptr if the item couldn't be mapped
+    */
+    virtual unsigned char *map_data(size_t &size) { THROW("Mapped read is not supported by the reader") }
+
+    //! Releases a mapping returned by map_data()
+    virtual void unmap_data(unsigned char *data, size_t size) {}
+
     //! Starts reading from the first item in the resource
     virtual void reset() = 0;
 
     //! Returns the name/identifier of the last item opened in this resource
     virtual std::string id() = 0;
+
+    //! Returns the dense index of the last item opened, given to each item when the resource is enumerated and kept across the epochs
+    /*!
+     \return The index, INVALID_SAMPLE_INDEX if the reader doesn't number its items
+    */
+    virtual uint32_t sample_index() { return INVALID_SAMPLE_INDEX; }
     //! Returns the number of items remained in this resource
 
      //! Returns the path of the last item opened in this resource
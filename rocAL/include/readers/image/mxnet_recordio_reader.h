@@ -22,6 +22,7 @@ THE SOFTWARE.
 
 #pragma once
 #include <dirent.h>
+#include <sys/mman.h>
 
 #include <algorithm>
 #include <fstream>
@@ -60,10 +61,18 @@ class MXNetRecordIOReader : public Reader {
 
     unsigned count_items() override;
 
+    bool supports_mapped_read() override { return _rec_data != nullptr; }
+
+    //! Advances to the next record and returns a pointer to its image inside the mapped .rec file
+    unsigned char* map_data(size_t& size) override;
+
     ~MXNetRecordIOReader() override;
 
     int close() override;
 
+    //! Moves to the next record without reading it, open() doesn't move forward
+    void skip() override { incremenet_read_ptr(); }
+
     MXNetRecordIOReader();
 
    private:
@@ -101,12 +110,17 @@ class MXNetRecordIOReader : public Reader {
     void incremenet_file_id() { _file_id++; }
     void replicate_last_image_to_fill_last_shard();
     void replicate_last_batch_to_pad_partial_shard();
-    void read_image(unsigned char* buff, int64_t seek_position, int64_t data_size);
+    void read_image(unsigned char* buff, int64_t image_offset, int64_t image_size);
     void read_image_names();
+    void map_record_file(size_t rec_size);
     uint32_t DecodeFlag(uint32_t rec) { return (rec >> 29U) & 7U; };
     uint32_t DecodeLength(uint32_t rec) { return rec & ((1U << 29U) - 1U); };
     std::vector<std::tuple<int64_t, int64_t>> _indices;  // used to store seek position and record size for a particular record.
-    std::ifstream _file_contents;
+    int _rec_fd = -1;                                     //!< The .rec file, read with pread() so that reads don't share a stream position
+    unsigned char* _rec_data = nullptr;                   //!< The .rec file mapped into memory when the read mode is not FileReadMode::COPY
+    size_t _rec_size = 0;
+    FileReadMode _file_read_mode = FileReadMode::COPY;
+    size_t _num_threads = 1;
     const uint32_t _kMagic = 0xced7230a;
     int64_t _seek_pos, _data_size_to_read;
     ImageRecordIOHeader _hdr;
@@ -0,0 +1,101 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+//! Minimal reader of the protobuf wire format, used to locate the fields of serialized records in place without materializing the messages
+namespace proto_wire {
+
+inline bool read_varint(const uint8_t *&ptr, const uint8_t *end, uint64_t &value) {
+    value = 0;
+    for (unsigned shift = 0; ptr < end && shift < 64; shift += 7) {
+        uint8_t byte = *ptr++;
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+inline bool skip_field(const uint8_t *&ptr, const uint8_t *end, unsigned wire_type) {
+    uint64_t value;
+    switch (wire_type) {
+        case 0:
+            return read_varint(ptr, end, value);
+        case 1:
+            ptr += 8;
+            return ptr <= end;
+        case 2:
+            if (!read_varint(ptr, end, value) || value > (uint64_t)(end - ptr))
+                return false;
+            ptr += value;
+            return true;
+        case 5:
+            ptr += 4;
+            return ptr <= end;
+        default:
+            return false;
+    }
+}
+
+//! Iterates over the fields of the message in [ptr, end), calling visit(field_number, begin, end) for the length delimited ones
+/*!
+ \return false if the message is malformed or visit returned false
+*/
+template <typename Visitor>
+bool for_each_field(const uint8_t *ptr, const uint8_t *end, Visitor visit) {
+    while (ptr < end) {
+        uint64_t tag, length;
+        if (!read_varint(ptr, end, tag))
+            return false;
+        unsigned wire_type = tag & 0x7;
+        if (wire_type != 2) {
+            if (!skip_field(ptr, end, wire_type))
+                return false;
+            continue;
+        }
+        if (!read_varint(ptr, end, length) || length > (uint64_t)(end - ptr))
+            return false;
+        if (!visit(tag >> 3, ptr, ptr + length))
+            return false;
+        ptr += length;
+    }
+    return true;
+}
+
+//! Returns true if field_number of the message in [ptr, end) is length delimited, i.e. holds a sub-message, bytes or a string
+inline bool is_length_delimited(const uint8_t *ptr, const uint8_t *end, uint64_t field_number) {
+    while (ptr < end) {
+        uint64_t tag;
+        if (!read_varint(ptr, end, tag))
+            return false;
+        if ((tag >> 3) == field_number)
+            return (tag & 0x7) == 2;
+        if (!skip_field(ptr, end, tag & 0x7))
+            return false;
+    }
+    return false;
+}
+
+}  // namespace proto_wire
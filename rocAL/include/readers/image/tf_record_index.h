@@ -0,0 +1,82 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "pipeline/commons.h"
+
+/*! \class TFRecordIndex Sidecar index of a TFRecord file, holding per record its offset, length, file name and the byte range of its encoded image.
+ *  The index is built by a single scan of the record file the first time the file is seen, stored next to it as <record file>.rocal.idx and memory mapped afterwards.
+ *  Records are located by walking the protobuf wire format, hence no Example message is materialized.
+ */
+class TFRecordIndex {
+   public:
+    struct Entry {
+        uint64_t record_offset;   //!< Offset of the record header in the TFRecord file
+        uint64_t record_length;   //!< Length of the serialized Example
+        uint64_t encoded_offset;  //!< Offset of the encoded image bytes in the TFRecord file
+        uint64_t encoded_size;    //!< Size of the encoded image
+        uint64_t name_offset;     //!< Offset of the file name in the name table, the name is empty when the records have no file name feature
+        uint64_t name_length;
+    };
+    static constexpr const char *INDEX_SUFFIX = ".rocal.idx";
+    TFRecordIndex() = default;
+    TFRecordIndex(const TFRecordIndex &) = delete;
+    TFRecordIndex &operator=(const TFRecordIndex &) = delete;
+    ~TFRecordIndex();
+    //! Maps the sidecar index of record_path, (re)building it if it is missing or stale
+    /*!
+     \param record_path Path of the TFRecord file
+     \param encoded_key Feature key of the encoded image
+     \param filename_key Feature key of the file name, may be empty
+    */
+    void load(const std::string &record_path, const std::string &encoded_key, const std::string &filename_key);
+    size_t size() const { return _entry_count; }
+    const Entry &entry(size_t idx) const { return _entries[idx]; }
+    std::string name(size_t idx) const { return std::string(_names + _entries[idx].name_offset, _entries[idx].name_length); }
+    //! Returns true if path is a sidecar index written by this class
+    static bool is_index_file(const std::string &path);
+
+   private:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t record_file_size;
+        int64_t record_file_mtime;
+        uint64_t key_hash;  //!< Hash of the feature keys the index was built with
+        uint64_t entry_count;
+    };
+    static const uint32_t VERSION = 1;
+    bool map_index(const std::string &index_path, const Header &expected);
+    void build(const std::string &record_path, const std::string &encoded_key, const std::string &filename_key, const Header &header);
+    void release();
+    void *_map = nullptr;
+    size_t _map_size = 0;
+    std::vector<char> _owned;  //!< Holds the index when the sidecar could not be written
+    const Entry *_entries = nullptr;
+    const char *_names = nullptr;
+    size_t _entry_count = 0;
+};
@@ -22,18 +22,17 @@ THE SOFTWARE.
 
 #pragma once
 #include <dirent.h>
-#include <google/protobuf/message_lite.h>
 
 #include <algorithm>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-#include "example.pb.h"
-#include "feature.pb.h"
 #include "readers/image/image_reader.h"
+#include "readers/image/tf_record_index.h"
 #include "pipeline/timing_debug.h"
 
 class TFRecordReader : public Reader {
@@ -66,6 +65,9 @@ class TFRecordReader : public Reader {
 
     int close() override;
 
+    //! Moves to the next record without reading it, open() doesn't move forward
+    void skip() override { incremenet_read_ptr(); }
+
     TFRecordReader();
 
    private:
@@ -102,17 +104,19 @@ class TFRecordReader : public Reader {
     size_t _file_count_all_shards;
     //!< _record_name_prefix tells the reader to read only files with the prefix
     std::string _record_name_prefix;
-    // protobuf message objects
-    tensorflow::Example _single_example;
-    tensorflow::Features _features;
-    tensorflow::Feature _single_feature;
+    //! Location of the encoded image of a record, the record files stay open for the lifetime of the reader
+    struct RecordLocation {
+        int fd;
+        uint64_t offset;
+    };
+    std::vector<int> _record_fds;
     void incremenet_read_ptr();
     int release();
     size_t get_file_shard_id();
     void incremenet_file_id() { _file_id++; }
     void replicate_last_image_to_fill_last_shard();
     void replicate_last_batch_to_pad_partial_shard();
-    Reader::Status read_image(unsigned char *buff, std::string record_file_name, uint file_size);
-    Reader::Status read_image_names(std::ifstream &file_contents, uint file_size);
-    std::map<std::string, uint> _image_record_starting;
+    Reader::Status read_image(unsigned char *buff, const std::string &file_name, uint file_size);
+    Reader::Status read_image_names(const TFRecordIndex &index, int record_fd);
+    std::unordered_map<std::string, RecordLocation> _record_locations;
 };
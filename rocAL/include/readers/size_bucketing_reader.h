@@ -0,0 +1,78 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "decoders/image/decoder.h"
+#include "readers/image/image_reader.h"
+
+/*! \class SizeBucketingReader Reorders the images of any reader so that each batch holds images of similar sizes, which keeps the padding up to the largest image of the batch small.
+ *  It reads a pool of several batches ahead from the wrapped reader, finds the dimensions of each image from its header, sorts the pool by area and cuts it into batches,
+ *  which are handed out in random order when shuffling. The randomness across the epoch comes from the wrapped reader, the pool only regroups the images it gets.
+ */
+class SizeBucketingReader : public Reader {
+   public:
+    //! Constructor
+    /*!
+     \param reader The reader whose images are regrouped, already initialized
+     \param header_decoder Decoder used to read the dimensions from the image headers, only decode_info() is called on it
+     \param batch_size Images read per batch by the loader
+     \param pool_batch_count Batches read ahead and regrouped together
+    */
+    SizeBucketingReader(std::shared_ptr<Reader> reader, std::shared_ptr<Decoder> header_decoder, size_t batch_size, size_t pool_batch_count, bool shuffle);
+    Reader::Status initialize(ReaderConfig desc) override { return Reader::Status::OK; }
+    size_t open() override;
+    size_t read_data(unsigned char *buf, size_t read_size) override;
+    int close() override { return 0; }
+    void reset() override;
+    std::string id() override { return _last_id; }
+    uint32_t sample_index() override { return _last_sample_index; }
+    unsigned count_items() override { return _reader->count_items() + (_order.size() - _next); }
+    std::string get_root_folder_path() override { return _reader->get_root_folder_path(); }
+    std::vector<std::string> get_file_paths_from_meta_data_reader() override { return _reader->get_file_paths_from_meta_data_reader(); }
+    size_t last_batch_padded_size() override { return _reader->last_batch_padded_size(); }
+
+   private:
+    struct Sample {
+        std::string id;
+        uint32_t sample_index = INVALID_SAMPLE_INDEX;
+        std::vector<unsigned char> data;
+        size_t size = 0;
+        uint32_t width = 0;  //!< Dimensions from the header, 0 if the header could not be read
+        uint32_t height = 0;
+    };
+    void fill_pool();
+    std::shared_ptr<Reader> _reader;
+    std::shared_ptr<Decoder> _header_decoder;
+    size_t _batch_size;
+    size_t _pool_size;
+    bool _shuffle;
+    std::vector<Sample> _pool;
+    std::vector<size_t> _order;  //!< Pool samples in the order they are handed out
+    size_t _next = 0;            //!< Position in _order of the next sample to open
+    size_t _current = 0;         //!< Pool index of the last opened sample
+    std::string _last_id;
+    uint32_t _last_sample_index = INVALID_SAMPLE_INDEX;
+};
@@ -68,8 +68,11 @@ class SequenceFileSourceReader : public Reader {
     //! opens the folder containnig the images
     Reader::Status open_folder();
     Reader::Status subfolder_reading();
+    //! Groups the frames from the dataset manifest instead of walking the folder
+    Reader::Status manifest_reading();
     Reader::Status get_sequences();
     std::string _folder_path;
+    std::string _manifest_dir;
     DIR *_src_dir;
     DIR *_sub_dir;
     struct dirent *_entity;
@@ -43,7 +43,9 @@ rocalCreate(
     int gpu_id,
     size_t cpu_thread_count,
     size_t prefetch_queue_depth,
-    RocalTensorOutputType output_tensor_data_type) {
+    RocalTensorOutputType output_tensor_data_type,
+    RocalNumaPolicy numa_policy,
+    int numa_node) {
     RocalContext context = nullptr;
     try {
         auto translate_process_mode = [](RocalProcessMode process_mode) {
@@ -70,7 +72,19 @@ rocalCreate(
         };
         if (gpu_id < 0)
             ERR(STR("Negative GPU device ID passed to context creation. Setting GPU device ID to 0"));
-        context = new Context(batch_size, translate_process_mode(affinity), std::max(gpu_id, 0), cpu_thread_count, prefetch_queue_depth, translate_output_data_type(output_tensor_data_type));
+        auto translate_numa_policy = [&](RocalNumaPolicy policy) {
+            switch (policy) {
+                case ROCAL_NUMA_NONE:
+                    return NumaPlacement();
+                case ROCAL_NUMA_GPU_LOCAL:
+                    return NumaPlacement::for_gpu(std::max(gpu_id, 0));
+                case ROCAL_NUMA_NODE:
+                    return NumaPlacement::for_node(numa_node);
+                default:
+                    THROW("Unknown Rocal NUMA policy")
+            }
+        };
+        context = new Context(batch_size, translate_process_mode(affinity), std::max(gpu_id, 0), cpu_thread_count, prefetch_queue_depth, translate_output_data_type(output_tensor_data_type), translate_numa_policy(numa_policy));
         // Reset seed in case it's being randomized during context creation
     } catch (const std::exception& e) {
         ERR(STR("Failed to init the Rocal context, ") + STR(e.what()))
@@ -105,3 +119,93 @@ rocalVerify(RocalContext p_context) {
     }
     return ROCAL_OK;
 }
+
+RocalStatus ROCAL_API_CALL
+rocalSetPipelinedExecution(RocalContext p_context, bool enable) {
+    auto context = static_cast<Context*>(p_context);
+    try {
+        context->master_graph->set_pipelined_execution(enable);
+    } catch (const std::exception& e) {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return ROCAL_RUNTIME_ERROR;
+    }
+    return ROCAL_OK;
+}
+
+RocalStatus ROCAL_API_CALL
+rocalSetGraphReplicaCount(RocalContext p_context, unsigned replica_count) {
+    auto context = static_cast<Context*>(p_context);
+    try {
+        context->master_graph->set_graph_replica_count(replica_count);
+    } catch (const std::exception& e) {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return ROCAL_RUNTIME_ERROR;
+    }
+    return ROCAL_OK;
+}
+
+RocalStatus ROCAL_API_CALL
+rocalSetGraphFusion(RocalContext p_context, bool enable) {
+    auto context = static_cast<Context*>(p_context);
+    try {
+        context->master_graph->set_graph_fusion(enable);
+    } catch (const std::exception& e) {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return ROCAL_RUNTIME_ERROR;
+    }
+    return ROCAL_OK;
+}
+
+RocalStatus ROCAL_API_CALL
+rocalSetContinuousEpochs(RocalContext p_context, bool enable) {
+    auto context = static_cast<Context*>(p_context);
+    try {
+        context->master_graph->set_continuous_epochs(enable);
+    } catch (const std::exception& e) {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return ROCAL_RUNTIME_ERROR;
+    }
+    return ROCAL_OK;
+}
+
+RocalStatus ROCAL_API_CALL
+rocalSetTaskPriority(RocalContext p_context, RocalTaskPriority priority) {
+    auto context = static_cast<Context*>(p_context);
+    try {
+        switch (priority) {
+            case ROCAL_TASK_PRIORITY_HIGH:
+                context->master_graph->set_task_priority(TaskPriority::HIGH);
+                break;
+            case ROCAL_TASK_PRIORITY_NORMAL:
+                context->master_graph->set_task_priority(TaskPriority::NORMAL);
+                break;
+            case ROCAL_TASK_PRIORITY_LOW:
+                context->master_graph->set_task_priority(TaskPriority::LOW);
+                break;
+            default:
+                THROW("Unsupported task priority " + TOSTR(priority))
+        }
+    } catch (const std::exception& e) {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return ROCAL_RUNTIME_ERROR;
+    }
+    return ROCAL_OK;
+}
+
+RocalStatus ROCAL_API_CALL
+rocalSetPrefetchAutotune(RocalContext p_context, bool enable, size_t warmup_batch_count, size_t max_prefetch_memory) {
+    auto context = static_cast<Context*>(p_context);
+    try {
+        context->master_graph->set_prefetch_autotune(enable, warmup_batch_count, max_prefetch_memory);
+    } catch (const std::exception& e) {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return ROCAL_RUNTIME_ERROR;
+    }
+    return ROCAL_OK;
+}
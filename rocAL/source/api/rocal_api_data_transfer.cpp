@@ -36,11 +36,25 @@ rocalToTensor(RocalContext p_context, void* out_ptr, RocalTensorLayout tensor_fo
         if (tensor_format != ROCAL_NHWC && tensor_format != ROCAL_NCHW)
             THROW("Supported only for NHWC and NCHW tensor layout")
 
-        if (tensor_output_type != ROCAL_FP32 && tensor_output_type != ROCAL_FP16)
-            THROW("Supported only for FP32 and FP16 tensor data types")
+        RocalTensorDataType tensor_output_data_type;
+        switch (tensor_output_type) {
+            case ROCAL_FP32:
+                tensor_output_data_type = RocalTensorDataType::FP32;
+                break;
+            case ROCAL_FP16:
+                tensor_output_data_type = RocalTensorDataType::FP16;
+                break;
+            case ROCAL_BF16:
+                tensor_output_data_type = RocalTensorDataType::BF16;
+                break;
+            case ROCAL_UINT8:
+                tensor_output_data_type = RocalTensorDataType::UINT8;
+                break;
+            default:
+                THROW("Supported only for FP32, FP16, BF16 and UINT8 tensor data types")
+        }
 
         auto tensor_layout = (tensor_format == ROCAL_NHWC) ? RocalTensorlayout::NHWC : RocalTensorlayout::NCHW;
-        auto tensor_output_data_type = (tensor_output_type == ROCAL_FP32) ? RocalTensorDataType::FP32 : RocalTensorDataType::FP16;
         context->master_graph->to_tensor(out_ptr, tensor_layout, multiplier0, multiplier1, multiplier2,
                                          offset0, offset1, offset2, reverse_channels, tensor_output_data_type, output_mem_type, max_roi_height, max_roi_width);
     } catch (const std::exception& e) {
@@ -119,3 +133,38 @@ rocalGetOutputTensors(RocalContext p_context) {
     }
     return nullptr;
 }
+
+RocalBorrowedOutput ROCAL_API_CALL
+rocalBorrowOutputTensors(RocalContext p_context) {
+    auto context = static_cast<Context*>(p_context);
+    try {
+        return context->master_graph->borrow_output_tensors();
+    } catch (const std::exception& e) {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return nullptr;
+    }
+    return nullptr;
+}
+
+RocalTensorList ROCAL_API_CALL
+rocalGetBorrowedTensors(RocalBorrowedOutput borrowed_output) {
+    if (!borrowed_output)
+        return nullptr;
+    return &static_cast<MasterGraph::BorrowedOutput*>(borrowed_output)->tensors;
+}
+
+int ROCAL_API_CALL
+rocalGetBorrowedDeviceId(RocalBorrowedOutput borrowed_output) {
+    if (!borrowed_output)
+        return -1;
+    return static_cast<MasterGraph::BorrowedOutput*>(borrowed_output)->device_id;
+}
+
+RocalStatus ROCAL_API_CALL
+rocalReleaseOutputTensors(RocalBorrowedOutput borrowed_output) {
+    if (!borrowed_output)
+        return ROCAL_INVALID_PARAMETER_TYPE;
+    delete static_cast<MasterGraph::BorrowedOutput*>(borrowed_output);
+    return ROCAL_OK;
+}
@@ -20,6 +20,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#include <algorithm>
+
 #include "pipeline/commons.h"
 #include "pipeline/context.h"
 #include "rocal_api.h"
@@ -39,6 +41,29 @@ size_t ROCAL_API_CALL rocalGetImagePlanes(RocalTensor p_image) {
     return image->info().get_channels();
 }
 
+//! Returns the largest width (dim 0) or height (dim 1) of the ROIs of the batch
+static size_t roi_max_dim(Tensor *image, unsigned dim) {
+    auto roi = image->info().roi().get_2D_roi();
+    size_t max_dim = 0;
+    for (unsigned i = 0; i < image->info().batch_size(); i++) {
+        size_t size;
+        if (image->info().roi_type() == RocalROIType::LTRB)
+            size = dim ? roi[i].ltrb.b - roi[i].ltrb.t + 1 : roi[i].ltrb.r - roi[i].ltrb.l + 1;
+        else
+            size = dim ? roi[i].xywh.h : roi[i].xywh.w;
+        max_dim = std::max(max_dim, size);
+    }
+    return std::min(max_dim, image->info().max_shape()[dim]);
+}
+
+size_t ROCAL_API_CALL rocalGetROIMaxWidth(RocalTensor p_image) {
+    return roi_max_dim(static_cast<Tensor *>(p_image), 0);
+}
+
+size_t ROCAL_API_CALL rocalGetROIMaxHeight(RocalTensor p_image) {
+    return roi_max_dim(static_cast<Tensor *>(p_image), 1);
+}
+
 int ROCAL_API_CALL rocalGetOutputWidth(RocalContext p_context) {
     auto context = static_cast<Context *>(p_context);
     return context->master_graph->output_width();
@@ -108,7 +133,7 @@ TimingInfo
     auto context = static_cast<Context *>(p_context);
     auto info = context->timing();
     // INFO("bbencode time "+ TOSTR(info.bb_process_time)); //to display time taken for bbox encoder
-    return {info.read_time, info.decode_time, info.process_time, info.copy_to_output};
+    return {info.read_time, info.decode_time, info.process_time, info.copy_to_output, info.decode_tail_time};
 }
 
 RocalMetaData
@@ -26,7 +26,10 @@ THE SOFTWARE.
 
 BrightnessNode::BrightnessNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) : Node(inputs, outputs),
                                                                                                             _alpha(ALPHA_RANGE[0], ALPHA_RANGE[1]),
-                                                                                                            _beta(BETA_RANGE[0], BETA_RANGE[1]) {}
+                                                                                                            _beta(BETA_RANGE[0], BETA_RANGE[1]) {
+    _alpha.set_identity(1.0f);
+    _beta.set_identity(0.0f);
+}
 
 void BrightnessNode::create_node() {
     if (_node)
@@ -61,3 +64,15 @@ void BrightnessNode::update_node() {
     _alpha.update_array();
     _beta.update_array();
 }
+
+void BrightnessNode::init_color_transforms() {
+    _alpha.create_host_array(_batch_size);
+    _beta.create_host_array(_batch_size);
+}
+
+void BrightnessNode::color_transforms(std::vector<ColorTransform> &transforms) {
+    auto alpha = _alpha.get_array();
+    auto beta = _beta.get_array();
+    for (size_t i = 0; i < _batch_size; i++)
+        transforms[i] = {alpha[i], beta[i]};
+}
@@ -28,7 +28,12 @@ ColorTwistNode::ColorTwistNode(const std::vector<Tensor *> &inputs, const std::v
                                                                                                             _alpha(ALPHA_RANGE[0], ALPHA_RANGE[1]),
                                                                                                             _beta(BETA_RANGE[0], BETA_RANGE[1]),
                                                                                                             _hue(HUE_RANGE[0], HUE_RANGE[1]),
-                                                                                                            _sat(SAT_RANGE[0], SAT_RANGE[1]) {}
+                                                                                                            _sat(SAT_RANGE[0], SAT_RANGE[1]) {
+    _alpha.set_identity(1.0f);
+    _beta.set_identity(0.0f);
+    _hue.set_identity(0.0f);
+    _sat.set_identity(1.0f);
+}
 
 void ColorTwistNode::create_node() {
     if (_node)
@@ -72,3 +77,19 @@ void ColorTwistNode::update_node() {
     _hue.update_array();
     _sat.update_array();
 }
+
+void ColorTwistNode::init_color_transforms() {
+    _alpha.create_host_array(_batch_size);
+    _beta.create_host_array(_batch_size);
+    _hue.create_host_array(_batch_size);
+    _sat.create_host_array(_batch_size);
+}
+
+void ColorTwistNode::color_transforms(std::vector<ColorTransform> &transforms) {
+    auto alpha = _alpha.get_array();
+    auto beta = _beta.get_array();
+    auto hue = _hue.get_array();
+    auto sat = _sat.get_array();
+    for (size_t i = 0; i < _batch_size; i++)
+        transforms[i] = {alpha[i], beta[i], hue[i], sat[i]};
+}
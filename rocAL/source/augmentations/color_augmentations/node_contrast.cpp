@@ -26,7 +26,9 @@ THE SOFTWARE.
 
 ContrastNode::ContrastNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) : Node(inputs, outputs),
                                                                                                         _factor(CONTRAST_FACTOR_RANGE[0], CONTRAST_FACTOR_RANGE[1]),
-                                                                                                        _center(CONTRAST_CENTER_RANGE[0], CONTRAST_CENTER_RANGE[1]) {}
+                                                                                                        _center(CONTRAST_CENTER_RANGE[0], CONTRAST_CENTER_RANGE[1]) {
+    _factor.set_identity(1.0f);
+}
 
 void ContrastNode::create_node() {
     if (_node)
@@ -61,3 +63,16 @@ void ContrastNode::update_node() {
     _factor.update_array();
     _center.update_array();
 }
+
+void ContrastNode::init_color_transforms() {
+    _factor.create_host_array(_batch_size);
+    _center.create_host_array(_batch_size);
+}
+
+void ContrastNode::color_transforms(std::vector<ColorTransform> &transforms) {
+    auto factor = _factor.get_array();
+    auto center = _center.get_array();
+    // (in - center) * factor + center
+    for (size_t i = 0; i < _batch_size; i++)
+        transforms[i] = {factor[i], center[i] * (1.0f - factor[i])};
+}
@@ -21,11 +21,14 @@ THE SOFTWARE.
 */
 
 #include <vx_ext_rpp.h>
+#include <cmath>
 #include "augmentations/color_augmentations/node_exposure.h"
 #include "pipeline/exception.h"
 
 ExposureNode::ExposureNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) : Node(inputs, outputs),
-                                                                                                        _exposure_factor(EXPOSURE_FACTOR_RANGE[0], EXPOSURE_FACTOR_RANGE[1]) {}
+                                                                                                        _exposure_factor(EXPOSURE_FACTOR_RANGE[0], EXPOSURE_FACTOR_RANGE[1]) {
+    _exposure_factor.set_identity(0.0f);
+}
 
 void ExposureNode::create_node() {
     if (_node)
@@ -56,3 +59,13 @@ void ExposureNode::init(FloatParam *exposure_factor_param) {
 void ExposureNode::update_node() {
     _exposure_factor.update_array();
 }
+
+void ExposureNode::init_color_transforms() {
+    _exposure_factor.create_host_array(_batch_size);
+}
+
+void ExposureNode::color_transforms(std::vector<ColorTransform> &transforms) {
+    auto exposure_factor = _exposure_factor.get_array();
+    for (size_t i = 0; i < _batch_size; i++)
+        transforms[i] = {std::exp2(exposure_factor[i])};
+}
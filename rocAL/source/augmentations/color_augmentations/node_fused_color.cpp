@@ -0,0 +1,112 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <vx_ext_rpp.h>
+#include <algorithm>
+#include "augmentations/color_augmentations/node_fused_color.h"
+#include "pipeline/exception.h"
+
+FusedColorNode::FusedColorNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) : Node(inputs, outputs) {}
+
+void FusedColorNode::init(const std::vector<std::shared_ptr<Node>> &chain) {
+    _chain = chain;
+    _stages.clear();
+    _hue_saturation = false;
+    for (auto &node : _chain) {
+        auto stage = dynamic_cast<PointwiseColorNode *>(node.get());
+        if (!stage)
+            THROW("Only pointwise color nodes can be fused")
+        stage->init_color_transforms();
+        _hue_saturation |= (stage->color_transform_parts() & PointwiseColorNode::HUE_SATURATION) != 0;
+        _stages.push_back(stage);
+    }
+    _stage_transforms.resize(_batch_size);
+    _transforms.resize(_batch_size);
+    _values.resize(_batch_size);
+}
+
+void FusedColorNode::compose_transforms() {
+    std::fill(_transforms.begin(), _transforms.end(), ColorTransform());
+    for (auto stage : _stages) {
+        stage->color_transforms(_stage_transforms);
+        for (size_t i = 0; i < _batch_size; i++)
+            _transforms[i] = _transforms[i].then(_stage_transforms[i]);
+    }
+}
+
+void FusedColorNode::write_arrays() {
+    auto write = [this](vx_array array, float ColorTransform::*field) {
+        if (!array)
+            return;
+        for (size_t i = 0; i < _batch_size; i++)
+            _values[i] = _transforms[i].*field;
+        vx_status status = vxCopyArrayRange(array, 0, _batch_size, sizeof(float), _values.data(), VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST);
+        if (status != 0)
+            THROW("vxCopyArrayRange failed in the fused color node: " + TOSTR(status))
+    };
+    write(_alpha, &ColorTransform::alpha);
+    write(_beta, &ColorTransform::beta);
+    write(_hue, &ColorTransform::hue);
+    write(_sat, &ColorTransform::saturation);
+}
+
+void FusedColorNode::create_node() {
+    if (_node)
+        return;
+    if (_stages.empty())
+        THROW("The fused color node has no nodes to apply")
+
+    auto create_array = [this]() {
+        vx_array array = vxCreateArray(vxGetContext((vx_reference)_graph->get()), VX_TYPE_FLOAT32, _batch_size);
+        vx_status status = vxAddArrayItems(array, _batch_size, _values.data(), sizeof(float));
+        if (status != 0)
+            THROW("vxAddArrayItems failed in the fused color node: " + TOSTR(status))
+        return array;
+    };
+    _alpha = create_array();
+    _beta = create_array();
+    _hue = _hue_saturation ? create_array() : nullptr;
+    _sat = _hue_saturation ? create_array() : nullptr;
+    compose_transforms();
+    write_arrays();
+
+    int input_layout = static_cast<int>(_inputs[0]->info().layout());
+    int output_layout = static_cast<int>(_outputs[0]->info().layout());
+    int roi_type = static_cast<int>(_inputs[0]->info().roi_type());
+    vx_scalar input_layout_vx = vxCreateScalar(vxGetContext((vx_reference)_graph->get()), VX_TYPE_INT32, &input_layout);
+    vx_scalar output_layout_vx = vxCreateScalar(vxGetContext((vx_reference)_graph->get()), VX_TYPE_INT32, &output_layout);
+    vx_scalar roi_type_vx = vxCreateScalar(vxGetContext((vx_reference)_graph->get()), VX_TYPE_INT32, &roi_type);
+
+    if (_hue_saturation)
+        _node = vxExtRppColorTwist(_graph->get(), _inputs[0]->handle(), _inputs[0]->get_roi_tensor(), _outputs[0]->handle(), _alpha,
+                                   _beta, _hue, _sat, input_layout_vx, output_layout_vx, roi_type_vx);
+    else
+        _node = vxExtRppBrightness(_graph->get(), _inputs[0]->handle(), _inputs[0]->get_roi_tensor(), _outputs[0]->handle(), _alpha, _beta, input_layout_vx, output_layout_vx, roi_type_vx);
+    vx_status status;
+    if ((status = vxGetStatus((vx_reference)_node)) != VX_SUCCESS)
+        THROW("Adding the fused color (" + STR(_hue_saturation ? "vxExtRppColorTwist" : "vxExtRppBrightness") + ") node failed: " + TOSTR(status))
+}
+
+void FusedColorNode::update_node() {
+    compose_transforms();
+    write_arrays();
+}
@@ -25,7 +25,9 @@ THE SOFTWARE.
 #include "pipeline/exception.h"
 
 GammaNode::GammaNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) : Node(inputs, outputs),
-                                                                                                  _gamma(GAMMA_RANGE[0], GAMMA_RANGE[1]) {}
+                                                                                                  _gamma(GAMMA_RANGE[0], GAMMA_RANGE[1]) {
+    _gamma.set_identity(1.0f);
+}
 
 void GammaNode::create_node() {
     if (_node)
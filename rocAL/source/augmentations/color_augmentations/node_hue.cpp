@@ -25,7 +25,9 @@ THE SOFTWARE.
 #include "pipeline/exception.h"
 
 HueNode::HueNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) : Node(inputs, outputs),
-                                                                                              _hue(HUE_RANGE[0], HUE_RANGE[1]) {}
+                                                                                              _hue(HUE_RANGE[0], HUE_RANGE[1]) {
+    _hue.set_identity(0.0f);
+}
 
 void HueNode::create_node() {
     if (_node)
@@ -56,3 +58,13 @@ void HueNode::init(FloatParam *hue) {
 void HueNode::update_node() {
     _hue.update_array();
 }
+
+void HueNode::init_color_transforms() {
+    _hue.create_host_array(_batch_size);
+}
+
+void HueNode::color_transforms(std::vector<ColorTransform> &transforms) {
+    auto hue = _hue.get_array();
+    for (size_t i = 0; i < _batch_size; i++)
+        transforms[i] = {1.0f, 0.0f, hue[i]};
+}
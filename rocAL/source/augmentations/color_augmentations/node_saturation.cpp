@@ -25,7 +25,9 @@ THE SOFTWARE.
 #include "pipeline/exception.h"
 
 SaturationNode::SaturationNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) : Node(inputs, outputs),
-                                                                                                            _saturation(SAT_RANGE[0], SAT_RANGE[1]) {}
+                                                                                                            _saturation(SAT_RANGE[0], SAT_RANGE[1]) {
+    _saturation.set_identity(1.0f);
+}
 
 void SaturationNode::create_node() {
     if (_node)
@@ -56,3 +58,13 @@ void SaturationNode::init(FloatParam *saturation_param) {
 void SaturationNode::update_node() {
     _saturation.update_array();
 }
+
+void SaturationNode::init_color_transforms() {
+    _saturation.create_host_array(_batch_size);
+}
+
+void SaturationNode::color_transforms(std::vector<ColorTransform> &transforms) {
+    auto saturation = _saturation.get_array();
+    for (size_t i = 0; i < _batch_size; i++)
+        transforms[i] = {1.0f, 0.0f, 0.0f, saturation[i]};
+}
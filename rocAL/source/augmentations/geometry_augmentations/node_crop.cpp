@@ -118,6 +118,13 @@ void CropNode::create_crop_tensor() {
         THROW("Error: vxCreateTensorFromHandle(_crop_tensor: failed " + TOSTR(status))
 }
 
+void CropNode::detach_replica_state() {
+    // The crop coordinates and their tensor are allocated again when the replica is created
+    _crop_coordinates = nullptr;
+    _crop_tensor = nullptr;
+    _crop_param = std::make_shared<RocalCropParam>(*_crop_param);
+}
+
 CropNode::~CropNode() {
     if (_inputs[0]->info().mem_type() == RocalMemType::HIP) {
 #if ENABLE_HIP
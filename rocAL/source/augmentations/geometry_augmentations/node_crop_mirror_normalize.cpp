@@ -120,4 +120,9 @@ void CropMirrorNormalizeNode::init(int crop_h, int crop_w, float anchor_x, float
     _mean = mean;
     _std_dev = std_dev;
     _mirror.set_param(core(mirror));
-}
\ No newline at end of file
+}
+
+void CropMirrorNormalizeNode::detach_replica_state() {
+    CropNode::detach_replica_state();
+    _crop_param = std::make_shared<RocalCropParam>(*_crop_param);
+}
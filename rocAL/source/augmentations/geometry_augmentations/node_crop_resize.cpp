@@ -93,3 +93,8 @@ void CropResizeNode::init(FloatParam *area, FloatParam *aspect_ratio, FloatParam
     _crop_param->set_x_drift_factor(core(x_center_drift));
     _crop_param->set_y_drift_factor(core(y_center_drift));
 }
+
+void CropResizeNode::detach_replica_state() {
+    CropNode::detach_replica_state();
+    _crop_param = std::make_shared<RocalRandomCropParam>(*_crop_param);
+}
@@ -26,7 +26,10 @@ THE SOFTWARE.
 
 FlipNode::FlipNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) : Node(inputs, outputs),
                                                                                                 _horizontal(HORIZONTAL_RANGE[0], HORIZONTAL_RANGE[1]),
-                                                                                                _vertical(VERTICAL_RANGE[0], VERTICAL_RANGE[1]) {}
+                                                                                                _vertical(VERTICAL_RANGE[0], VERTICAL_RANGE[1]) {
+    _horizontal.set_identity(0);
+    _vertical.set_identity(0);
+}
 
 void FlipNode::create_node() {
     if (_node)
@@ -77,3 +77,8 @@ void RandomCropNode::init(FloatParam *crop_area_factor, FloatParam *crop_aspect_
     _crop_param->set_aspect_ratio(core(crop_aspect_ratio));
     _num_of_attempts = num_of_attempts;
 }
+
+void RandomCropNode::detach_replica_state() {
+    CropNode::detach_replica_state();
+    _crop_param = std::make_shared<RocalRandomCropParam>(*_crop_param);
+}
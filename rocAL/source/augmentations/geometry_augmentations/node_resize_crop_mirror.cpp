@@ -99,3 +99,8 @@ void ResizeCropMirrorNode::init(FloatParam *crop_h_factor, FloatParam *crop_w_fa
     _mirror.set_param(core(mirror));
     _interpolation_type = static_cast<int>(interpolation_type);
 }
+
+void ResizeCropMirrorNode::detach_replica_state() {
+    CropNode::detach_replica_state();
+    _crop_param = std::make_shared<RocalCropParam>(*_crop_param);
+}
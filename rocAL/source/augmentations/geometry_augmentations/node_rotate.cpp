@@ -25,7 +25,9 @@ THE SOFTWARE.
 #include "pipeline/exception.h"
 
 RotateNode::RotateNode(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs) : Node(inputs, outputs),
-                                                                                                    _angle(ROTATE_ANGLE_RANGE[0], ROTATE_ANGLE_RANGE[1]) {}
+                                                                                                    _angle(ROTATE_ANGLE_RANGE[0], ROTATE_ANGLE_RANGE[1]) {
+    _angle.set_identity(0.0f);
+}
 
 void RotateNode::create_node() {
     if (_node)
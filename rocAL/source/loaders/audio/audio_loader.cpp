@@ -118,6 +118,7 @@ void AudioLoader::initialize(ReaderConfig reader_cfg, DecoderConfig decoder_cfg,
     _mem_type = mem_type;
     _batch_size = batch_size;
     _loop = reader_cfg.loop();
+    reader_cfg.set_task_priority(_task_priority);
     _audio_loader = std::make_shared<AudioReadAndDecode>();
     size_t shard_count = reader_cfg.get_shard_count();
     int device_id = reader_cfg.get_shard_id();
@@ -138,6 +139,7 @@ void AudioLoader::initialize(ReaderConfig reader_cfg, DecoderConfig decoder_cfg,
     _decoded_audio_info._audio_samples.resize(_batch_size);
     _decoded_audio_info._audio_channels.resize(_batch_size);
     _decoded_audio_info._audio_sample_rates.resize(_batch_size);
+    _circ_buff.set_numa_placement(_numa_placement);
     _circ_buff.init(_mem_type, _output_mem_size, _prefetch_queue_depth);
     _is_initialized = true;
     LOG("Loader module initialized");
@@ -154,6 +156,7 @@ void AudioLoader::start_loading() {
 
 LoaderModuleStatus
 AudioLoader::load_routine() {
+    _numa_placement.bind_current_thread();
     LOG("Started the internal loader thread");
     LoaderModuleStatus last_load_status = LoaderModuleStatus::OK;
     // Initially record number of all the audios that are going to be loaded, this is used to know how many still there
@@ -82,6 +82,8 @@ void AudioLoaderSharded::initialize(ReaderConfig reader_cfg, DecoderConfig decod
     for (size_t i = 0; i < _shard_count; i++) {
         std::shared_ptr loader = std::make_shared<AudioLoader>(_dev_resources);
         loader->set_prefetch_queue_depth(_prefetch_queue_depth);
+        loader->set_task_priority(_task_priority);
+        loader->set_numa_placement(_numa_placement);
         _loaders.push_back(loader);
     }
     // Initialize loader modules
@@ -105,14 +107,6 @@ void AudioLoaderSharded::start_loading() {
         struct sched_param params;
         params.sched_priority = sched_get_priority_max(SCHED_FIFO);
         _loaders[i]->set_cpu_sched_policy(params);
-#endif
-        // Setting cpu affinity for threads works and can be activated below for experimentation
-#if 0
-        // Set thread affinity thread 0 to core 0 , 1 toc core 1 , ...
-        cpu_set_t cpuset;
-        CPU_ZERO(&cpuset);
-        CPU_SET(i, &cpuset);
-        _loaders[i]->set_cpu_affinity(cpuset);
 #endif
     }
 }
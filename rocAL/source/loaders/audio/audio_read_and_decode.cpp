@@ -60,6 +60,7 @@ void AudioReadAndDecode::Create(ReaderConfig reader_config, DecoderConfig decode
         }
     }
     _num_threads = reader_config.get_cpu_num_threads();
+    _task_priority = reader_config.task_priority();
     _reader = create_reader(reader_config);
 }
 
@@ -110,8 +111,7 @@ AudioReadAndDecode::Load(float *audio_buffer,
         for (size_t i = 0; i < _batch_size; i++) {
             _decompressed_buff_ptrs[i] = audio_buffer + (audio_size * i);
         }
-#pragma omp parallel for num_threads(_num_threads)  // default(none) TBD: option disabled in Ubuntu 20.04
-        for (size_t i = 0; i < _batch_size; i++) {
+        TaskScheduler::instance().parallel_for(_batch_size, _num_threads, _task_priority, [&](size_t i, size_t) {
             int original_samples, original_channels;
             float original_sample_rate;
             if (_decoder[i]->Initialize(_audio_meta_info[i].file_path.c_str()) != AudioDecoder::Status::OK) {
@@ -127,7 +127,7 @@ AudioReadAndDecode::Load(float *audio_buffer,
                 THROW("Decoder failed for file: " + _audio_meta_info[i].file_name.c_str())
             }
             _decoder[i]->Release();
-        }
+        });
         for (size_t i = 0; i < _batch_size; i++) {
             audio_info._data_names[i] = _audio_meta_info[i].file_name;
             audio_info._audio_samples[i] = _audio_meta_info[i].samples;
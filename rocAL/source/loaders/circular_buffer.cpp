@@ -20,6 +20,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <chrono>
+
 #include "loaders/circular_buffer.h"
 
 #include "pipeline/log.h"
@@ -40,6 +43,7 @@ void CircularBuffer::reset() {
     _write_ptr = 0;
     _read_ptr = 0;
     _level = 0;
+    _writer_released = false;
     while (!_circ_buff_data_info.empty())
         _circ_buff_data_info.pop();
     if (random_bbox_crop_flag == true) {
@@ -58,8 +62,12 @@ void CircularBuffer::unblock_reader() {
 void CircularBuffer::unblock_writer() {
     if (!_initialized)
         return;
-    // Wake up the writer thread in case it's waiting for an unload
-    _wait_for_unload.notify_one();
+    // Wake up the writer thread in case it's waiting for an unload, it returns without a free buffer
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _writer_released = true;
+    }
+    _wait_for_unload.notify_all();
 }
 
 void *CircularBuffer::get_read_buffer_dev() {
@@ -151,8 +159,11 @@ void CircularBuffer::pop() {
     if (random_bbox_crop_flag == true)
         _circ_crop_image_info.pop();
 }
-void CircularBuffer::init(RocalMemType output_mem_type, size_t output_mem_size, size_t buffer_depth) {
-    _buff_depth = buffer_depth;
+void CircularBuffer::init(RocalMemType output_mem_type, size_t output_mem_size, size_t buffer_depth, size_t reader_slots) {
+    // Each extra batch processed concurrently holds one more buffer, the prefetch depth stays the same
+    _reader_slots = std::max(reader_slots, static_cast<size_t>(1));
+    _buff_depth = std::max(buffer_depth, _max_buff_depth) + _reader_slots - 1;
+    _active_depth = buffer_depth + _reader_slots - 1;
     _dev_buffer.reserve(_buff_depth);
     _host_buffer_ptrs.reserve(_buff_depth);
     for (size_t bufIdx = 0; bufIdx < _buff_depth; bufIdx++)
@@ -161,8 +172,9 @@ void CircularBuffer::init(RocalMemType output_mem_type, size_t output_mem_size,
         return;
     _output_mem_type = output_mem_type;
     _output_mem_size = output_mem_size;
-    if (_buff_depth < 2)
+    if (buffer_depth < MIN_BUFF_DEPTH)
         THROW("Error internal buffer size for the circular buffer should be greater than one")
+    size_t alignment = _numa_placement.buffer_alignment(MEM_ALIGNMENT);
 
         // Allocating buffers
 #if ENABLE_OPENCL
@@ -196,8 +208,9 @@ void CircularBuffer::init(RocalMemType output_mem_type, size_t output_mem_size,
         }
     } else {
         for (size_t buffIdx = 0; buffIdx < _buff_depth; buffIdx++) {
-            // a minimum of extra MEM_ALIGNMENT is allocated
-            _host_buffer_ptrs[buffIdx] = (unsigned char *)aligned_alloc(MEM_ALIGNMENT, MEM_ALIGNMENT * (_output_mem_size / MEM_ALIGNMENT + 1));
+            // a minimum of extra alignment is allocated, whole pages when the buffers are bound to a NUMA node
+            _host_buffer_ptrs[buffIdx] = (unsigned char *)aligned_alloc(alignment, alignment * (_output_mem_size / alignment + 1));
+            _numa_placement.place_memory(_host_buffer_ptrs[buffIdx], _output_mem_size);
         }
     }
 #elif ENABLE_HIP
@@ -205,8 +218,13 @@ void CircularBuffer::init(RocalMemType output_mem_type, size_t output_mem_size,
             if (!_hip_stream || _hip_device_id == -1)
                 THROW("Error HIP device resource is not initialized");
 
+            // Pinned memory cannot be moved once allocated, it follows the memory policy of the thread allocating it instead
+            // The caller's policy is given back right after each allocation, before anything can throw
+            auto thread_memory_policy = NumaPlacement::thread_memory_policy();
             for (size_t buffIdx = 0; buffIdx < _buff_depth; buffIdx++) {
-                hipError_t err = hipHostMalloc((void **)&_host_buffer_ptrs[buffIdx], _output_mem_size, hipHostMallocDefault /*hipHostMallocMapped|hipHostMallocWriteCombined*/);
+                _numa_placement.set_thread_memory_policy();
+                hipError_t err = hipHostMalloc((void **)&_host_buffer_ptrs[buffIdx], _output_mem_size, _numa_placement.bound() ? hipHostMallocNumaUser : hipHostMallocDefault /*hipHostMallocMapped|hipHostMallocWriteCombined*/);
+                NumaPlacement::restore_thread_memory_policy(thread_memory_policy);
                 if (err != hipSuccess || !_host_buffer_ptrs[buffIdx]) {
                     THROW("hipHostMalloc of size " + TOSTR(_output_mem_size) + " failed " + TOSTR(err));
                 }
@@ -225,16 +243,24 @@ void CircularBuffer::init(RocalMemType output_mem_type, size_t output_mem_size,
             }
         } else {
             for (size_t buffIdx = 0; buffIdx < _buff_depth; buffIdx++) {
-                // a minimum of extra MEM_ALIGNMENT is allocated
-                _host_buffer_ptrs[buffIdx] = (unsigned char *)aligned_alloc(MEM_ALIGNMENT, MEM_ALIGNMENT * (_output_mem_size / MEM_ALIGNMENT + 1));
+                // a minimum of extra alignment is allocated, whole pages when the buffers are bound to a NUMA node
+                _host_buffer_ptrs[buffIdx] = (unsigned char *)aligned_alloc(alignment, alignment * (_output_mem_size / alignment + 1));
+                _numa_placement.place_memory(_host_buffer_ptrs[buffIdx], _output_mem_size);
             }
         }
 #else
     for (size_t buffIdx = 0; buffIdx < _buff_depth; buffIdx++) {
-        // a minimum of extra MEM_ALIGNMENT is allocated
-        _host_buffer_ptrs[buffIdx] = (unsigned char*)aligned_alloc(MEM_ALIGNMENT, MEM_ALIGNMENT * (_output_mem_size / MEM_ALIGNMENT + 1));
+        // a minimum of extra alignment is allocated, whole pages when the buffers are bound to a NUMA node
+        _host_buffer_ptrs[buffIdx] = (unsigned char *)aligned_alloc(alignment, alignment * (_output_mem_size / alignment + 1));
+        _numa_placement.place_memory(_host_buffer_ptrs[buffIdx], _output_mem_size);
     }
 #endif
+    if (_numa_placement.bound()) {
+        std::map<int, size_t> pages_per_node;
+        for (size_t buffIdx = 0; buffIdx < _buff_depth; buffIdx++)
+            NumaPlacement::count_pages(_host_buffer_ptrs[buffIdx], _output_mem_size, pages_per_node);
+        INFO("Loader buffers bound to " + _numa_placement.description() + ", " + NumaPlacement::describe_pages(pages_per_node))
+    }
     _initialized = true;
 }
 
@@ -294,7 +320,17 @@ bool CircularBuffer::empty() {
 }
 
 bool CircularBuffer::full() {
-    return (_level >= _buff_depth - 1);
+    return (_level >= _active_depth - _reader_slots);
+}
+
+size_t CircularBuffer::set_depth(size_t buff_depth) {
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        // The ring keeps cycling over all the allocated buffers, only the number of them holding loaded batches is limited
+        _active_depth = std::min(std::max(buff_depth, MIN_BUFF_DEPTH) + _reader_slots - 1, _buff_depth);
+    }
+    _wait_for_unload.notify_all();
+    return _active_depth - _reader_slots + 1;
 }
 
 size_t CircularBuffer::level() {
@@ -322,16 +358,22 @@ void CircularBuffer::increment_write_ptr() {
 void CircularBuffer::block_if_empty() {
     std::unique_lock<std::mutex> lock(_lock);
     if (empty()) {  // if the current read buffer is being written wait on it
+        auto wait_start = std::chrono::steady_clock::now();
         _wait_for_load.wait(lock);
+        _reader_wait_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - wait_start).count();
     }
 }
 
 void CircularBuffer::block_if_full() {
     std::unique_lock<std::mutex> lock(_lock);
-    // Write the whole buffer except for the last spot which is being read by the reader thread
+    // Write the whole buffer except for the last spots which are being read by the reader thread
     if (full()) {
-        _wait_for_unload.wait(lock);
+        auto wait_start = std::chrono::steady_clock::now();
+        // set_depth() wakes the writer up too, it only goes on once a buffer is free or unblock_writer() is called
+        _wait_for_unload.wait(lock, [this] { return !full() || _writer_released; });
+        _writer_wait_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - wait_start).count();
     }
+    _writer_released = false;
 }
 
 CircularBuffer::~CircularBuffer() {
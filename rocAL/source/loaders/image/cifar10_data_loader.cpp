@@ -125,7 +125,8 @@ void CIFAR10DataLoader::initialize(ReaderConfig reader_cfg, DecoderConfig decode
     _decoded_data_info._original_height.resize(_batch_size);
     _decoded_data_info._original_width.resize(_batch_size);
     _crop_image_info._crop_image_coords.resize(_batch_size);
-    _circ_buff.init(_mem_type, _output_mem_size, _prefetch_queue_depth);
+    _circ_buff.set_numa_placement(_numa_placement);
+    _circ_buff.init(_mem_type, _output_mem_size, _prefetch_queue_depth, _in_flight_batch_count);
     _is_initialized = true;
     LOG("Loader module initialized");
 }
@@ -158,6 +159,7 @@ void CIFAR10DataLoader::start_loading() {
 
 LoaderModuleStatus
 CIFAR10DataLoader::load_routine() {
+    _numa_placement.bind_current_thread();
     LOG("Started the internal loader thread");
     LoaderModuleStatus last_load_status = LoaderModuleStatus::OK;
     // Initially record number of all the images that are going to be loaded, this is used to know how many still there
@@ -75,22 +75,67 @@ ImageLoader::remaining_count() {
 }
 
 void ImageLoader::reset() {
-    // stop the writer thread and empty the internal circular buffer
-    _internal_thread_running = false;
-    _circ_buff.unblock_writer();
-
-    if (_load_thread.joinable())
-        _load_thread.join();
+    if (_continuous_epochs && is_out_of_data()) {
+        // The load thread has already rewound the reader and is loading the next epoch, only the count is started over
+        _remaining_image_count = _epoch_image_count;
+        return;
+    }
+    if (!_internal_thread_running) {
+        _circ_buff.reset();
+        _image_counter = 0;
+        _image_loader->reset();
+        start_loading();
+        return;
+    }
+    // Park the load thread, it's woken up from wherever it waits until it acknowledges the request
+    {
+        std::unique_lock<std::mutex> lock(_rewind_lock);
+        _rewind_requested = true;
+        _rewind_cond.notify_all();
+        while (!_load_thread_parked && _internal_thread_running) {
+            _circ_buff.unblock_writer();
+            _rewind_cond.wait_for(lock, std::chrono::milliseconds(10));
+        }
+    }
 
-    // Emptying the internal circular buffer
+    // Emptying the internal circular buffer and rewinding the reader to the start of the media in place
     _circ_buff.reset();
-
-    // resetting the reader thread to the start of the media
     _image_counter = 0;
     _image_loader->reset();
+    _remaining_image_count = _epoch_image_count = _image_loader->count();
 
-    // Start loading (writer thread) again
-    start_loading();
+    {
+        std::unique_lock<std::mutex> lock(_rewind_lock);
+        _rewind_requested = false;
+    }
+    _rewind_cond.notify_all();
+}
+
+void ImageLoader::set_continuous_epochs(bool continuous) {
+    {
+        std::unique_lock<std::mutex> lock(_rewind_lock);
+        _continuous_epochs = continuous;
+    }
+    // Wakes up the load thread if it's already waiting at the end of the data
+    _rewind_cond.notify_all();
+}
+
+void ImageLoader::park_until_rewound() {
+    std::unique_lock<std::mutex> lock(_rewind_lock);
+    _load_thread_parked = true;
+    _rewind_cond.notify_all();
+    _rewind_cond.wait(lock, [this] { return !_rewind_requested || !_internal_thread_running; });
+    _load_thread_parked = false;
+}
+
+void ImageLoader::wait_for_rewind() {
+    std::unique_lock<std::mutex> lock(_rewind_lock);
+    _rewind_cond.wait(lock, [this] { return _rewind_requested || _continuous_epochs || !_internal_thread_running; });
+}
+
+void ImageLoader::wait_for_input(size_t feed_count) {
+    std::unique_lock<std::mutex> lock(_rewind_lock);
+    _rewind_cond.wait(lock, [this, feed_count] { return _external_feed_count != feed_count || _rewind_requested || !_internal_thread_running; });
 }
 
 void ImageLoader::de_init() {
@@ -117,7 +162,11 @@ void ImageLoader::set_random_bbox_data_reader(std::shared_ptr<RandomBBoxCrop_Met
 }
 
 void ImageLoader::stop_internal_thread() {
-    _internal_thread_running = false;
+    {
+        std::unique_lock<std::mutex> lock(_rewind_lock);
+        _internal_thread_running = false;
+    }
+    _rewind_cond.notify_all();
     _stopped = true;
     _circ_buff.unblock_reader();
     _circ_buff.unblock_writer();
@@ -136,6 +185,10 @@ void ImageLoader::initialize(ReaderConfig reader_cfg, DecoderConfig decoder_cfg,
     _mem_type = mem_type;
     _batch_size = batch_size;
     _loop = reader_cfg.loop();
+    reader_cfg.set_file_read_mode(_file_read_mode);
+    reader_cfg.set_manifest_dir(_manifest_dir);
+    reader_cfg.set_size_bucketing(_size_bucketing_pool_batch_count);
+    reader_cfg.set_task_priority(_task_priority);
     _decoder_keep_original = decoder_keep_original;
     _image_loader = std::make_shared<ImageReadAndDecode>();
     size_t shard_count = reader_cfg.get_shard_count();
@@ -158,7 +211,10 @@ void ImageLoader::initialize(ReaderConfig reader_cfg, DecoderConfig decoder_cfg,
     _decoded_data_info._original_height.resize(_batch_size);
     _decoded_data_info._original_width.resize(_batch_size);
     _crop_image_info._crop_image_coords.resize(_batch_size);
-    _circ_buff.init(_mem_type, _output_mem_size, _prefetch_queue_depth);
+    _circ_buff.set_numa_placement(_numa_placement);
+    if (_prefetch_memory_cap > 0)
+        _circ_buff.reserve_depth(std::min(_prefetch_memory_cap / _output_mem_size, MAX_PREFETCH_QUEUE_DEPTH));
+    _circ_buff.init(_mem_type, _output_mem_size, _prefetch_queue_depth, _in_flight_batch_count);
     _is_initialized = true;
     _image_loader->set_random_bbox_data_reader(_randombboxcrop_meta_data_reader);
     LOG("Loader module initialized");
@@ -168,21 +224,30 @@ void ImageLoader::start_loading() {
     if (!_is_initialized)
         THROW("start_loading() should be called after initialize() function is called")
 
-    _remaining_image_count = _image_loader->count();
+    _remaining_image_count = _epoch_image_count = _image_loader->count();
     _internal_thread_running = true;
     _load_thread = std::thread(&ImageLoader::load_routine, this);
 }
 
 LoaderModuleStatus
 ImageLoader::load_routine() {
+    _numa_placement.bind_current_thread();
     LOG("Started the internal loader thread");
     LoaderModuleStatus last_load_status = LoaderModuleStatus::OK;
     // Initially record number of all the images that are going to be loaded, this is used to know how many still there
 
     while (_internal_thread_running) {
+        if (_rewind_requested) {
+            park_until_rewound();
+            continue;
+        }
         auto data = _circ_buff.get_write_buffer();
         if (!_internal_thread_running)
             break;
+        if (_rewind_requested)
+            continue;
+        // Taken before the load, so that data fed while it fails to find any is not waited for
+        size_t feed_count = _external_feed_count;
 
         auto load_status = LoaderModuleStatus::NO_MORE_DATA_TO_READ;
         {
@@ -197,6 +262,7 @@ ImageLoader::load_routine() {
                                               _output_tensor->info().color_format(), _decoder_keep_original);
 
             if (load_status == LoaderModuleStatus::OK) {
+                _decoded_data_info._data_indices = _image_loader->sample_indices();
                 if (_randombboxcrop_meta_data_reader) {
                     _crop_image_info._crop_image_coords = _image_loader->get_batch_random_bbox_crop_coords();
                     _circ_buff.set_crop_image_info(_crop_image_info);
@@ -217,14 +283,25 @@ ImageLoader::load_routine() {
                 last_load_status = load_status;
             }
 
-            // Here it sets the out-of-data flag and signal the circular buffer's internal
-            // read semaphore using release() call
-            // , and calls the release() allows the reader thread to wake up and handle
-            // the out-of-data case properly
-            // It also slows down the reader thread since there is no more data to read,
-            // till program ends or till reset is called
-            _circ_buff.unblock_reader();
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            if (load_status == LoaderModuleStatus::NO_MORE_DATA_TO_READ && !_loop && !_external_source_reader) {
+                // Sleeps until reset() rewinds the reader or the program ends. In the continuous epochs mode the
+                // reader is rewound right away and the next epoch is loaded while the user drains the current one,
+                // the reader thread is not woken up then since it may already be waiting for the next epoch's data
+                if (!_continuous_epochs) {
+                    _circ_buff.unblock_reader();
+                    wait_for_rewind();
+                }
+                if (_continuous_epochs && !_rewind_requested && _internal_thread_running) {
+                    _image_loader->reset();
+                    _image_counter = 0;
+                    last_load_status = LoaderModuleStatus::OK;
+                }
+            } else {
+                // Wakes the reader thread up to handle the out-of-data case, then sleeps until more data is fed to the
+                // external source, reset() rewinds the reader or the program ends, a retry before that would fail the same way
+                _circ_buff.unblock_reader();
+                wait_for_input(feed_count);
+            }
         }
     }
     return LoaderModuleStatus::OK;
@@ -324,4 +401,10 @@ void ImageLoader::feed_external_input(const std::vector<std::string>& input_imag
     _external_source_reader = true;
     _external_input_eos = eos;
     _image_loader->feed_external_input(input_images_names, input_buffer, roi_xywh, max_width, max_height, channels, mode, eos);
+    // Wakes the load thread up if it's waiting for data
+    {
+        std::unique_lock<std::mutex> lock(_rewind_lock);
+        _external_feed_count++;
+    }
+    _rewind_cond.notify_all();
 }
@@ -80,6 +80,13 @@ void ImageLoaderSharded::initialize(ReaderConfig reader_cfg, DecoderConfig decod
     for (size_t i = 0; i < _shard_count; i++) {
         std::shared_ptr loader = std::make_shared<ImageLoader>(_dev_resources);
         loader->set_prefetch_queue_depth(_prefetch_queue_depth);
+        loader->set_file_read_mode(_file_read_mode);
+        loader->set_dataset_manifest_dir(_manifest_dir);
+        loader->set_size_bucketing(_size_bucketing_pool_batch_count);
+        loader->set_in_flight_batch_count(_in_flight_batch_count);
+        loader->set_task_priority(_task_priority);
+        loader->set_numa_placement(_numa_placement);
+        loader->set_prefetch_memory_cap(_prefetch_memory_cap / _shard_count);
         _loaders.push_back(loader);
     }
     // Initialize loader modules
@@ -103,14 +110,6 @@ void ImageLoaderSharded::start_loading() {
         struct sched_param params;
         params.sched_priority = sched_get_priority_max(SCHED_FIFO);
         _loaders[i]->set_cpu_sched_policy(params);
-#endif
-        // Setting cpu affinity for threads works and can be activated below for experimentation
-#if 0
-        // Set thread affinity thread 0 to core 0 , 1 toc core 1 , ...
-        cpu_set_t cpuset;
-        CPU_ZERO(&cpuset);
-        CPU_SET(i, &cpuset);
-        _loaders[i]->set_cpu_affinity(cpuset);
 #endif
     }
 }
@@ -138,6 +137,35 @@ void ImageLoaderSharded::reset() {
     for (auto& loader : _loaders)
         loader->reset();
 }
+void ImageLoaderSharded::set_continuous_epochs(bool continuous) {
+    for (auto& loader : _loaders)
+        loader->set_continuous_epochs(continuous);
+}
+size_t ImageLoaderSharded::resize_prefetch_queue(size_t depth) {
+    size_t applied_depth = depth;
+    for (auto& loader : _loaders)
+        applied_depth = std::min(applied_depth, loader->resize_prefetch_queue(depth));
+    return applied_depth;
+}
+
+void ImageLoaderSharded::set_decode_thread_count(size_t count) {
+    for (auto& loader : _loaders)
+        loader->set_decode_thread_count(count);
+}
+
+BufferStallTime ImageLoaderSharded::prefetch_stall_time() {
+    // The shards are read one after the other so the reader waits add up, their load threads run concurrently so the writer waits are averaged
+    BufferStallTime stall_time;
+    for (auto& loader : _loaders) {
+        auto loader_stall_time = loader->prefetch_stall_time();
+        stall_time.reader_wait += loader_stall_time.reader_wait;
+        stall_time.writer_wait += loader_stall_time.writer_wait;
+    }
+    if (!_loaders.empty())
+        stall_time.writer_wait /= _loaders.size();
+    return stall_time;
+}
+
 void ImageLoaderSharded::increment_loader_idx() {
     _loader_idx = (_loader_idx + 1) % _shard_count;
 }
@@ -146,6 +174,7 @@ Timing ImageLoaderSharded::timing() {
     Timing t;
     long long unsigned max_decode_time = 0;
     long long unsigned max_read_time = 0;
+    long long unsigned max_decode_tail_time = 0;
     long long unsigned swap_handle_time = 0;
 
     // image read and decode runs in parallel using multiple loaders, and the observable latency that the ImageLoaderSharded user
@@ -154,9 +183,11 @@ Timing ImageLoaderSharded::timing() {
         auto info = loader->timing();
         max_read_time = (info.read_time > max_read_time) ? info.read_time : max_read_time;
         max_decode_time = (info.decode_time > max_decode_time) ? info.decode_time : max_decode_time;
+        max_decode_tail_time = (info.decode_tail_time > max_decode_tail_time) ? info.decode_tail_time : max_decode_tail_time;
         swap_handle_time += info.process_time;
     }
     t.decode_time = max_decode_time;
+    t.decode_tail_time = max_decode_tail_time;
     t.read_time = max_read_time;
     t.process_time = swap_handle_time;
     return t;
@@ -22,11 +22,15 @@ THE SOFTWARE.
 
 #include "loaders/image/image_read_and_decode.h"
 
+
+#include <algorithm>
 #include <cstring>
 #include <iterator>
+#include <numeric>
 
 #include "decoders/image/decoder_factory.h"
 #include "readers/image/external_source_reader.h"
+#include "readers/size_bucketing_reader.h"
 
 std::tuple<Decoder::ColorFormat, unsigned>
 interpret_color_format(RocalColorFormat color_format) {
@@ -50,14 +54,18 @@ ImageReadAndDecode::timing() {
     Timing t;
     t.decode_time = _decode_time.get_timing();
     t.read_time = _file_load_time.get_timing();
+    t.decode_tail_time = _decode_tail_time.get_timing();
     return t;
 }
 
 ImageReadAndDecode::ImageReadAndDecode() : _file_load_time("FileLoadTime", DBG_TIMING),
-                                           _decode_time("DecodeTime", DBG_TIMING) {
+                                           _decode_time("DecodeTime", DBG_TIMING),
+                                           _decode_tail_time("DecodeTailTime", DBG_TIMING) {
 }
 
 ImageReadAndDecode::~ImageReadAndDecode() {
+    release_mapped_data();
+    _async_file_reader = nullptr;
     _reader = nullptr;
     _decoder.clear();
 }
@@ -65,10 +73,14 @@ ImageReadAndDecode::~ImageReadAndDecode() {
 void ImageReadAndDecode::create(ReaderConfig reader_config, DecoderConfig decoder_config, int batch_size, int device_id) {
     // Can initialize it to any decoder types if needed
     _batch_size = batch_size;
-    _compressed_buff.resize(batch_size);
-    _decoder.resize(batch_size);
+    _compressed_offset.resize(batch_size);
+    _decode_order.resize(batch_size);
+    _compressed_data.resize(batch_size);
+    _mapped_data.resize(batch_size, nullptr);
+    _mapped_size.resize(batch_size, 0);
     _actual_read_size.resize(batch_size);
     _image_names.resize(batch_size);
+    _sample_indices.resize(batch_size, INVALID_SAMPLE_INDEX);
     _compressed_image_size.resize(batch_size);
     _decompressed_buff_ptrs.resize(_batch_size);
     _actual_decoded_width.resize(_batch_size);
@@ -84,16 +96,62 @@ void ImageReadAndDecode::create(ReaderConfig reader_config, DecoderConfig decode
         AreaRange area_range = std::make_pair((float)random_area[0], (float)random_area[1]);
         _random_crop_dec_param = new RocalRandomCropDecParam(aspect_ratio_range, area_range, (int64_t)decoder_config.get_seed(), decoder_config.get_num_attempts(), _batch_size);
     }
+    _num_threads = std::max(reader_config.get_cpu_num_threads(), (size_t)1);
+    _decode_thread_count = _num_threads;
+    _task_priority = reader_config.task_priority();
+    _reader = create_reader(reader_config);
+    _is_external_source = (reader_config.type() == StorageType::EXTERNAL_FILE_SOURCE);
     if ((_decoder_config._type != DecoderType::SKIP_DECODE)) {
-        for (int i = 0; i < batch_size; i++) {
-            _compressed_buff[i].resize(MAX_COMPRESSED_SIZE);  // If we don't need MAX_COMPRESSED_SIZE we can remove this & resize in load module
+        // Only _num_threads images are decoded at once, each decode slot of the task scheduler keeps its own decoder
+        _decoder.resize(_num_threads);
+        _decode_thread_end.resize(_num_threads);
+        for (size_t i = 0; i < _num_threads; i++) {
             _decoder[i] = create_decoder(decoder_config);
             _decoder[i]->initialize(device_id);
         }
     }
-    _num_threads = reader_config.get_cpu_num_threads();
-    _reader = create_reader(reader_config);
-    _is_external_source = (reader_config.type() == StorageType::EXTERNAL_FILE_SOURCE);
+    // Size bucketing scans the headers of a pool of samples ahead and regroups them into batches of similar size,
+    // with a decoder of its own since the pool is filled while the decoders work on the previous batches
+    if (reader_config.size_bucketing_pool_batch_count() > 0 && _decoder_config._type != DecoderType::SKIP_DECODE && !_is_external_source) {
+        auto header_decoder = create_decoder(decoder_config);
+        header_decoder->initialize(device_id);
+        _reader = std::make_shared<SizeBucketingReader>(_reader, header_decoder, batch_size, reader_config.size_bucketing_pool_batch_count(), reader_config.shuffle());
+    }
+    // Mapped reads hand the page cache directly to the decoders, hence no staging buffers are needed
+    _mapped_read = (_decoder_config._type != DecoderType::SKIP_DECODE && !_is_external_source && _reader->supports_mapped_read());
+    // Readers which expose the file path of each sample let the compressed reads of a batch overlap with each other and with decoding
+    if (_decoder_config._type != DecoderType::SKIP_DECODE && !_is_external_source && !_mapped_read && _reader->supports_deferred_open()) {
+        _async_file_reader = std::make_shared<AsyncFileReader>(MAX_READS_IN_FLIGHT, _num_threads * 2);
+        _compressed_buff.resize(batch_size);
+    }
+}
+
+size_t ImageReadAndDecode::read_to_slab(size_t slot, size_t &slab_offset) {
+    size_t fsize = _reader->open();
+    if (fsize == 0) {
+        WRN("Opened file " + _reader->id() + " of size 0");
+        return 0;
+    }
+    // The slab only grows, it settles at the size of the largest batch read so far
+    if (_compressed_slab.size() < slab_offset + fsize)
+        _compressed_slab.resize(slab_offset + fsize);
+    _actual_read_size[slot] = _reader->read_data(_compressed_slab.data() + slab_offset, fsize);
+    _image_names[slot] = _reader->id();
+    _sample_indices[slot] = _reader->sample_index();
+    _reader->close();
+    _compressed_image_size[slot] = fsize;
+    _compressed_offset[slot] = slab_offset;
+    slab_offset += fsize;
+    return fsize;
+}
+
+void ImageReadAndDecode::release_mapped_data() {
+    for (size_t i = 0; i < _mapped_data.size(); i++) {
+        if (_mapped_data[i])
+            _reader->unmap_data(_mapped_data[i], _mapped_size[i]);
+        _mapped_data[i] = nullptr;
+        _mapped_size[i] = 0;
+    }
 }
 
 void ImageReadAndDecode::feed_external_input(const std::vector<std::string>& input_images_names, const std::vector<unsigned char *>& input_buffer,
@@ -178,7 +236,8 @@ ImageReadAndDecode::load(unsigned char *buff,
     const size_t image_size = max_decoded_width * max_decoded_height * output_planes * sizeof(unsigned char);
     bool skip_decode = false;
     // Decode with the height and size equal to a single image
-    // File read is done serially since I/O parallelization does not work very well.
+    // File read is done serially unless the reader supports deferred opens, in which case the reads are queued on the async file reader
+    // and the decode of each image starts as soon as its compressed data lands.
     _file_load_time.start();  // Debug timing
     if (_decoder_config._type == DecoderType::SKIP_DECODE) {
         while ((file_counter != _batch_size) && _reader->count_items() > 0) {
@@ -194,6 +253,8 @@ ImageReadAndDecode::load(unsigned char *buff,
                 LOG("Reader read less than requested bytes of size: " + _actual_read_size[file_counter]);
 
             _image_names[file_counter] = _reader->id();
+
+            _sample_indices[file_counter] = _reader->sample_index();
             _reader->close();
             // _compressed_image_size[file_counter] = fsize;
             names[file_counter] = _image_names[file_counter];
@@ -222,6 +283,8 @@ ImageReadAndDecode::load(unsigned char *buff,
                     LOG("Reader read less than requested bytes of size: " + _actual_read_size[file_counter]);
 
                 _image_names[file_counter] = _reader->id();
+
+                _sample_indices[file_counter] = _reader->sample_index();
                 ext_reader->get_dims(file_counter, width, height, channels, rwidth, rheight);
                 names[file_counter] = _image_names[file_counter];
                 roi_width[file_counter] = rwidth;
@@ -233,34 +296,45 @@ ImageReadAndDecode::load(unsigned char *buff,
             }
             skip_decode = true;
         } else {
+            size_t slab_offset = 0;
             while ((file_counter != _batch_size) && _reader->count_items() > 0) {
-                _reader->count_items();
-                size_t fsize = _reader->open();
-                if (fsize == 0) {
-                    WRN("Opened file " + _reader->id() + " of size 0");
+                if (read_to_slab(file_counter, slab_offset) == 0)
                     continue;
-                }
-                _compressed_buff[file_counter].reserve(fsize);
-                _actual_read_size[file_counter] = _reader->read_data(_compressed_buff[file_counter].data(), fsize);
-                _image_names[file_counter] = _reader->id();
-                _reader->close();
-                _compressed_image_size[file_counter] = fsize;
                 file_counter++;
             }
+            // The slab may have moved while growing, the pointers are taken once the batch is read
+            for (size_t i = 0; i < file_counter; i++)
+                _compressed_data[i] = _compressed_slab.data() + _compressed_offset[i];
         }
         // return LoaderModuleStatus::OK;
-    } else {
+    } else if (_async_file_reader) {
+        _async_file_reader->reset(_batch_size);
         while ((file_counter != _batch_size) && _reader->count_items() > 0) {
-            size_t fsize = _reader->open();
-            if (fsize == 0) {
-                WRN("Opened file " + _reader->id() + " of size 0");
+            _reader->open_deferred();
+            _image_names[file_counter] = _reader->id();
+            _sample_indices[file_counter] = _reader->sample_index();
+            _async_file_reader->submit(file_counter, _reader->file_path(), &_compressed_buff[file_counter]);
+            file_counter++;
+        }
+        if (_randombboxcrop_meta_data_reader) {
+            // Fetch the crop co-ordinates for a batch of images
+            _bbox_coords = _randombboxcrop_meta_data_reader->get_batch_crop_coords(_image_names);
+            set_batch_random_bbox_crop_coords(_bbox_coords);
+        } else if (_random_crop_dec_param) {
+            _random_crop_dec_param->generate_random_seeds();
+        }
+    } else if (_mapped_read) {
+        while ((file_counter != _batch_size) && _reader->count_items() > 0) {
+            size_t fsize = 0;
+            unsigned char *data = _reader->map_data(fsize);
+            if (!data) {
+                WRN("Could not map file " + _reader->id());
                 continue;
             }
-            _compressed_buff[file_counter].reserve(fsize);
-            _actual_read_size[file_counter] = _reader->read_data(_compressed_buff[file_counter].data(), fsize);
+            _mapped_data[file_counter] = _compressed_data[file_counter] = data;
+            _mapped_size[file_counter] = _actual_read_size[file_counter] = _compressed_image_size[file_counter] = fsize;
             _image_names[file_counter] = _reader->id();
-            _reader->close();
-            _compressed_image_size[file_counter] = fsize;
+            _sample_indices[file_counter] = _reader->sample_index();
             file_counter++;
         }
         if (_randombboxcrop_meta_data_reader) {
@@ -270,32 +344,67 @@ ImageReadAndDecode::load(unsigned char *buff,
         } else if (_random_crop_dec_param) {
             _random_crop_dec_param->generate_random_seeds();
         }
+    } else {
+        size_t slab_offset = 0;
+        while ((file_counter != _batch_size) && _reader->count_items() > 0) {
+            if (read_to_slab(file_counter, slab_offset) == 0)
+                continue;
+            file_counter++;
+        }
+        // The slab may have moved while growing, the pointers are taken once the batch is read
+        for (size_t i = 0; i < file_counter; i++)
+            _compressed_data[i] = _compressed_slab.data() + _compressed_offset[i];
+        if (_randombboxcrop_meta_data_reader) {
+            // Fetch the crop co-ordinates for a batch of images
+            _bbox_coords = _randombboxcrop_meta_data_reader->get_batch_crop_coords(_image_names);
+            set_batch_random_bbox_crop_coords(_bbox_coords);
+        } else if (_random_crop_dec_param) {
+            _random_crop_dec_param->generate_random_seeds();
+        }
     }
 
-    _file_load_time.end();  // Debug timing
+    const bool async_read = (_async_file_reader != nullptr);
+    if (!async_read)
+        _file_load_time.end();  // Debug timing
 
     _decode_time.start();  // Debug timing
     if (!skip_decode) {
         for (size_t i = 0; i < _batch_size; i++)
             _decompressed_buff_ptrs[i] = buff + image_size * i;
 
-#pragma omp parallel for num_threads(_num_threads)  // default(none) TBD: option disabled in Ubuntu 20.04
-        for (size_t i = 0; i < _batch_size; i++) {
+        // Largest images first, handed out one at a time to whichever decode thread is free, so that the batch doesn't wait on a thread
+        // which got several large images while the others are idle. Sizes of the async reads are only known once they land.
+        std::iota(_decode_order.begin(), _decode_order.end(), 0);
+        if (!async_read)
+            std::stable_sort(_decode_order.begin(), _decode_order.end(), [&](size_t a, size_t b) { return _compressed_image_size[a] > _compressed_image_size[b]; });
+        std::fill(_decode_thread_end.begin(), _decode_thread_end.end(), std::chrono::high_resolution_clock::time_point());
+
+        TaskScheduler::instance().parallel_for(_batch_size, _decode_thread_count, _task_priority, [&](size_t n, size_t slot) {
+            size_t i = _decode_order[n];
+            auto &decoder = _decoder[slot];
+            if (async_read) {
+                _compressed_image_size[i] = _actual_read_size[i] = _async_file_reader->wait(i);
+                _compressed_data[i] = _compressed_buff[i].data();
+            }
             // initialize the actual decoded height and width with the maximum
             _actual_decoded_width[i] = max_decoded_width;
             _actual_decoded_height[i] = max_decoded_height;
             int original_width, original_height, jpeg_sub_samp;
-            if (_decoder[i]->decode_info(_compressed_buff[i].data(), _actual_read_size[i], &original_width, &original_height,
-                                         &jpeg_sub_samp) != Decoder::Status::OK) {
+            if (decoder->decode_info(_compressed_data[i], _actual_read_size[i], &original_width, &original_height,
+                                     &jpeg_sub_samp) != Decoder::Status::OK) {
                 // Substituting the image which failed decoding with other image from the same batch
                 int j = ((i + 1) != _batch_size) ? _batch_size - 1 : _batch_size - 2;
                 while ((j >= 0)) {
-                    if (_decoder[i]->decode_info(_compressed_buff[j].data(), _actual_read_size[j], &original_width, &original_height,
-                                                 &jpeg_sub_samp) == Decoder::Status::OK) {
+                    // The read of the substitute may still be in flight
+                    size_t substitute_read_size = async_read ? _async_file_reader->wait(j) : _actual_read_size[j];
+                    unsigned char *substitute_data = async_read ? _compressed_buff[j].data() : _compressed_data[j];
+                    if (decoder->decode_info(substitute_data, substitute_read_size, &original_width, &original_height,
+                                             &jpeg_sub_samp) == Decoder::Status::OK) {
                         _image_names[i] = _image_names[j];
-                        _compressed_buff[i] = _compressed_buff[j];
-                        _actual_read_size[i] = _actual_read_size[j];
-                        _compressed_image_size[i] = _compressed_image_size[j];
+                        _sample_indices[i] = _sample_indices[j];
+                        _compressed_data[i] = substitute_data;  // Decoders only read the data, so the slots can share it
+                        _actual_read_size[i] = substitute_read_size;
+                        _compressed_image_size[i] = async_read ? substitute_read_size : _compressed_image_size[j];
                         break;
 
                     } else
@@ -309,24 +418,37 @@ ImageReadAndDecode::load(unsigned char *buff,
             _original_width[i] = original_width;
             // decode the image and get the actual decoded image width and height
             size_t scaledw, scaledh;
-            if (_decoder[i]->is_partial_decoder()) {
+            if (decoder->is_partial_decoder()) {
                 if (_randombboxcrop_meta_data_reader) {
-                    _decoder[i]->set_bbox_coords(_bbox_coords[i]);
+                    decoder->set_bbox_coords(_bbox_coords[i]);
                 } else if (_random_crop_dec_param) {
                     Shape dec_shape = {_original_height[i], _original_width[i]};
                     auto crop_window = _random_crop_dec_param->generate_crop_window(dec_shape, i);
-                    _decoder[i]->set_crop_window(crop_window);
+                    decoder->set_crop_window(crop_window);
                 }
             }
-            if (_decoder[i]->decode(_compressed_buff[i].data(), _compressed_image_size[i], _decompressed_buff_ptrs[i],
-                                    max_decoded_width, max_decoded_height,
-                                    original_width, original_height,
-                                    scaledw, scaledh,
-                                    decoder_color_format, _decoder_config, keep_original) != Decoder::Status::OK) {
+            if (decoder->decode(_compressed_data[i], _compressed_image_size[i], _decompressed_buff_ptrs[i],
+                                max_decoded_width, max_decoded_height,
+                                original_width, original_height,
+                                scaledw, scaledh,
+                                decoder_color_format, _decoder_config, keep_original) != Decoder::Status::OK) {
             }
             _actual_decoded_width[i] = scaledw;
             _actual_decoded_height[i] = scaledh;
+            // The last image a slot decodes marks when it ran out of work
+            _decode_thread_end[slot] = std::chrono::high_resolution_clock::now();
+        });
+        // The tail spans from the first decode thread running out of images to the last one finishing
+        std::chrono::high_resolution_clock::time_point first_end, last_end;
+        for (auto &thread_end : _decode_thread_end) {
+            if (thread_end == std::chrono::high_resolution_clock::time_point())
+                continue;
+            if (first_end == std::chrono::high_resolution_clock::time_point() || thread_end < first_end)
+                first_end = thread_end;
+            last_end = std::max(last_end, thread_end);
         }
+        _decode_tail_time.start(first_end);
+        _decode_tail_time.end(last_end);
         for (size_t i = 0; i < _batch_size; i++) {
             names[i] = _image_names[i];
             roi_width[i] = _actual_decoded_width[i];
@@ -335,6 +457,13 @@ ImageReadAndDecode::load(unsigned char *buff,
             actual_height[i] = _original_height[i];
         }
     }
+    if (async_read) {
+        // Read time spans from queuing the first read until the last one landed, hence overlaps with the decode time
+        _async_file_reader->wait_all();
+        _file_load_time.end(_async_file_reader->last_completion_time());  // Debug timing
+    }
+    if (_mapped_read)
+        release_mapped_data();
     _bbox_coords.clear();
     _decode_time.end();  // Debug timing
     return LoaderModuleStatus::OK;
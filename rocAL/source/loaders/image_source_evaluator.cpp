@@ -22,13 +22,92 @@ THE SOFTWARE.
 
 #include "loaders/image_source_evaluator.h"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <fstream>
+
 #include "decoders/image/decoder_factory.h"
+#include "pipeline/task_scheduler.h"
 #include "readers/image/reader_factory.h"
+
+namespace {
+//! Returns the size of the JPEG header held in data, up to and including the start of scan segment
+/*!
+ \return 0 if data is not a JPEG stream, a size larger than size if the header continues past the data
+*/
+size_t jpeg_header_size(const unsigned char *data, size_t size) {
+    if (size < 2 || data[0] != 0xFF || data[1] != 0xD8)
+        return 0;
+    size_t offset = 2;
+    while (true) {
+        if (offset + 4 > size)
+            return offset + 4;
+        if (data[offset] != 0xFF)
+            return 0;
+        unsigned char marker = data[offset + 1];
+        if (marker == 0xFF) {  // Fill byte
+            offset++;
+            continue;
+        }
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {  // Markers without a segment
+            offset += 2;
+            continue;
+        }
+        offset += 2 + ((data[offset + 2] << 8) | data[offset + 3]);
+        if (marker == 0xDA)
+            return offset;
+    }
+}
+
+//! Reads the beginning of the file until it holds the whole JPEG header, or the whole file if it is not a JPEG
+size_t read_header(const std::string &file_path, std::vector<unsigned char> &buffer, size_t initial_size) {
+    int fd = open(file_path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return 0;
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        close(fd);
+        return 0;
+    }
+    size_t file_size = file_stat.st_size;
+    size_t to_read = std::min(file_size, initial_size), data_size = 0;
+    while (data_size < file_size) {
+        if (buffer.size() < to_read)
+            buffer.resize(to_read);
+        ssize_t read_size = pread(fd, buffer.data() + data_size, to_read - data_size, data_size);
+        if (read_size <= 0)
+            break;
+        data_size += read_size;
+        if (data_size < to_read)
+            continue;
+        size_t header_size = jpeg_header_size(buffer.data(), data_size);
+        if (header_size == 0)
+            to_read = file_size;
+        else if (header_size <= data_size)
+            break;
+        else
+            to_read = std::min(file_size, std::max(header_size, 2 * data_size));
+    }
+    close(fd);
+    return data_size;
+}
+}  // namespace
+
 void ImageSourceEvaluator::set_size_evaluation_policy(MaxSizeEvaluationPolicy arg) {
     _width_max.set_policy(arg);
     _height_max.set_policy(arg);
 }
 
+void ImageSourceEvaluator::set_sampling(float sample_fraction, float safety_margin) {
+    _sample_fraction = sample_fraction;
+    // The whole data set gives the exact maximum, the margin only accounts for the images left out of the sample
+    _width_max.set_safety_margin(sample_fraction < 1 ? safety_margin : 0);
+    _height_max.set_safety_margin(sample_fraction < 1 ? safety_margin : 0);
+}
+
 size_t ImageSourceEvaluator::max_width() {
     return _width_max.get_max();
 }
@@ -44,37 +123,118 @@ ImageSourceEvaluator::create(ReaderConfig reader_cfg, DecoderConfig decoder_cfg)
     // Can initialize it to any decoder types if needed
 
     // _header_buff.resize(COMPRESSED_SIZE);
+    _decoder_cfg = decoder_cfg;
     _decoder = create_decoder(std::move(decoder_cfg));
+    bool folder_storage = reader_cfg.type() == StorageType::FILE_SYSTEM || reader_cfg.type() == StorageType::COCO_FILE_SYSTEM;
+    if (!reader_cfg.manifest_dir().empty() && folder_storage) {
+        _root_path = reader_cfg.path();
+        _manifest = DatasetManifest::get(reader_cfg.manifest_dir(), _root_path);
+    }
     _reader = create_reader(std::move(reader_cfg));
     find_max_dimension();
     return status;
 }
 
+bool ImageSourceEvaluator::is_sampled(size_t index) {
+    if (_sample_fraction >= 1)
+        return true;
+    // Keeps the indices where the scaled index crosses an integer, evenly spread over the data set
+    return std::floor(index * _sample_fraction) != std::floor((index + 1) * _sample_fraction) || (index == 0);
+}
+
 void ImageSourceEvaluator::find_max_dimension() {
     _reader->reset();
+    if (_reader->supports_deferred_open()) {
+        find_max_dimension_parallel();
+    } else {
+        for (size_t index = 0; _reader->count_items(); index++) {
+            int width, height;
+            if (!is_sampled(index)) {
+                _reader->skip();
+                continue;
+            }
+            if (!read_dimensions(width, height))
+                continue;
+            _width_max.process_sample(width);
+            _height_max.process_sample(height);
+        }
+    }
+    // return the reader read pointer to the begining of the resource
+    _reader->reset();
+}
 
-    while (_reader->count_items()) {
-        size_t fsize = _reader->open();
-        if ((fsize) == 0)
-            continue;
-        _header_buff.resize(fsize);
-        auto actual_read_size = _reader->read_data(_header_buff.data(), fsize);
-        _reader->close();
+bool ImageSourceEvaluator::read_dimensions(int &width, int &height) {
+    size_t fsize = _reader->open();
+    if ((fsize) == 0)
+        return false;
+    _header_buff.resize(fsize);
+    auto actual_read_size = _reader->read_data(_header_buff.data(), fsize);
+    _reader->close();
+
+    int jpeg_sub_samp;
+    if (_decoder->decode_info(_header_buff.data(), actual_read_size, &width, &height, &jpeg_sub_samp) != Decoder::Status::OK) {
+        WRN("Could not decode the header of the: " + _reader->id())
+        return false;
+    }
+    return width > 0 && height > 0;
+}
+
+void ImageSourceEvaluator::find_max_dimension_parallel() {
+    std::vector<std::string> file_paths;
+    for (size_t index = 0; _reader->count_items(); index++) {
+        _reader->open_deferred();
+        if (is_sampled(index))
+            file_paths.push_back(_reader->file_path());
+    }
 
+    // Dimensions found in previous runs are taken from the manifest, only the other files are read
+    std::vector<std::pair<int, int>> dimensions(file_paths.size(), {0, 0});
+    std::vector<std::pair<size_t, size_t>> manifest_locations(file_paths.size(), {SIZE_MAX, SIZE_MAX});
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < file_paths.size(); i++) {
+        auto &file_path = file_paths[i];
+        if (_manifest && file_path.size() > _root_path.size() && file_path.compare(0, _root_path.size(), _root_path) == 0 &&
+            _manifest->find(file_path.substr(_root_path.size() + 1), manifest_locations[i].first, manifest_locations[i].second)) {
+            auto &file = _manifest->folder(manifest_locations[i].first).files[manifest_locations[i].second];
+            if (file.width != 0 && file.height != 0) {
+                dimensions[i] = {file.width, file.height};
+                continue;
+            }
+        }
+        pending.push_back(i);
+    }
+
+    unsigned num_threads = std::max(1u, std::min<unsigned>(_num_threads, pending.size()));
+    std::vector<std::shared_ptr<Decoder>> decoders(num_threads);
+    std::vector<std::vector<unsigned char>> buffers(num_threads);
+    decoders[0] = _decoder;
+    for (unsigned t = 1; t < num_threads; t++)
+        decoders[t] = create_decoder(_decoder_cfg);
+    TaskScheduler::instance().parallel_for(pending.size(), num_threads, TaskPriority::NORMAL, [&](size_t p, size_t slot) {
+        auto &file_path = file_paths[pending[p]];
+        size_t data_size = read_header(file_path, buffers[slot], HEADER_READ_SIZE);
+        if (data_size == 0)
+            return;
         int width, height, jpeg_sub_samp;
-        if (_decoder->decode_info(_header_buff.data(), actual_read_size, &width, &height, &jpeg_sub_samp) != Decoder::Status::OK) {
-            WRN("Could not decode the header of the: " + _reader->id())
-            continue;
+        if (decoders[slot]->decode_info(buffers[slot].data(), data_size, &width, &height, &jpeg_sub_samp) != Decoder::Status::OK) {
+            WRN("Could not decode the header of the: " + file_path)
+            return;
         }
+        dimensions[pending[p]] = {width, height};
+    });
 
+    // Samples are processed in the reader's order so that ties of the MOST_FREQUENT_SIZE policy don't depend on the scheduling
+    for (size_t i = 0; i < file_paths.size(); i++) {
+        auto [width, height] = dimensions[i];
         if (width <= 0 || height <= 0)
             continue;
-
+        if (_manifest && manifest_locations[i].first != SIZE_MAX)
+            _manifest->set_dimensions(manifest_locations[i].first, manifest_locations[i].second, width, height);
         _width_max.process_sample(width);
         _height_max.process_sample(height);
     }
-    // return the reader read pointer to the begining of the resource
-    _reader->reset();
+    if (_manifest)
+        _manifest->save();
 }
 
 void ImageSourceEvaluator::FindMaxSize::process_sample(unsigned val) {
@@ -85,7 +245,7 @@ void ImageSourceEvaluator::FindMaxSize::process_sample(unsigned val) {
         auto it = _hist.find(val);
         size_t count = 1;
         if (it != _hist.end()) {
-            it->second = +1;
+            it->second += 1;
             count = it->second;
         } else {
             _hist.insert(std::make_pair(val, 1));
@@ -97,4 +257,10 @@ void ImageSourceEvaluator::FindMaxSize::process_sample(unsigned val) {
             _max_count = new_count;
         }
     }
-}
\ No newline at end of file
+}
+
+unsigned ImageSourceEvaluator::FindMaxSize::get_max() {
+    if (_policy == MaxSizeEvaluationPolicy::MAXIMUM_FOUND_SIZE)
+        return static_cast<unsigned>(std::ceil(_max * (1.0f + _safety_margin)));
+    return _max;
+}
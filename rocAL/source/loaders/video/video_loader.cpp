@@ -120,6 +120,7 @@ void VideoLoader::initialize(ReaderConfig reader_cfg, DecoderConfig decoder_cfg,
     _mem_type = mem_type;
     _batch_size = batch_size;
     _loop = reader_cfg.loop();
+    reader_cfg.set_task_priority(_task_priority);
     _sequence_length = reader_cfg.get_sequence_length();
     _decoder_keep_original = decoder_keep_original;
     _video_loader = std::make_shared<VideoReadAndDecode>();
@@ -136,6 +137,7 @@ void VideoLoader::initialize(ReaderConfig reader_cfg, DecoderConfig decoder_cfg,
     _decoded_data_info._roi_width.resize(_batch_size);
     _decoded_data_info._original_height.resize(_batch_size);
     _decoded_data_info._original_width.resize(_batch_size);
+    _circ_buff.set_numa_placement(_numa_placement);
     _circ_buff.init(_mem_type, _output_mem_size, _prefetch_queue_depth);
     _is_initialized = true;
     LOG("Loader module initialized");
@@ -151,6 +153,7 @@ void VideoLoader::start_loading() {
 
 LoaderModuleStatus
 VideoLoader::load_routine() {
+    _numa_placement.bind_current_thread();
     LOG("Started the internal loader thread");
     LoaderModuleStatus last_load_status = LoaderModuleStatus::OK;
 
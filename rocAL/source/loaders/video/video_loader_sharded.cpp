@@ -77,6 +77,8 @@ void VideoLoaderSharded::initialize(ReaderConfig reader_cfg, DecoderConfig decod
     for (size_t i = 0; i < _shard_count; i++) {
         auto loader = std::make_shared<VideoLoader>(_dev_resources);
         loader->set_prefetch_queue_depth(_prefetch_queue_depth);
+        loader->set_task_priority(_task_priority);
+        loader->set_numa_placement(_numa_placement);
         _loaders.push_back(loader);
     }
 
@@ -100,12 +102,6 @@ void VideoLoaderSharded::start_loading() {
         struct sched_param params;
         params.sched_priority = sched_get_priority_max(SCHED_FIFO);
         _loaders[i]->set_cpu_sched_policy(params);
-        // Setting cpu affinity for threads works and can be activated below for experimentation
-        // Set thread affinity thread 0 to core 0 , 1 toc core 1 , ...
-        cpu_set_t cpuset;
-        CPU_ZERO(&cpuset);
-        CPU_SET(i, &cpuset);
-        _loaders[i]->set_cpu_affinity(cpuset);
 #endif
     }
 }
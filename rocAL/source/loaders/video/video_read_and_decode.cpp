@@ -65,6 +65,7 @@ void VideoReadAndDecode::create(ReaderConfig reader_config, DecoderConfig decode
     _video_count = _video_prop.videos_count;
     _frame_rate = _video_prop.frame_rate;
     _batch_size = batch_size;
+    _task_priority = reader_config.task_priority();
     set_video_process_count(_video_count);
     _video_decoder.resize(_video_process_count);
     _video_names = _video_prop.video_file_names;
@@ -218,13 +219,10 @@ VideoReadAndDecode::load(unsigned char *buff,
     for (size_t i = 0; i < sequential_decode_sequences.size(); i++)
         decode_sequence(sequential_decode_sequences[i]);
 
-    // Initialize threads to decode
-    std::vector<std::thread> decode_threads;
-    for (size_t i = 0; i < parallel_decode_sequences.size(); i++)
-        decode_threads.push_back(std::thread(&VideoReadAndDecode::decode_sequence, this, parallel_decode_sequences[i]));
-
-    for (auto &th : decode_threads)
-        th.join();
+    // Sequences of different videos have their own decoders, they're decoded on as many threads as the task scheduler lends
+    TaskScheduler::instance().parallel_for(parallel_decode_sequences.size(), parallel_decode_sequences.size(), _task_priority, [&](size_t i, size_t) {
+        decode_sequence(parallel_decode_sequences[i]);
+    });
 
     _decode_time.end();  // Debug timing
 
@@ -25,8 +25,12 @@ void BoundingBoxGraph::process(pMetaDataBatch input_meta_data, pMetaDataBatch ou
     size_t num_meta_nodes = _meta_nodes.size();
     for (auto &meta_node : _meta_nodes) {
         meta_node->update_parameters(input_meta_data, output_meta_data);
-        if (--num_meta_nodes > 0)
-            input_meta_data = output_meta_data->clone();
+        if (--num_meta_nodes > 0) {
+            if (!_intermediate_meta_data)
+                _intermediate_meta_data = output_meta_data->clone(false);
+            output_meta_data->clone_into(*_intermediate_meta_data);
+            input_meta_data = _intermediate_meta_data;
+        }
     }
 }
 
@@ -40,21 +44,18 @@ void BoundingBoxGraph::update_meta_data(pMetaDataBatch input_meta_data, DecodedD
         float _dst_to_src_width_ratio = roi_width[i] / static_cast<float>(original_width[i]);
         float _dst_to_src_height_ratio = roi_height[i] / static_cast<float>(original_height[i]);
         unsigned bb_count = input_meta_data->get_labels_batch()[i].size();
-        BoundingBoxCords coords_buf = input_meta_data->get_bb_cords_batch()[i];
-        BoundingBoxCords bb_coords;
-        BoundingBoxCord temp_box;
-        temp_box.l = temp_box.t = temp_box.r = temp_box.b = 0;
+        // The boxes are scaled in place, keeping the storage of the batch
+        BoundingBoxCords &bb_coords = input_meta_data->get_bb_cords_batch()[i];
+        bb_coords.resize(bb_count);
         for (uint j = 0; j < bb_count; j++) {
-            coords_buf[j].l *= _dst_to_src_width_ratio;
-            coords_buf[j].t *= _dst_to_src_height_ratio;
-            coords_buf[j].r *= _dst_to_src_width_ratio;
-            coords_buf[j].b *= _dst_to_src_height_ratio;
-            bb_coords.push_back(coords_buf[j]);
+            bb_coords[j].l *= _dst_to_src_width_ratio;
+            bb_coords[j].t *= _dst_to_src_height_ratio;
+            bb_coords[j].r *= _dst_to_src_width_ratio;
+            bb_coords[j].b *= _dst_to_src_height_ratio;
         }
         if (bb_coords.size() == 0) {
-            bb_coords.push_back(temp_box);
+            bb_coords.emplace_back(0, 0, 0, 0);
         }
-        input_meta_data->get_bb_cords_batch()[i] = bb_coords;
     }
 }
 
@@ -147,8 +148,7 @@ inline int find_best_box_for_anchor(unsigned anchor_idx, const std::vector<float
 }
 
 void BoundingBoxGraph::update_box_encoder_meta_data(std::vector<float> *anchors, pMetaDataBatch full_batch_meta_data, float criteria, bool offset, float scale, std::vector<float> &means, std::vector<float> &stds, float *encoded_boxes_data, int *encoded_labels_data) {
-#pragma omp parallel for
-    for (int i = 0; i < full_batch_meta_data->size(); i++) {
+    TaskScheduler::instance().parallel_for(full_batch_meta_data->size(), _max_parallelism, _task_priority, [&](size_t i, size_t) {
         BoundingBoxCord *bbox_anchors = reinterpret_cast<BoundingBoxCord *>(anchors->data());
         auto bb_count = full_batch_meta_data->get_labels_batch()[i].size();
         int *bb_labels = full_batch_meta_data->get_labels_batch()[i].data();
@@ -215,7 +215,7 @@ void BoundingBoxGraph::update_box_encoder_meta_data(std::vector<float> *anchors,
                 }
             }
         }
-    }
+    });
 }
 
 void BoundingBoxGraph::update_box_iou_matcher(BoxIouMatcherInfo &iou_matcher_info, int *matches_idx_buffer, pMetaDataBatch full_batch_meta_data) {
@@ -228,8 +228,7 @@ void BoundingBoxGraph::update_box_iou_matcher(BoxIouMatcherInfo &iou_matcher_inf
         matches[i] = reinterpret_cast<int *>(matches_idx_buffer + i * anchors_size);
     }
 
-#pragma omp parallel for
-    for (int i = 0; i < full_batch_meta_data->size(); i++) {
+    TaskScheduler::instance().parallel_for(full_batch_meta_data->size(), _max_parallelism, _task_priority, [&](size_t i, size_t) {
         auto bb_coords = bb_coords_batch[i];
         auto bb_count = bb_coords.size();
 
@@ -279,5 +278,5 @@ void BoundingBoxGraph::update_box_iou_matcher(BoxIouMatcherInfo &iou_matcher_inf
 
         matched_vals.clear();
         low_quality_preds.clear();
-    }
+    });
 }
@@ -81,7 +81,7 @@ void CaffeMetaDataReader::lookup(const std::vector<std::string>& image_names) {
         _output->resize(image_names.size());
 
     for (unsigned i = 0; i < image_names.size(); i++) {
-        auto image_name = image_names[i];
+        const auto &image_name = image_names[i];
         auto it = _map_content.find(image_name);
         if (_map_content.end() == it)
             THROW("ERROR: Given name not present in the map" + image_name)
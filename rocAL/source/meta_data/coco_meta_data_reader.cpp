@@ -59,19 +59,16 @@ void COCOMetaDataReader::lookup(const std::vector<std::string> &image_names) {
         _output->resize(image_names.size());
 
     for (unsigned i = 0; i < image_names.size(); i++) {
-        auto image_name = image_names[i];
-        auto it = _map_content.find(image_name);
-        if (_map_content.end() == it)
-            THROW("ERROR: Given name not present in the map" + image_name)
-        _output->get_bb_cords_batch()[i] = it->second->get_bb_cords();
-        _output->get_labels_batch()[i] = it->second->get_labels();
-        _output->get_img_sizes_batch()[i] = it->second->get_img_size();
-        _output->get_image_id_batch()[i] = it->second->get_image_id();
+        const auto &image_name = image_names[i];
+        auto &entry = find_entry(_map_content, i, image_name);
+        _output->get_bb_cords_batch()[i] = entry->get_bb_cords();
+        _output->get_labels_batch()[i] = entry->get_labels();
+        _output->get_img_sizes_batch()[i] = entry->get_img_size();
+        _output->get_image_id_batch()[i] = entry->get_image_id();
         if (_output->get_metadata_type() == MetaDataType::PolygonMask) {
-            auto mask_cords = it->second->get_mask_cords();
-            _output->get_mask_cords_batch()[i] = mask_cords;
-            _output->get_mask_polygons_count_batch()[i] = it->second->get_polygon_count();
-            _output->get_mask_vertices_count_batch()[i] = it->second->get_vertices_count();
+            _output->get_mask_cords_batch()[i] = entry->get_mask_cords();
+            _output->get_mask_polygons_count_batch()[i] = entry->get_polygon_count();
+            _output->get_mask_vertices_count_batch()[i] = entry->get_vertices_count();
         }
     }
 }
@@ -329,10 +326,12 @@ void COCOMetaDataReader::release(std::string image_name) {
         return;
     }
     _map_content.erase(image_name);
+    clear_entry_cache();
 }
 
 void COCOMetaDataReader::release() {
     _map_content.clear();
+    clear_entry_cache();
     _map_img_sizes.clear();
 }
 
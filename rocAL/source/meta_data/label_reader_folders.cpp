@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "pipeline/commons.h"
 #include "pipeline/exception.h"
 #include "pipeline/filesystem.h"
+#include "readers/dataset_manifest.h"
 
 using namespace std;
 
@@ -39,6 +40,7 @@ LabelReaderFolders::LabelReaderFolders() {
 
 void LabelReaderFolders::init(const MetaDataConfig& cfg, pMetaDataBatch meta_data_batch) {
     _path = cfg.path();
+    _manifest_dir = cfg.manifest_dir();
     _output = meta_data_batch;
 }
 bool LabelReaderFolders::exists(const std::string& image_name) {
@@ -62,6 +64,7 @@ void LabelReaderFolders::print_map_contents() {
 
 void LabelReaderFolders::release() {
     _map_content.clear();
+    clear_entry_cache();
 }
 
 void LabelReaderFolders::release(std::string image_name) {
@@ -70,6 +73,7 @@ void LabelReaderFolders::release(std::string image_name) {
         return;
     }
     _map_content.erase(image_name);
+    clear_entry_cache();
 }
 
 void LabelReaderFolders::lookup(const std::vector<std::string>& image_names) {
@@ -81,15 +85,16 @@ void LabelReaderFolders::lookup(const std::vector<std::string>& image_names) {
         _output->resize(image_names.size());
 
     for (unsigned i = 0; i < image_names.size(); i++) {
-        auto image_name = image_names[i];
-        auto it = _map_content.find(image_name);
-        if (_map_content.end() == it)
-            THROW("ERROR: Given name not present in the map" + image_name)
-        _output->get_labels_batch()[i] = it->second->get_labels();
+        const auto &image_name = image_names[i];
+        _output->get_labels_batch()[i] = find_entry(_map_content, i, image_name)->get_labels();
     }
 }
 
 void LabelReaderFolders::read_all(const std::string& _path) {
+    if (!_manifest_dir.empty()) {
+        read_manifest(_path);
+        return;
+    }
     std::string _folder_path = _path;
     if ((_sub_dir = opendir(_folder_path.c_str())) == nullptr)
         THROW("ERROR: Failed opening the directory at " + _folder_path);
@@ -110,14 +115,8 @@ void LabelReaderFolders::read_all(const std::string& _path) {
         filesys::path pathObj(subfolder_path);
         if (filesys::exists(pathObj) && filesys::is_regular_file(pathObj)) {
             // ignore files with non-image extensions
-            auto file_extension_idx = subfolder_path.find_last_of(".");
-            if (file_extension_idx != std::string::npos) {
-                std::string file_extension = subfolder_path.substr(file_extension_idx + 1);
-                std::transform(file_extension.begin(), file_extension.end(), file_extension.begin(),
-                               [](unsigned char c) { return std::tolower(c); });
-                if ((file_extension != "jpg") && (file_extension != "jpeg") && (file_extension != "png") && (file_extension != "ppm") && (file_extension != "bmp") && (file_extension != "pgm") && (file_extension != "tif") && (file_extension != "tiff") && (file_extension != "webp") && (file_extension != "wav"))
-                    continue;
-            }
+            if (!DatasetManifest::is_supported_file(subfolder_path))
+                continue;
             read_files(_folder_path);
             for (unsigned i = 0; i < _subfolder_file_names.size(); i++) {
                 add(_subfolder_file_names[i], 0);
@@ -135,6 +134,25 @@ void LabelReaderFolders::read_all(const std::string& _path) {
     }
 }
 
+void LabelReaderFolders::read_manifest(const std::string& path) {
+    auto manifest = DatasetManifest::get(_manifest_dir, path);
+    auto add_folder = [&](size_t folder_idx, int label) {
+        auto& folder = manifest->folder(folder_idx);
+        for (auto& file : folder.files)
+            if (DatasetManifest::is_supported_file(file.name))
+                add(file.name, label);
+    };
+    for (auto& entry : manifest->root_entries()) {
+        if (!entry.is_directory) {
+            if (!DatasetManifest::is_supported_file(entry.name))
+                continue;
+            add_folder(0, 0);
+            break;  // assume directory has only files.
+        }
+        add_folder(entry.folder_idx, manifest->folder(entry.folder_idx).label);
+    }
+}
+
 void LabelReaderFolders::read_files(const std::string& _path) {
     if ((_src_dir = opendir(_path.c_str())) == nullptr)
         THROW("ERROR: Failed opening the directory at " + _path);
@@ -146,14 +164,8 @@ void LabelReaderFolders::read_files(const std::string& _path) {
         std::string file_path = _path;
         file_path.append("/");
         std::string filename(_entity->d_name);
-        auto file_extension_idx = filename.find_last_of(".");
-        if (file_extension_idx != std::string::npos) {
-            std::string file_extension = filename.substr(file_extension_idx + 1);
-            std::transform(file_extension.begin(), file_extension.end(), file_extension.begin(),
-                           [](unsigned char c) { return std::tolower(c); });
-            if ((file_extension != "jpg") && (file_extension != "jpeg") && (file_extension != "png") && (file_extension != "ppm") && (file_extension != "bmp") && (file_extension != "pgm") && (file_extension != "tif") && (file_extension != "tiff") && (file_extension != "webp") && (file_extension != "wav"))
-                continue;
-        }
+        if (!DatasetManifest::is_supported_file(filename))
+            continue;
         file_path.append(_entity->d_name);
         _file_names.push_back(file_path);
         _subfolder_file_names.push_back(_entity->d_name);
@@ -58,11 +58,8 @@ void TextFileMetaDataReader::lookup(const std::vector<std::string> &image_names)
     if (image_names.size() != (unsigned)_output->size())
         _output->resize(image_names.size());
     for (unsigned i = 0; i < image_names.size(); i++) {
-        auto image_name = image_names[i];
-        auto it = _map_content.find(image_name);
-        if (_map_content.end() == it)
-            THROW("ERROR: Given name not present in the map" + image_name)
-        _output->get_labels_batch()[i] = it->second->get_labels();
+        const auto &image_name = image_names[i];
+        _output->get_labels_batch()[i] = find_entry(_map_content, i, image_name)->get_labels();
     }
 }
 
@@ -95,10 +92,12 @@ void TextFileMetaDataReader::release(std::string image_name) {
         return;
     }
     _map_content.erase(image_name);
+    clear_entry_cache();
 }
 
 void TextFileMetaDataReader::release() {
     _map_content.clear();
+    clear_entry_cache();
 }
 
 TextFileMetaDataReader::TextFileMetaDataReader() {
@@ -85,11 +85,11 @@ ParameterFactory::~ParameterFactory() {
             rand_obj);
 }
 
-void ParameterFactory::renew_parameters() {
+void ParameterFactory::renew_parameters(uint64_t epoch, uint64_t batch_idx) {
     for (auto&& rand_obj : _parameters)
         std::visit(
-            [](auto&& arg) {
-                arg->renew();
+            [epoch, batch_idx](auto&& arg) {
+                arg->renew_batch(epoch, batch_idx);
             },
             rand_obj);
 }
@@ -119,28 +119,28 @@ void ParameterFactory::set_seed(unsigned seed) {
 }
 
 IntParam* ParameterFactory::create_uniform_int_rand_param(int start, int end) {
-    auto gen = new UniformRand<int>(start, end, get_seed_from_seedsequence());
+    auto gen = new UniformRand<int>(start, end, get_seed_from_seedsequence(), _next_param_id++);
     auto ret = new IntParam(gen, RocalParameterType::RANDOM_UNIFORM);
     _parameters.insert(gen);
     return ret;
 }
 
 FloatParam* ParameterFactory::create_uniform_float_rand_param(float start, float end) {
-    auto gen = new UniformRand<float>(start, end, get_seed_from_seedsequence());
+    auto gen = new UniformRand<float>(start, end, get_seed_from_seedsequence(), _next_param_id++);
     auto ret = new FloatParam(gen, RocalParameterType::RANDOM_UNIFORM);
     _parameters.insert(gen);
     return ret;
 }
 
 IntParam* ParameterFactory::create_custom_int_rand_param(const int* value, const double* frequencies, size_t size) {
-    auto gen = new CustomRand<int>(value, frequencies, size, get_seed_from_seedsequence());
+    auto gen = new CustomRand<int>(value, frequencies, size, get_seed_from_seedsequence(), _next_param_id++);
     auto ret = new IntParam(gen, RocalParameterType::RANDOM_CUSTOM);
     _parameters.insert(gen);
     return ret;
 }
 
 FloatParam* ParameterFactory::create_custom_float_rand_param(const float* value, const double* frequencies, size_t size) {
-    auto gen = new CustomRand<float>(value, frequencies, size, get_seed_from_seedsequence());
+    auto gen = new CustomRand<float>(value, frequencies, size, get_seed_from_seedsequence(), _next_param_id++);
     auto ret = new FloatParam(gen, RocalParameterType::RANDOM_CUSTOM);
     _parameters.insert(gen);
     return ret;
@@ -0,0 +1,84 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "pipeline/execution_stage.h"
+
+ExecutionStage::ExecutionStage(const std::string &name, const NumaPlacement &placement) : _name(name), _placement(placement) {
+    LOG("Starting execution stage " + _name)
+    _thread = std::thread(&ExecutionStage::routine, this);
+}
+
+ExecutionStage::~ExecutionStage() {
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _running = false;
+    }
+    _wait_for_job.notify_all();
+    if (_thread.joinable())
+        _thread.join();
+}
+
+std::future<void> ExecutionStage::submit(std::function<void()> job) {
+    std::packaged_task<void()> task(std::move(job));
+    auto future = task.get_future();
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        if (!_running)
+            THROW("Cannot submit a job to the stopped execution stage " + _name)
+        _queue.push_back(std::move(task));
+        _pending++;
+    }
+    _wait_for_job.notify_one();
+    return future;
+}
+
+void ExecutionStage::drain() {
+    std::unique_lock<std::mutex> lock(_lock);
+    _wait_for_drain.wait(lock, [&] { return _pending == 0; });
+}
+
+size_t ExecutionStage::pending() {
+    std::unique_lock<std::mutex> lock(_lock);
+    return _pending;
+}
+
+void ExecutionStage::routine() {
+    _placement.bind_current_thread();
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            // Jobs already queued still run when the stage is stopped, so that their futures become ready
+            _wait_for_job.wait(lock, [&] { return !_queue.empty() || !_running; });
+            if (_queue.empty())
+                return;
+            task = std::move(_queue.front());
+            _queue.pop_front();
+        }
+        task();
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            _pending--;
+        }
+        _wait_for_drain.notify_all();
+    }
+}
@@ -24,10 +24,12 @@ THE SOFTWARE.
 #endif
 #include <vx_ext_amd.h>
 #include <VX/vx_types.h>
+#include <chrono>
 #include <cstring>
 #include <sched.h>
 #include <half/half.hpp>
 #include "pipeline/master_graph.h"
+#include "pipeline/tensor_conversion.h"
 #include "parameters/parameter_factory.h"
 #include "device/ocl_setup.h"
 #include "pipeline/log.h"
@@ -35,6 +37,7 @@ THE SOFTWARE.
 #include "meta_data/meta_data_graph_factory.h"
 #include "meta_data/randombboxcrop_meta_data_reader_factory.h"
 #include "augmentations/node_copy.h"
+#include "augmentations/color_augmentations/node_fused_color.h"
 
 using half_float::half;
 
@@ -93,7 +96,7 @@ MasterGraph::~MasterGraph() {
     release();
 }
 
-MasterGraph::MasterGraph(size_t batch_size, RocalAffinity affinity, size_t cpu_thread_count, int gpu_id, size_t prefetch_queue_depth, RocalTensorDataType output_tensor_data_type) : _ring_buffer(prefetch_queue_depth),
+MasterGraph::MasterGraph(size_t batch_size, RocalAffinity affinity, size_t cpu_thread_count, int gpu_id, size_t prefetch_queue_depth, RocalTensorDataType output_tensor_data_type, const NumaPlacement &numa_placement) : _ring_buffer(prefetch_queue_depth),
                                                                                                                                                                                      _graph(nullptr),
                                                                                                                                                                                      _affinity(affinity),
                                                                                                                                                                                      _cpu_num_threads(cpu_thread_count),
@@ -116,6 +119,7 @@ MasterGraph::MasterGraph(size_t batch_size, RocalAffinity affinity, size_t cpu_t
 #if ENABLE_HIP
                                                                                                                                                                                      _box_encoder_gpu(nullptr),
 #endif
+                                                                                                                                                                                     _numa_placement(numa_placement),
                                                                                                                                                                                      _rb_block_if_empty_time("Ring Buffer Block IF Empty Time"),
                                                                                                                                                                                      _rb_block_if_full_time("Ring Buffer Block IF Full Time") {
     try {
@@ -197,6 +201,9 @@ MasterGraph::run() {
     if (no_more_processed_data()) {
         return MasterGraph::Status::NO_MORE_DATA;
     }
+    // The ring buffer already holds batches of the next epoch, they are given out once reset() is called
+    if (_continuous_epochs && remaining_count() < (_is_sequence_reader_output ? _sequence_batch_size : _user_batch_size))
+        return MasterGraph::Status::NO_MORE_DATA;
 
     _rb_block_if_empty_time.start();
     _ring_buffer.block_if_empty();  // wait here if the user thread (caller of this function) is faster in consuming the processed images compare to th output routine in producing them
@@ -206,6 +213,7 @@ MasterGraph::run() {
         // calling run pops the processed images that have been used by user, when user calls run() for the first time
         // they've not used anything yet, so we don't pop a batch from the _ring_buffer
         _first_run = false;
+        _autotune_window_start = std::chrono::steady_clock::now();
     } else {
         _ring_buffer.pop();  // Pop previously used output images and metadata from the ring buffer
     }
@@ -217,6 +225,8 @@ MasterGraph::run() {
     }
 
     decrease_image_count();
+    if (_autotuner)
+        autotune();
 
     return MasterGraph::Status::OK;
 }
@@ -226,12 +236,49 @@ void MasterGraph::decrease_image_count() {
         _remaining_count -= (_is_sequence_reader_output ? _sequence_batch_size : _user_batch_size);
 }
 
+void MasterGraph::autotune() {
+    if (!_autotuner->batch_done())
+        return;
+    auto window_end = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(window_end - _autotune_window_start).count();
+    _autotune_window_start = window_end;
+    PrefetchAutotuner::Stalls stalls;
+    auto ring_stall_time = _ring_buffer.stall_time();
+    auto loader_stall_time = _loader_module->prefetch_stall_time();
+    stalls.user_wait = ring_stall_time.reader_wait;
+    stalls.output_wait = ring_stall_time.writer_wait;
+    stalls.loader_wait = loader_stall_time.reader_wait;
+    stalls.load_wait = loader_stall_time.writer_wait;
+
+    auto current = _autotuner->current();
+    auto next = _autotuner->update(stalls, elapsed);
+    if (next.ring_depth != current.ring_depth)
+        next.ring_depth = _ring_buffer.set_depth(next.ring_depth);
+    if (next.loader_depth != current.loader_depth) {
+        // Loaders which cannot resize their queue return 0
+        auto loader_depth = _loader_module->resize_prefetch_queue(next.loader_depth);
+        next.loader_depth = loader_depth > 0 ? loader_depth : current.loader_depth;
+    }
+    if (next.decode_threads != current.decode_threads)
+        _loader_module->set_decode_thread_count(next.decode_threads);
+    if (next.graph_threads != current.graph_threads) {
+        _output_thread_count = next.graph_threads;
+        if (_meta_data_graph)
+            _meta_data_graph->set_task_budget(next.graph_threads, _task_priority);
+    }
+    _autotuner->applied(next);
+    if (next.ring_depth != current.ring_depth || next.loader_depth != current.loader_depth ||
+        next.decode_threads != current.decode_threads || next.graph_threads != current.graph_threads)
+        LOG("Autotuner switched to " + PrefetchAutotuner::describe(next))
+}
+
 size_t
 MasterGraph::calculate_cpu_num_threads(size_t shard_count) {
     if (_cpu_num_threads <= 0) {
         const unsigned minimum_cpu_thread_count = 2;
         const unsigned default_smt_count = 2;
-        unsigned thread_count = std::thread::hardware_concurrency();
+        // A pipeline bound to a NUMA node only gets the cores of the node
+        unsigned thread_count = _numa_placement.bound() ? _numa_placement.cpu_count() : std::thread::hardware_concurrency();
         if (thread_count < minimum_cpu_thread_count) {
             thread_count = minimum_cpu_thread_count;
             WRN("hardware_concurrency() call failed, assuming rocAL can run " + TOSTR(thread_count) + " threads")
@@ -239,10 +286,118 @@ MasterGraph::calculate_cpu_num_threads(size_t shard_count) {
         size_t core_count = thread_count / default_smt_count;
         _cpu_num_threads = core_count / shard_count;
     }
+    // The loaders created with this budget start decoding on the task scheduler right away
+    TaskScheduler::instance(_numa_placement.node()).reserve(_cpu_num_threads);
     // Use _cpu_num_threads if user has already passed non-negative num_threads
     return _cpu_num_threads;
 }
 
+void MasterGraph::bypass_identity_nodes() {
+    std::set<Tensor *> output_tensors;
+    for (size_t idx = 0; idx < _internal_tensor_list.size(); idx++)
+        output_tensors.insert(_internal_tensor_list[idx]);
+    std::list<std::shared_ptr<Node>> nodes;
+    size_t bypassed_node_count = 0;
+    for (auto &node : _nodes) {
+        if (!node->always_identity() || node->has_meta_node() || node->_is_ssd || node->input().size() != 1 || node->output().size() != 1 ||
+            !(node->input()[0]->info() == node->output()[0]->info())) {
+            nodes.push_back(node);
+            continue;
+        }
+        auto input = node->input()[0];
+        auto output = node->output()[0];
+        if (output_tensors.find(output) != output_tensors.end() || output->info().type() != TensorInfo::Type::UNKNOWN) {
+            // The output is handed to the user, a copy still fills it
+            auto copy_node = std::make_shared<CopyNode>(node->input(), node->output());
+            copy_node->set_copy_function([](const Node &original) -> std::shared_ptr<Node> { return std::make_shared<CopyNode>(static_cast<const CopyNode &>(original)); });
+            _tensor_map[output] = copy_node;
+            nodes.push_back(copy_node);
+        } else {
+            // The readers of the output read the input instead, the output is never created
+            for (auto &reader : _nodes)
+                reader->replace_input(output, input);
+            _tensor_map.erase(output);
+            _internal_tensors.push_back(output);
+        }
+        bypassed_node_count++;
+    }
+    if (bypassed_node_count > 0)
+        INFO("Bypassed " + TOSTR(bypassed_node_count) + " augmentation nodes whose parameters leave every sample unchanged")
+    _nodes = std::move(nodes);
+}
+
+void MasterGraph::fuse_pointwise_color_nodes() {
+    // An intermediate tensor can only disappear in a fused node if the next node of the chain is its only reader
+    std::map<Tensor *, std::shared_ptr<Node>> readers;
+    std::map<Tensor *, size_t> reader_count;
+    for (auto &node : _nodes)
+        for (auto &tensor : node->input()) {
+            readers[tensor] = node;
+            reader_count[tensor]++;
+        }
+    std::set<Tensor *> output_tensors;
+    for (size_t idx = 0; idx < _internal_tensor_list.size(); idx++)
+        output_tensors.insert(_internal_tensor_list[idx]);
+    auto color_stage = [](const std::shared_ptr<Node> &node) -> PointwiseColorNode * {
+        if (node->input().size() != 1 || node->output().size() != 1 || node->_is_ssd)
+            return nullptr;
+        return dynamic_cast<PointwiseColorNode *>(node.get());
+    };
+
+    std::set<Node *> fused;
+    std::list<std::shared_ptr<Node>> nodes;
+    size_t fused_node_count = 0;
+    for (auto &node : _nodes) {
+        if (fused.find(node.get()) != fused.end())
+            continue;
+        auto stage = color_stage(node);
+        if (!stage) {
+            nodes.push_back(node);
+            continue;
+        }
+        std::vector<std::shared_ptr<Node>> chain = {node};
+        int parts = stage->color_transform_parts();
+        while (true) {
+            auto tensor = chain.back()->output()[0];
+            if (reader_count[tensor] != 1 || output_tensors.find(tensor) != output_tensors.end() ||
+                tensor->info().type() != TensorInfo::Type::UNKNOWN || tensor->info().data_type() != node->input()[0]->info().data_type())
+                break;
+            auto next = readers.at(tensor);
+            auto next_stage = color_stage(next);
+            if (!next_stage)
+                break;
+            // A hue or saturation change commutes with a scaling of the pixels but not with an offset
+            int next_parts = next_stage->color_transform_parts();
+            if ((next_parts & PointwiseColorNode::HUE_SATURATION) && (parts & PointwiseColorNode::OFFSET))
+                break;
+            chain.push_back(next);
+            parts |= next_parts;
+        }
+        if (chain.size() == 1) {
+            nodes.push_back(node);
+            continue;
+        }
+        auto fused_node = std::make_shared<FusedColorNode>(chain.front()->input(), chain.back()->output());
+        fused_node->set_copy_function([](const Node &original) -> std::shared_ptr<Node> { return std::make_shared<FusedColorNode>(static_cast<const FusedColorNode &>(original)); });
+        fused_node->init(chain);
+        for (size_t idx = 0; idx < chain.size(); idx++) {
+            fused.insert(chain[idx].get());
+            // The intermediate tensors are never created, they are released with the other internal tensors
+            if (idx + 1 < chain.size()) {
+                _tensor_map.erase(chain[idx]->output()[0]);
+                _internal_tensors.push_back(chain[idx]->output()[0]);
+            }
+        }
+        _tensor_map[chain.back()->output()[0]] = fused_node;
+        nodes.push_back(fused_node);
+        fused_node_count++;
+        LOG("Fused a chain of " + TOSTR(chain.size()) + " pointwise color nodes")
+    }
+    if (fused_node_count > 0)
+        INFO("Fused the pointwise color nodes of the graph into " + TOSTR(fused_node_count) + " nodes, " + TOSTR(_nodes.size()) + " nodes reduced to " + TOSTR(nodes.size()))
+    _nodes = std::move(nodes);
+}
+
 void MasterGraph::create_single_graph() {
     // Actual graph creating and calls into adding nodes to graph is deferred and is happening here to enable potential future optimizations
     _graph = std::make_shared<Graph>(_context, _affinity, 0, _cpu_num_threads, _gpu_id);
@@ -258,18 +413,154 @@ void MasterGraph::create_single_graph() {
     _graph->verify();
 }
 
+void MasterGraph::set_graph_replica_count(size_t replica_count) {
+    if (replica_count == 0)
+        THROW("Graph replica count cannot be zero")
+    // The loader keeps the buffers of the batches processed concurrently, it has to know their count when it's created
+    if (_loader_module)
+        THROW("Graph replica count must be set before the loader is created")
+    _graph_replica_count = replica_count;
+}
+
+size_t MasterGraph::usable_graph_replica_count() {
+    if (_graph_replica_count <= 1 || _nodes.empty())
+        return 1;
+    std::string reason;
+    if (_affinity != RocalAffinity::CPU)
+        reason = "they are only supported with the CPU affinity";
+    else if (_meta_data_graph)
+        reason = "the metadata is augmented by the graph nodes";
+    else if (_is_sequence_reader_output)
+        reason = "they are not supported with sequences";
+    else if (std::any_of(_nodes.begin(), _nodes.end(), [](const std::shared_ptr<Node> &node) { return !node->is_replicable(); }))
+        reason = "the graph has nodes that cannot be replicated";
+    for (auto &root_node : _root_nodes)
+        for (auto &tensor : root_node->output())
+            if (!tensor->info().is_image())
+                reason = "they are only supported with image loaders";
+    if (!reason.empty()) {
+        WRN("Running a single graph instead of " + TOSTR(_graph_replica_count) + " replicas, " + reason)
+        return 1;
+    }
+    // A reserved ring buffer slot is needed for each batch being processed
+    if (_graph_replica_count > _prefetch_queue_depth - 1) {
+        WRN("The prefetch queue depth " + TOSTR(_prefetch_queue_depth) + " allows only " + TOSTR(_prefetch_queue_depth - 1) + " graph replicas")
+        return std::max(_prefetch_queue_depth - 1, static_cast<size_t>(1));
+    }
+    return _graph_replica_count;
+}
+
+void MasterGraph::create_graph_replicas(size_t replica_count, size_t cpu_num_threads) {
+    // The nodes added by the user are never created, each replica runs copies of them over its own tensors. That leaves
+    // the loader output tensors to the loader, which swaps in the next batch while the previous ones are still processed
+    for (auto &node : _nodes)
+        for (auto &tensor : node->output())
+            if (tensor->info().type() == TensorInfo::Type::UNKNOWN)
+                _internal_tensors.push_back(tensor);
+
+    for (size_t replica_idx = 0; replica_idx < replica_count; replica_idx++) {
+        auto replica = std::make_unique<GraphReplica>();
+        replica->graph = std::make_shared<Graph>(_context, _affinity, 0, cpu_num_threads, _gpu_id);
+        std::map<Tensor *, Tensor *> replica_tensors;
+        std::map<unsigned *, Tensor *> roi_owners;  // Tensors created from the info of another one share its ROI, their replicas have to share it too
+        auto replicate_tensor = [&](Tensor *tensor) {
+            if (replica_tensors.find(tensor) != replica_tensors.end())
+                return;
+            auto copy = new Tensor(tensor->info());
+            unsigned *roi = tensor->info().roi().get_ptr();
+            auto roi_owner = roi_owners.find(roi);
+            if (roi_owner != roi_owners.end()) {
+                copy->set_roi(roi_owner->second->info().roi().get_ptr());
+            } else {
+                copy->reset_tensor_roi();
+                roi_owners.emplace(roi, copy);
+            }
+            int status;
+            if (tensor->info().type() == TensorInfo::Type::HANDLE)
+                status = copy->create_from_handle(_context);
+            else if (tensor->info().type() == TensorInfo::Type::REGULAR)
+                status = copy->create(_context);
+            else
+                status = copy->create_virtual(_context, replica->graph->get());
+            if (status != 0)
+                THROW("Creating the replica of a graph tensor failed")
+            _internal_tensors.push_back(copy);
+            replica_tensors.emplace(tensor, copy);
+        };
+        for (auto &node : _nodes) {
+            for (auto &tensor : node->input())
+                replicate_tensor(tensor);
+            for (auto &tensor : node->output())
+                replicate_tensor(tensor);
+        }
+        for (auto &node : _nodes) {
+            auto replica_node = node->replicate(replica_tensors);
+            replica_node->create(replica->graph);
+            replica->nodes.push_back(replica_node);
+        }
+        replica->graph->verify();
+        for (size_t idx = 0; idx < _internal_tensor_list.size(); idx++)
+            replica->output_tensors.push_back(replica_tensors.at(_internal_tensor_list[idx]));
+        for (auto &root_node : _root_nodes)
+            for (auto &tensor : root_node->output())
+                if (replica_tensors.find(tensor) != replica_tensors.end())
+                    replica->loader_tensors.emplace_back(tensor, replica_tensors.at(tensor));
+        _graph_replicas.push_back(std::move(replica));
+    }
+    for (size_t replica_idx = 0; replica_idx < _graph_replicas.size(); replica_idx++)
+        _graph_replicas[replica_idx]->stage = std::make_unique<ExecutionStage>("Graph Replica " + TOSTR(replica_idx), _numa_placement);
+    INFO("Running " + TOSTR(replica_count) + " graph replicas with " + TOSTR(cpu_num_threads) + " threads each")
+}
+
 MasterGraph::Status
 MasterGraph::build() {
     if (_internal_tensor_list.empty())
         THROW("No output tensors are there, cannot create the pipeline")
 
+    _ring_buffer.set_numa_placement(_numa_placement);
+    if (_autotune && _autotune_memory_cap > 0) {
+        size_t batch_size = 0;
+        for (auto size : _internal_tensor_list.data_size())
+            batch_size += size;
+        _ring_buffer.reserve_depth(std::min(_autotune_memory_cap / 2 / std::max(batch_size, static_cast<size_t>(1)), MAX_AUTOTUNE_RING_DEPTH));
+    }
 #if ENABLE_HIP || ENABLE_OPENCL
     _ring_buffer.init(_mem_type, (void *)_device.resources(), _internal_tensor_list.data_size(), _internal_tensor_list.roi_size());
 #else
     _ring_buffer.init(_mem_type, nullptr, _internal_tensor_list.data_size(), _internal_tensor_list.roi_size());
 #endif
     if (_is_box_encoder) _ring_buffer.initBoxEncoderMetaData(_mem_type, _user_batch_size * _num_anchors * 4 * sizeof(float), _user_batch_size * _num_anchors * sizeof(int));
-    create_single_graph();
+    // The decoders, the metadata processing and the output copies of all the pipelines share the task scheduler's threads
+    TaskScheduler::instance(_numa_placement.node()).reserve(_cpu_num_threads);
+    _output_thread_count = _cpu_num_threads;
+    if (_meta_data_graph)
+        _meta_data_graph->set_task_budget(_cpu_num_threads, _task_priority);
+    if (_autotune) {
+        // The thread budget starts split evenly between the decoders and the output processing, the autotuner moves
+        // threads from one side to the other and each side keeps at least one
+        size_t max_stage_threads = std::max(_cpu_num_threads, static_cast<size_t>(2)) - 1;
+        size_t graph_threads = std::max(_cpu_num_threads / 2, static_cast<size_t>(1));
+        size_t decode_threads = std::max(_cpu_num_threads - graph_threads, static_cast<size_t>(1));
+        PrefetchAutotuner::Settings initial = {_prefetch_queue_depth, _prefetch_queue_depth, decode_threads, graph_threads};
+        // The loader clamps the depth to the room it allocated, the autotuner records the depth it got
+        PrefetchAutotuner::Settings max = {_ring_buffer.max_depth(), std::max(_prefetch_queue_depth, MAX_AUTOTUNE_RING_DEPTH), max_stage_threads, max_stage_threads};
+        if (_loader_module)
+            _loader_module->set_decode_thread_count(decode_threads);
+        _output_thread_count = graph_threads;
+        if (_meta_data_graph)
+            _meta_data_graph->set_task_budget(graph_threads, _task_priority);
+        _autotuner = std::make_unique<PrefetchAutotuner>(_autotune_warmup_batch_count, initial, max);
+        LOG("Autotuning the pipeline from " + PrefetchAutotuner::describe(initial))
+    }
+    bypass_identity_nodes();
+    if (_graph_fusion)
+        fuse_pointwise_color_nodes();
+    auto replica_count = usable_graph_replica_count();
+    // The replicas share the CPU threads the single graph would have used
+    if (replica_count > 1)
+        create_graph_replicas(replica_count, std::max(_cpu_num_threads / replica_count, static_cast<size_t>(1)));
+    else
+        create_single_graph();
     start_processing();
     return Status::OK;
 }
@@ -319,6 +610,22 @@ void MasterGraph::set_output(Tensor *output_tensor) {
 void MasterGraph::release() {
     LOG("MasterGraph release ...")
     stop_processing();
+    size_t identity_sample_count = 0, sample_count = 0;
+    auto count_identity_samples = [&](const std::list<std::shared_ptr<Node>> &nodes) {
+        for (auto &node : nodes) {
+            identity_sample_count += node->identity_sample_count();
+            sample_count += node->sample_count();
+        }
+    };
+    count_identity_samples(_nodes);
+    for (auto &replica : _graph_replicas)
+        count_identity_samples(replica->nodes);
+    if (identity_sample_count > 0)
+        INFO("The augmentation nodes left " + std::to_string(identity_sample_count) + " of the " + std::to_string(sample_count) + " samples they processed unchanged")
+    for (auto &replica : _graph_replicas) {
+        replica->stage.reset();
+        replica->nodes.clear();
+    }
     _nodes.clear();
     _root_nodes.clear();
     _meta_data_nodes.clear();
@@ -350,6 +657,9 @@ void MasterGraph::release() {
 
     if (_graph != nullptr)
         _graph->release();
+    for (auto &replica : _graph_replicas)
+        replica->graph->release();
+    _graph_replicas.clear();
     if (_meta_data_reader != nullptr)
         _meta_data_reader->release();
 
@@ -361,17 +671,24 @@ void MasterGraph::release() {
 }
 
 MasterGraph::Status
-MasterGraph::update_node_parameters() {
-    // Randomize random parameters
-    ParameterFactory::instance()->renew_parameters();
+MasterGraph::update_node_parameters(const std::list<std::shared_ptr<Node>> &nodes) {
+    // Randomize random parameters, the values of each sample are drawn from its position so they don't depend on the thread or the replica
+    ParameterFactory::instance()->renew_parameters(_parameter_epoch, _parameter_batch_idx++);
 
     // Apply renewed parameters to VX parameters used in augmentation
-    for (auto &node : _nodes)
+    for (auto &node : nodes)
         node->update_parameters();
 
     return Status::OK;
 }
 
+void MasterGraph::start_next_epoch() {
+    _loader_module->reset();
+    // The batches of the next epoch get the parameter stream a reset() rewinding everything would give them
+    _parameter_epoch++;
+    _parameter_batch_idx = 0;
+}
+
 size_t
 MasterGraph::augmentation_branch_count() {
     return _output_tensor_list.size();
@@ -404,11 +721,34 @@ void MasterGraph::sequence_frame_timestamps(std::vector<std::vector<float>> &seq
 
 MasterGraph::Status
 MasterGraph::reset() {
-    // stop the internal processing thread so that the
-    _processing = false;
-    _ring_buffer.unblock_writer();
-    if (_output_thread.joinable())
+    if (_continuous_epochs && _processing && remaining_count() < (_is_sequence_reader_output ? _sequence_batch_size : _user_batch_size)) {
+        // The user drained the epoch and the output routine is already processing the next one, only the batch used last
+        // is dropped and the count is started over, the routine has moved the parameters to the next epoch already.
+        // A reset in the middle of an epoch rewinds everything as below
+        if (!_first_run)
+            _ring_buffer.pop();
+        _first_run = true;
+        _remaining_count = _epoch_sample_count;
+        return Status::OK;
+    }
+    // Park the output routine, it's woken up from wherever it waits until it acknowledges the request
+    bool parked;
+    {
+        std::unique_lock<std::mutex> lock(_rewind_lock);
+        _rewind_requested = true;
+        _rewind_cond.notify_all();
+        while (!_output_routine_parked && _processing) {
+            _ring_buffer.release_all_blocked_calls();
+            _rewind_cond.wait_for(lock, std::chrono::milliseconds(10));
+        }
+        parked = _output_routine_parked;
+    }
+    // The output routine has stopped on an error, it's started again once the rewind is done
+    if (!parked && _output_thread.joinable())
         _output_thread.join();
+    // The batches still being encoded write to the ring buffer
+    if (_encode_stage)
+        _encode_stage->drain();
     _ring_buffer.reset();
     _sequence_start_framenum_vec.clear();
     _sequence_frame_timestamps_vec.clear();
@@ -418,13 +758,39 @@ MasterGraph::reset() {
         _randombboxcrop_meta_data_reader->release();
     // resetting loader module to start from the beginning of the media and clear it's internal state/buffers
     _loader_module->reset();
+    // The output routine is parked, the batches it renewed the parameters for ahead of the user are dropped
+    _parameter_epoch++;
+    _parameter_batch_idx = 0;
     // restart processing of the images
     _first_run = true;
     _output_routine_finished_processing = false;
-    start_processing();
+    if (parked) {
+        _remaining_count = _epoch_sample_count = _loader_module->remaining_count();
+        {
+            std::unique_lock<std::mutex> lock(_rewind_lock);
+            _rewind_requested = false;
+        }
+        _rewind_cond.notify_all();
+    } else {
+        _rewind_requested = false;
+        start_processing();
+    }
     return Status::OK;
 }
 
+void MasterGraph::park_output_routine() {
+    std::unique_lock<std::mutex> lock(_rewind_lock);
+    _output_routine_parked = true;
+    _rewind_cond.notify_all();
+    _rewind_cond.wait(lock, [this] { return !_rewind_requested || !_processing; });
+    _output_routine_parked = false;
+}
+
+void MasterGraph::wait_for_rewind() {
+    std::unique_lock<std::mutex> lock(_rewind_lock);
+    _rewind_cond.wait(lock, [this] { return _rewind_requested || !_processing; });
+}
+
 size_t
 MasterGraph::remaining_count() {
     if (!_external_source_eos && _external_source_reader)
@@ -446,6 +812,8 @@ Timing
 MasterGraph::timing() {
     Timing t = _loader_module->timing();
     t.process_time += _process_time.get_timing();
+    for (auto &replica : _graph_replicas)
+        t.process_time += replica->process_time.get_timing();
     t.copy_to_output += _convert_time.get_timing();
     t.bb_process_time += _bencode_time.get_timing();
     return t;
@@ -486,6 +854,9 @@ MasterGraph::to_tensor(void *out_ptr, RocalTensorlayout format, float multiplier
         max_roi_height = h;
         max_roi_width = w;
     }
+    if ((output_tensor_info.mem_type() != RocalMemType::HOST || output_mem_type != RocalOutputMemType::ROCAL_MEMCPY_HOST) &&
+        output_data_type != RocalTensorDataType::FP32 && output_data_type != RocalTensorDataType::FP16)
+        THROW("BF16 and UINT8 tensor outputs are only supported in host memory")
 
 #if ENABLE_OPENCL
     if (output_tensor_info.mem_type() == RocalMemType::OCL) {
@@ -618,181 +989,33 @@ MasterGraph::to_tensor(void *out_ptr, RocalTensorlayout format, float multiplier
 #endif
     if ((output_tensor_info.mem_type() == RocalMemType::HOST)) {
         if (output_mem_type == RocalOutputMemType::ROCAL_MEMCPY_HOST) {
-            float multiplier[3] = {multiplier0, multiplier1, multiplier2};
-            float offset[3] = {offset0, offset1, offset2};
+            tensor_conversion::ConvertArgs args;
+            args.src_row_stride = w * c;
+            args.channels = c;
+            args.width = max_roi_width;
+            args.height = max_roi_height;
+            args.dst_layout = format;
+            args.dst_type = output_data_type;
+            args.multiplier[0] = multiplier0;
+            args.multiplier[1] = multiplier1;
+            args.multiplier[2] = multiplier2;
+            args.offset[0] = offset0;
+            args.offset[1] = offset1;
+            args.offset[2] = offset2;
+            args.reverse_channels = reverse_channels;
+            const size_t output_element_size = tensor_conversion::output_element_size(output_data_type);
             size_t dest_buf_offset_start = 0;
 
             auto output_buffers = _ring_buffer.get_read_buffers().first;
-            auto num_threads = _cpu_num_threads * 2;
             for (auto &&out_tensor : output_buffers) {
-                unsigned int single_tensor_size = w * c * h;
-                unsigned int channel_size = max_roi_width * max_roi_height;
-                unsigned int output_single_tensor_size = max_roi_height * max_roi_width * c;
-                unsigned int input_width_stride = w * c;
-#pragma omp parallel for num_threads(num_threads)
-                for (unsigned int batch_count = 0; batch_count < n; batch_count++) {
-                    size_t dest_buf_offset = dest_buf_offset_start + output_single_tensor_size * batch_count;
-                    auto in_buffer = (unsigned char *)out_tensor + single_tensor_size * batch_count;
-
-                    if (format == RocalTensorlayout::NHWC) {
-                        if (output_data_type == RocalTensorDataType::FP32) {
-                            float *output_tensor_32 = static_cast<float *>(out_ptr);
-                            for (unsigned channel_idx = 0; channel_idx < c; channel_idx++) {
-                                for (unsigned i = 0; i < channel_size; i++)
-                                    output_tensor_32[dest_buf_offset + channel_idx + i * c] =
-                                        offset[channel_idx] + multiplier[channel_idx] *
-                                                                  (reverse_channels ? static_cast<float>(in_buffer[i * c + c - channel_idx - 1])
-                                                                                    : static_cast<float>(in_buffer[i * c + channel_idx]));
-                            }
-                        } else if (output_data_type == RocalTensorDataType::FP16) {
-                            half *output_tensor_16 = static_cast<half *>(out_ptr);
-                            for (unsigned channel_idx = 0; channel_idx < c; channel_idx++) {
-                                for (unsigned i = 0; i < channel_size; i++)
-                                    output_tensor_16[dest_buf_offset + channel_idx + i * c] =
-                                        offset[channel_idx] + multiplier[channel_idx] *
-                                                                  (reverse_channels ? (half)(in_buffer[i * c + c - channel_idx - 1])
-                                                                                    : (half)(in_buffer[i * c + channel_idx]));
-                            }
-                        }
-                    }
-                    if (format == RocalTensorlayout::NCHW) {
-                        if (output_data_type == RocalTensorDataType::FP32) {
-                            float *output_tensor_32 = static_cast<float *>(out_ptr);
-                            if (c != 3) {
-                                for (unsigned i = 0; i < channel_size; i++)
-                                    output_tensor_32[dest_buf_offset + i] = offset[0] + multiplier[0] * static_cast<float>(in_buffer[c * i]);
-                            } else {
-#if (ENABLE_SIMD && __AVX2__)
-                                float *B_buf = output_tensor_32 + dest_buf_offset;
-                                float *G_buf = B_buf + channel_size;
-                                float *R_buf = G_buf + channel_size;
-
-                                __m256i mask_B, mask_G, mask_R;
-                                if (reverse_channels) {
-                                    mask_B = avx_pkdMaskR;
-                                    mask_G = avx_pkdMaskG;
-                                    mask_R = avx_pkdMaskB;
-                                } else {
-                                    mask_R = avx_pkdMaskR;
-                                    mask_G = avx_pkdMaskG;
-                                    mask_B = avx_pkdMaskB;
-                                }
-                                __m256 pmul0 = _mm256_set1_ps(multiplier0);
-                                __m256 pmul1 = _mm256_set1_ps(multiplier1);
-                                __m256 pmul2 = _mm256_set1_ps(multiplier2);
-                                __m256 padd0 = _mm256_set1_ps(offset0);
-                                __m256 padd1 = _mm256_set1_ps(offset1);
-                                __m256 padd2 = _mm256_set1_ps(offset2);
-                                uint alignedLength = (max_roi_width & ~7);  // multiple of 8
-
-                                __m256 fR, fG, fB;
-                                for (uint row = 0; row < max_roi_height; row++) {
-                                    unsigned char *in_buffer_row = reinterpret_cast<unsigned char *>(in_buffer) + (row * input_width_stride);
-                                    uint col = 0;
-                                    for (; col < alignedLength; col += 8) {
-                                        __m256i pix0 = _mm256_loadu_si256((const __m256i *)in_buffer_row);
-                                        pix0 = _mm256_permutevar8x32_epi32(pix0, _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6));
-                                        fB = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pix0, mask_R));
-                                        fG = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pix0, mask_G));
-                                        fR = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pix0, mask_B));
-                                        fB = _mm256_fmadd_ps(fB, pmul0, padd0);
-                                        fG = _mm256_fmadd_ps(fG, pmul1, padd1);
-                                        fR = _mm256_fmadd_ps(fR, pmul2, padd2);
-                                        _mm256_storeu_ps(B_buf, fB);
-                                        _mm256_storeu_ps(G_buf, fG);
-                                        _mm256_storeu_ps(R_buf, fR);
-                                        B_buf += 8;
-                                        G_buf += 8;
-                                        R_buf += 8;
-                                        in_buffer_row += 24;
-                                    }
-                                    for (; col < max_roi_width; col++, in_buffer_row += 3) {
-                                        *B_buf++ = (in_buffer_row[0] * multiplier0) + offset0;
-                                        *G_buf++ = (in_buffer_row[1] * multiplier1) + offset1;
-                                        *R_buf++ = (in_buffer_row[2] * multiplier2) + offset1;
-                                    }
-                                }
-#else
-                                for (unsigned channel_idx = 0; channel_idx < c; channel_idx++) {
-                                    for (unsigned i = 0; i < channel_size; i++)
-                                        output_tensor_32[dest_buf_offset + channel_idx * channel_size + i] =
-                                            offset[channel_idx] + multiplier[channel_idx] * (reverse_channels ? static_cast<float>(in_buffer[(c * i + c - channel_idx - 1)]) : static_cast<float>(in_buffer[(c * i + channel_idx)]));
-                                }
-#endif
-                            }
-                        } else if (output_data_type == RocalTensorDataType::FP16) {
-                            half *output_tensor_16 = static_cast<half *>(out_ptr);
-                            if (c != 3) {
-                                for (unsigned i = 0; i < channel_size; i++)
-                                    output_tensor_16[dest_buf_offset + i] = offset[0] + multiplier[0] * (half)in_buffer[c * i];
-                            } else {
-#if (ENABLE_SIMD && __AVX2__)
-                                half *B_buf_16 = output_tensor_16 + dest_buf_offset;
-                                half *G_buf_16 = B_buf_16 + channel_size;
-                                half *R_buf_16 = G_buf_16 + channel_size;
-
-                                __m256i mask_B, mask_G, mask_R;
-                                if (reverse_channels) {
-                                    mask_B = avx_pkdMaskR;
-                                    mask_G = avx_pkdMaskG;
-                                    mask_R = avx_pkdMaskB;
-                                } else {
-                                    mask_R = avx_pkdMaskR;
-                                    mask_G = avx_pkdMaskG;
-                                    mask_B = avx_pkdMaskB;
-                                }
-                                __m256 pmul0 = _mm256_set1_ps(multiplier0);
-                                __m256 pmul1 = _mm256_set1_ps(multiplier1);
-                                __m256 pmul2 = _mm256_set1_ps(multiplier2);
-                                __m256 padd0 = _mm256_set1_ps(offset0);
-                                __m256 padd1 = _mm256_set1_ps(offset1);
-                                __m256 padd2 = _mm256_set1_ps(offset2);
-                                uint alignedLength = (max_roi_width & ~7);  // multiple of 8
-
-                                __m256 fR, fG, fB;
-                                __m128i tempR, tempG, tempB;
-                                for (uint row = 0; row < max_roi_height; row++) {
-                                    unsigned char *in_buffer_row = reinterpret_cast<unsigned char *>(in_buffer) + (row * input_width_stride);
-                                    uint col = 0;
-                                    for (; col < alignedLength; col += 8) {
-                                        __m256i pix0 = _mm256_loadu_si256((const __m256i *)in_buffer_row);
-                                        pix0 = _mm256_permutevar8x32_epi32(pix0, _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6));
-                                        fB = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pix0, mask_R));
-                                        fG = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pix0, mask_G));
-                                        fR = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(pix0, mask_B));
-                                        fB = _mm256_fmadd_ps(fB, pmul0, padd0);
-                                        fG = _mm256_fmadd_ps(fG, pmul1, padd1);
-                                        fR = _mm256_fmadd_ps(fR, pmul2, padd2);
-                                        tempB = _mm256_cvtps_ph(fB, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
-                                        tempG = _mm256_cvtps_ph(fG, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
-                                        tempR = _mm256_cvtps_ph(fR, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
-                                        _mm_storeu_si128((__m128i *)B_buf_16, tempB);
-                                        _mm_storeu_si128((__m128i *)G_buf_16, tempG);
-                                        _mm_storeu_si128((__m128i *)R_buf_16, tempR);
-                                        B_buf_16 += 8;
-                                        G_buf_16 += 8;
-                                        R_buf_16 += 8;
-                                        in_buffer_row += 24;
-                                    }
-                                    for (; col < max_roi_width; col++, in_buffer_row += 3) {
-                                        *B_buf_16++ = (half)(in_buffer_row[0] * multiplier0) + offset0;
-                                        *G_buf_16++ = (half)(in_buffer_row[1] * multiplier1) + offset1;
-                                        *R_buf_16++ = (half)(in_buffer_row[2] * multiplier2) + offset2;
-                                    }
-                                }
-#else
-                                for (unsigned channel_idx = 0; channel_idx < c; channel_idx++) {
-                                    for (unsigned i = 0; i < channel_size; i++)
-                                        output_tensor_16[dest_buf_offset + channel_idx * channel_size + i] =
-                                            offset[channel_idx] + multiplier[channel_idx] *
-                                                                      (reverse_channels ? (half)(in_buffer[(c * i + c - channel_idx - 1)])
-                                                                                        : (half)(in_buffer[(c * i + channel_idx)]));
-                                }
-#endif
-                            }
-                        }
-                    }  // NCHW or NHWC
-                }      // for loop batch
+                size_t single_tensor_size = w * c * h;
+                size_t output_single_tensor_size = max_roi_height * max_roi_width * c;
+                TaskScheduler::instance(_numa_placement.node()).parallel_for(n, _output_thread_count, _task_priority, [&](size_t batch_count, size_t) {
+                    tensor_conversion::ConvertArgs sample_args = args;
+                    sample_args.src = static_cast<unsigned char *>(out_tensor) + single_tensor_size * batch_count;
+                    sample_args.dst = static_cast<unsigned char *>(out_ptr) + (dest_buf_offset_start + output_single_tensor_size * batch_count) * output_element_size;
+                    tensor_conversion::convert(sample_args);
+                });  // for loop batch
 
                 dest_buf_offset_start += single_output_tensor_size;
             }
@@ -884,17 +1107,44 @@ MasterGraph::get_output_tensors() {
     return &_output_tensor_list;
 }
 
+MasterGraph::BorrowedOutput *
+MasterGraph::borrow_output_tensors() {
+    auto read_buffers = _ring_buffer.get_read_buffers();
+    auto borrowed = std::make_unique<BorrowedOutput>();
+    borrowed->lease = _ring_buffer.lend_read_slot();
+    borrowed->device_id = _gpu_id;
+    // Tensors of their own without an OpenVX handle, so they outlive the graph and are not moved to the next slot by get_output_tensors()
+    for (unsigned i = 0; i < _internal_tensor_list.size(); i++) {
+        auto *tensor = new Tensor(_output_tensor_list[i]->info());
+        tensor->set_mem_handle(read_buffers.first[i]);
+        tensor->set_roi(read_buffers.second[i]);
+        borrowed->tensors.push_back(tensor);
+    }
+    return borrowed.release();
+}
+
 void MasterGraph::output_routine() {
+    _numa_placement.bind_current_thread();
     INFO("Output routine started with " + TOSTR(_remaining_count) + " to load");
     try {
         while (_processing) {
+            if (_rewind_requested) {
+                park_output_routine();
+                continue;
+            }
             if (_loader_module->remaining_count() < (_is_sequence_reader_output ? _sequence_batch_size : _user_batch_size)) {
+                // The loader is already loading the next epoch, it's only told the current one is over
+                if (_continuous_epochs) {
+                    start_next_epoch();
+                    continue;
+                }
                 // If the internal process routine ,output_routine(), has finished processing all the images, and last
                 // processed images stored in the _ring_buffer will be consumed by the user when it calls the run() func
                 notify_user_thread();
                 // the following call is required in case the ring buffer is waiting for more data to be loaded and there is no more data to process.
                 _ring_buffer.release_if_empty();
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                // Sleeps till reset() is called or the processing stops
+                wait_for_rewind();
                 continue;
             }
             _rb_block_if_full_time.start();
@@ -907,8 +1157,9 @@ void MasterGraph::output_routine() {
             auto load_ret = _loader_module->load_next();
             if (load_ret != LoaderModuleStatus::OK)
                 THROW("Loader module failed to load next batch of images, status " + TOSTR(load_ret))
-            if (!_processing)
-                break;
+            // The loop is left, or parked when reset() is rewinding, before the batch is processed
+            if (!_processing || _rewind_requested)
+                continue;
             auto full_batch_data_names = _loader_module->get_id();
             auto decode_data_info = _loader_module->get_decode_data_info();
             auto crop_image_info = _loader_module->get_crop_image_info();
@@ -918,17 +1169,17 @@ void MasterGraph::output_routine() {
 
             // meta_data lookup is done before _meta_data_graph->process() is called to have the new meta_data ready for processing
             if (_meta_data_reader)
-                _meta_data_reader->lookup(full_batch_data_names);
+                _meta_data_reader->lookup_indexed(full_batch_data_names, decode_data_info._data_indices);
 
-            if (!_processing)
-                break;
+            if (!_processing || _rewind_requested)
+                continue;
 
             // Swap handles on the output tensor, so that new processed tensor will be written to the a new buffer
             for (size_t idx = 0; idx < _internal_tensor_list.size(); idx++)
                 _internal_tensor_list[idx]->swap_handle(write_output_buffers[idx]);
 
-            if (!_processing)
-                break;
+            if (!_processing || _rewind_requested)
+                continue;
 
             for (auto node : _nodes) {
                 if (node->_is_ssd) {
@@ -936,19 +1187,8 @@ void MasterGraph::output_routine() {
                 }
             }
 
-            update_node_parameters();
-            pMetaDataBatch output_meta_data = nullptr;
-            if (_augmented_meta_data) {
-                output_meta_data = _augmented_meta_data->clone(!_augmentation_metanode);  // copy the data if metadata is not processed by the nodes, else create an empty instance
-                if (_meta_data_graph) {
-                    if (_is_random_bbox_crop) {
-                        _meta_data_graph->update_random_bbox_meta_data(_augmented_meta_data, output_meta_data, decode_data_info, crop_image_info);
-                    } else {
-                        _meta_data_graph->update_meta_data(_augmented_meta_data, decode_data_info);
-                    }
-                    _meta_data_graph->process(_augmented_meta_data, output_meta_data);
-                }
-            }
+            update_node_parameters(_nodes);
+            pMetaDataBatch output_meta_data = process_meta_data(decode_data_info, crop_image_info);
             _process_time.start();
             _graph->process();
             _process_time.end();
@@ -956,28 +1196,246 @@ void MasterGraph::output_routine() {
             auto write_roi_buffers = write_buffers.second;   // Obtain ROI buffers from ring buffer
             for (size_t idx = 0; idx < _internal_tensor_list.size(); idx++)
                 _internal_tensor_list[idx]->copy_roi(write_roi_buffers[idx]);   // Copy ROI from internal tensor's buffer to ring buffer
-            _bencode_time.start();
-            if (_is_box_encoder) {
-                auto bbox_encode_write_buffers = _ring_buffer.get_box_encode_write_buffers();
+#ifdef ROCAL_VIDEO
+            _sequence_start_framenum_vec.insert(_sequence_start_framenum_vec.begin(), _loader_module->get_sequence_start_frame_number());
+            _sequence_frame_timestamps_vec.insert(_sequence_frame_timestamps_vec.begin(), _loader_module->get_sequence_frame_timestamps());
+#endif
+            encode_and_push(full_batch_data_names, output_meta_data);
+        }
+    } catch (const std::exception &e) {
+        ERR("Exception thrown in the process routine: " + STR(e.what()) + STR("\n"));
+        _processing = false;
+        _ring_buffer.release_all_blocked_calls();
+    }
+}
+
+pMetaDataBatch MasterGraph::process_meta_data(const DecodedDataInfo &decode_data_info, const CropImageInfo &crop_image_info) {
+    pMetaDataBatch output_meta_data = nullptr;
+    if (_augmented_meta_data) {
+        output_meta_data = recycled_output_meta_data();
+        _augmented_meta_data->clone_into(*output_meta_data, !_augmentation_metanode);  // copy the data if metadata is not processed by the nodes, else only the info
+        if (_meta_data_graph) {
+            if (_is_random_bbox_crop) {
+                _meta_data_graph->update_random_bbox_meta_data(_augmented_meta_data, output_meta_data, decode_data_info, crop_image_info);
+            } else {
+                _meta_data_graph->update_meta_data(_augmented_meta_data, decode_data_info);
+            }
+            _meta_data_graph->process(_augmented_meta_data, output_meta_data);
+        }
+    }
+    return output_meta_data;
+}
+
+pMetaDataBatch MasterGraph::recycled_output_meta_data() {
+    // Only called from one thread at a time, the output routine or the metadata stage
+    for (auto &meta_data : _output_meta_data_pool) {
+        if (meta_data.use_count() == 1) {
+            std::atomic_thread_fence(std::memory_order_acquire);  // Pairs with the release of the last other reference
+            return meta_data;
+        }
+    }
+    _output_meta_data_pool.push_back(_augmented_meta_data->clone(false));
+    return _output_meta_data_pool.back();
+}
+
+void MasterGraph::encode_and_push(ImageNameBatch names, pMetaDataBatch output_meta_data) {
+    _bencode_time.start();
+    if (_is_box_encoder) {
+        auto bbox_encode_write_buffers = _ring_buffer.get_box_encode_write_buffers();
 #if ENABLE_HIP
-                if (_mem_type == RocalMemType::HIP) {
-                    // get bbox encoder read buffers
-                    if (_box_encoder_gpu) _box_encoder_gpu->Run(output_meta_data, (float *)bbox_encode_write_buffers.first, (int *)bbox_encode_write_buffers.second);
-                } else
+        if (_mem_type == RocalMemType::HIP) {
+            // get bbox encoder read buffers
+            if (_box_encoder_gpu) _box_encoder_gpu->Run(output_meta_data, (float *)bbox_encode_write_buffers.first, (int *)bbox_encode_write_buffers.second);
+        } else
 #endif
-                    _meta_data_graph->update_box_encoder_meta_data(&_anchors, output_meta_data, _criteria, _offset, _scale, _means, _stds, (float *)bbox_encode_write_buffers.first, (int *)bbox_encode_write_buffers.second);
+            _meta_data_graph->update_box_encoder_meta_data(&_anchors, output_meta_data, _criteria, _offset, _scale, _means, _stds, (float *)bbox_encode_write_buffers.first, (int *)bbox_encode_write_buffers.second);
+    }
+    if (_is_box_iou_matcher) {
+        int *matches_write_buffer = reinterpret_cast<int *>(_ring_buffer.get_meta_write_buffers()[2]);
+        _meta_data_graph->update_box_iou_matcher(_iou_matcher_info, matches_write_buffer, output_meta_data);
+    }
+    _bencode_time.end();
+    _ring_buffer.set_meta_data(names, output_meta_data);
+    _ring_buffer.push();  // The data and metadata is now stored in output the ring_buffer, increases it's level by 1
+}
+
+void MasterGraph::pipelined_output_routine() {
+    _numa_placement.bind_current_thread();
+    INFO("Pipelined output routine started with " + TOSTR(_remaining_count) + " to load");
+    try {
+        while (_processing) {
+            if (_rewind_requested) {
+                park_output_routine();
+                continue;
+            }
+            if (_loader_module->remaining_count() < (_is_sequence_reader_output ? _sequence_batch_size : _user_batch_size)) {
+                if (_continuous_epochs) {
+                    start_next_epoch();
+                    continue;
+                }
+                // The batches still being encoded have to be in the ring buffer before the user is told there is no more data
+                _encode_stage->drain();
+                notify_user_thread();
+                _ring_buffer.release_if_empty();
+                wait_for_rewind();
+                continue;
             }
-            if (_is_box_iou_matcher) {
-                int *matches_write_buffer = reinterpret_cast<int *>(_ring_buffer.get_meta_write_buffers()[2]);
-                _meta_data_graph->update_box_iou_matcher(_iou_matcher_info, matches_write_buffer, output_meta_data);
+            _rb_block_if_full_time.start();
+            // Reserves the slot following the ones of the batches still being encoded, blocks until the user frees space in the ring_buffer
+            auto write_buffers = _ring_buffer.reserve_write_buffers();
+            auto write_output_buffers = write_buffers.first;
+            _rb_block_if_full_time.end();
+
+            auto load_ret = _loader_module->load_next();
+            if (load_ret != LoaderModuleStatus::OK)
+                THROW("Loader module failed to load next batch of images, status " + TOSTR(load_ret))
+            if (!_processing || _rewind_requested)
+                continue;
+            auto full_batch_data_names = _loader_module->get_id();
+            auto decode_data_info = _loader_module->get_decode_data_info();
+            auto crop_image_info = _loader_module->get_crop_image_info();
+
+            if (full_batch_data_names.size() != _user_batch_size)
+                WRN("Master Graph: Names count does not equal batch_size" + TOSTR(full_batch_data_names.size()))
+
+            if (_meta_data_reader)
+                _meta_data_reader->lookup_indexed(full_batch_data_names, decode_data_info._data_indices);
+
+            if (!_processing || _rewind_requested)
+                continue;
+
+            for (size_t idx = 0; idx < _internal_tensor_list.size(); idx++)
+                _internal_tensor_list[idx]->swap_handle(write_output_buffers[idx]);
+
+            for (auto node : _nodes) {
+                if (node->_is_ssd) {
+                    node->set_meta_data(_augmented_meta_data);
+                }
             }
-            _bencode_time.end();
+
+            // The node parameters and the input tensor handle are shared by consecutive batches, so the metadata of a batch
+            // is processed while the graph runs on the same batch, and its encoding overlaps the next batch
+            update_node_parameters(_nodes);
+            // The job keeps its own copies in case this loop is left by an exception while the job still runs
+            auto output_meta_data = std::make_shared<pMetaDataBatch>();
+            auto meta_data_done = _meta_data_stage->submit([this, output_meta_data, decode_data_info, crop_image_info] {
+                *output_meta_data = process_meta_data(decode_data_info, crop_image_info);
+            });
+
+            _process_time.start();
+            _graph->process();
+            _process_time.end();
+
+            auto write_roi_buffers = write_buffers.second;
+            for (size_t idx = 0; idx < _internal_tensor_list.size(); idx++)
+                _internal_tensor_list[idx]->copy_roi(write_roi_buffers[idx]);
+            meta_data_done.get();
 #ifdef ROCAL_VIDEO
             _sequence_start_framenum_vec.insert(_sequence_start_framenum_vec.begin(), _loader_module->get_sequence_start_frame_number());
             _sequence_frame_timestamps_vec.insert(_sequence_frame_timestamps_vec.begin(), _loader_module->get_sequence_frame_timestamps());
 #endif
-            _ring_buffer.set_meta_data(full_batch_data_names, output_meta_data);
-            _ring_buffer.push();  // The data and metadata is now stored in output the ring_buffer, increases it's level by 1
+            _encode_stage->submit([this, names = std::move(full_batch_data_names), meta_data = *output_meta_data]() mutable {
+                try {
+                    encode_and_push(std::move(names), meta_data);
+                } catch (const std::exception &e) {
+                    ERR("Exception thrown in the encode stage: " + STR(e.what()) + STR("\n"));
+                    _processing = false;
+                    _ring_buffer.release_all_blocked_calls();
+                }
+            });
+        }
+    } catch (const std::exception &e) {
+        ERR("Exception thrown in the process routine: " + STR(e.what()) + STR("\n"));
+        _processing = false;
+        _ring_buffer.release_all_blocked_calls();
+    }
+}
+
+void MasterGraph::replicated_output_routine() {
+    _numa_placement.bind_current_thread();
+    INFO("Replicated output routine started with " + TOSTR(_remaining_count) + " to load");
+    size_t next_replica = 0;
+    try {
+        while (_processing) {
+            if (_rewind_requested) {
+                park_output_routine();
+                continue;
+            }
+            if (_loader_module->remaining_count() < _user_batch_size) {
+                if (_continuous_epochs) {
+                    start_next_epoch();
+                    continue;
+                }
+                // The batches still being processed have to be in the ring buffer before the user is told there is no more data
+                _encode_stage->drain();
+                notify_user_thread();
+                _ring_buffer.release_if_empty();
+                wait_for_rewind();
+                continue;
+            }
+            auto &replica = *_graph_replicas[next_replica];
+            next_replica = (next_replica + 1) % _graph_replicas.size();
+            // The tensors of the replica can only be given a new batch once it processed the one it got a round ago
+            if (replica.done.valid())
+                replica.done.wait();
+            if (!_processing || _rewind_requested)
+                continue;
+
+            _rb_block_if_full_time.start();
+            auto write_buffers = _ring_buffer.reserve_write_buffers();
+            auto write_output_buffers = write_buffers.first;
+            _rb_block_if_full_time.end();
+
+            // The loader keeps the buffers of the batches still being processed by the other replicas untouched
+            auto load_ret = _loader_module->load_next();
+            if (load_ret != LoaderModuleStatus::OK)
+                THROW("Loader module failed to load next batch of images, status " + TOSTR(load_ret))
+            if (!_processing || _rewind_requested)
+                continue;
+            auto full_batch_data_names = _loader_module->get_id();
+            auto decode_data_info = _loader_module->get_decode_data_info();
+            auto crop_image_info = _loader_module->get_crop_image_info();
+
+            if (full_batch_data_names.size() != _user_batch_size)
+                WRN("Master Graph: Names count does not equal batch_size" + TOSTR(full_batch_data_names.size()))
+
+            if (_meta_data_reader)
+                _meta_data_reader->lookup_indexed(full_batch_data_names, decode_data_info._data_indices);
+
+            if (!_processing || _rewind_requested)
+                continue;
+
+            for (auto &loader_tensor : replica.loader_tensors) {
+                if (loader_tensor.second->swap_handle(loader_tensor.first->buffer()) != 0)
+                    THROW("Swapping the loaded batch into a graph replica failed")
+                loader_tensor.first->copy_roi(loader_tensor.second->info().roi().get_ptr());
+            }
+            for (size_t idx = 0; idx < replica.output_tensors.size(); idx++)
+                replica.output_tensors[idx]->swap_handle(write_output_buffers[idx]);
+
+            // The parameters are drawn here in batch order, so the replicas get the same sequence a single graph would
+            update_node_parameters(replica.nodes);
+            pMetaDataBatch output_meta_data = process_meta_data(decode_data_info, crop_image_info);
+
+            auto write_roi_buffers = write_buffers.second;
+            auto graph_done = replica.stage->submit([&replica, write_roi_buffers] {
+                replica.process_time.start();
+                replica.graph->process();
+                replica.process_time.end();
+                for (size_t idx = 0; idx < replica.output_tensors.size(); idx++)
+                    replica.output_tensors[idx]->copy_roi(write_roi_buffers[idx]);
+            });
+            replica.done = graph_done.share();
+            _encode_stage->submit([this, graph_done = replica.done, names = std::move(full_batch_data_names), output_meta_data]() mutable {
+                try {
+                    graph_done.get();
+                    encode_and_push(std::move(names), output_meta_data);
+                } catch (const std::exception &e) {
+                    ERR("Exception thrown in the graph replica: " + STR(e.what()) + STR("\n"));
+                    _processing = false;
+                    _ring_buffer.release_all_blocked_calls();
+                }
+            });
         }
     } catch (const std::exception &e) {
         ERR("Exception thrown in the process routine: " + STR(e.what()) + STR("\n"));
@@ -988,8 +1446,26 @@ void MasterGraph::output_routine() {
 
 void MasterGraph::start_processing() {
     _processing = true;
-    _remaining_count = _loader_module->remaining_count();
-    _output_thread = std::thread(&MasterGraph::output_routine, this);
+    _remaining_count = _epoch_sample_count = _loader_module->remaining_count();
+    if (_continuous_epochs && (_loop || _external_source_reader || _epoch_sample_count < static_cast<int>(_is_sequence_reader_output ? _sequence_batch_size : _user_batch_size))) {
+        WRN("Continuous epochs are not used, the pipeline loops over the data, reads an external source or has less than a batch per epoch")
+        _continuous_epochs = false;
+    }
+    _loader_module->set_continuous_epochs(_continuous_epochs);
+    if (_graph_replicas.size() > 1) {
+        // The encode stage pushes the batches to the ring buffer in order, whichever replica finishes first
+        if (!_encode_stage)
+            _encode_stage = std::make_unique<ExecutionStage>("BoxEncoder Stage", _numa_placement);
+        _output_thread = std::thread(&MasterGraph::replicated_output_routine, this);
+    } else if (_pipelined_execution) {
+        if (!_meta_data_stage)
+            _meta_data_stage = std::make_unique<ExecutionStage>("MetaData Stage", _numa_placement);
+        if (!_encode_stage)
+            _encode_stage = std::make_unique<ExecutionStage>("BoxEncoder Stage", _numa_placement);
+        _output_thread = std::thread(&MasterGraph::pipelined_output_routine, this);
+    } else {
+        _output_thread = std::thread(&MasterGraph::output_routine, this);
+    }
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
 #else
 //  Changing thread scheduling policy and it's priority does not help on latest Ubuntu builds
@@ -1006,11 +1482,17 @@ void MasterGraph::start_processing() {
 }
 
 void MasterGraph::stop_processing() {
-    _processing = false;
-    _ring_buffer.unblock_reader();
-    _ring_buffer.unblock_writer();
+    {
+        std::unique_lock<std::mutex> lock(_rewind_lock);
+        _processing = false;
+    }
+    _rewind_cond.notify_all();
+    // The writer may wait for a slot the user still borrows
+    _ring_buffer.release_all_blocked_calls();
     if (_output_thread.joinable())
         _output_thread.join();
+    if (_encode_stage)
+        _encode_stage->drain();
 }
 
 std::vector<rocalTensorList *> MasterGraph::create_coco_meta_data_reader(const char *source_path, bool is_output, MetaDataReaderType reader_type, MetaDataType metadata_type, bool ltrb_bbox, bool is_box_encoder, bool avoid_class_remapping, bool aspect_ratio_grouping, bool is_box_iou_matcher, float sigma, unsigned pose_output_width, unsigned pose_output_height) {
@@ -1139,6 +1621,7 @@ std::vector<rocalTensorList *> MasterGraph::create_label_reader(const char *sour
     if (strlen(source_path) == 0)
         THROW("Source path needs to be provided")
     MetaDataConfig config(MetaDataType::Label, reader_type, source_path);
+    config.set_manifest_dir(_manifest_dir);
     _meta_data_reader = create_meta_data_reader(config, _augmented_meta_data);
     _meta_data_reader->read_all(source_path);
 
@@ -1475,127 +1958,34 @@ MasterGraph::copy_out_tensor_planar(void *out_ptr, RocalTensorlayout format, flo
     if (output_tensor_info.mem_type() == RocalMemType::OCL || output_tensor_info.mem_type() == RocalMemType::HIP) {
         THROW("copy_out_tensor_planar for GPU affinity is not implemented")
     } else if (output_tensor_info.mem_type() == RocalMemType::HOST) {
-        float multiplier[3] = {multiplier0, multiplier1, multiplier2};
-        float offset[3] = {offset0, offset1, offset2};
+        tensor_conversion::ConvertArgs args;
+        args.src_row_stride = w;
+        args.src_plane_stride = w * h;
+        args.channels = c;
+        args.width = w;
+        args.height = h;
+        args.dst_layout = format;
+        args.dst_type = output_data_type;
+        args.multiplier[0] = multiplier0;
+        args.multiplier[1] = multiplier1;
+        args.multiplier[2] = multiplier2;
+        args.offset[0] = offset0;
+        args.offset[1] = offset1;
+        args.offset[2] = offset2;
+        args.reverse_channels = reverse_channels;
+        const size_t output_element_size = tensor_conversion::output_element_size(output_data_type);
         size_t dest_buf_offset = 0;
 
         auto output_buffers = _ring_buffer.get_read_buffers().first;
 
         for (auto &&out_tensor : output_buffers) {
-            for (unsigned batch = 0; batch < n; batch++) {
+            TaskScheduler::instance(_numa_placement.node()).parallel_for(n, _output_thread_count, _task_priority, [&](size_t batch, size_t) {
                 const size_t batch_offset = w * h * c * batch;
-                auto channel_size = w * h;
-                auto in_buffer = (unsigned char *)out_tensor + batch_offset;
-                if (format == RocalTensorlayout::NHWC) {
-                    if (output_data_type == RocalTensorDataType::FP32) {
-                        float *output_tensor_32 = static_cast<float *>(out_ptr) + batch_offset;
-                        for (unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                            for (unsigned i = 0; i < channel_size; i++)
-                                output_tensor_32[dest_buf_offset + channel_idx + i * c] =
-                                    offset[channel_idx] + multiplier[channel_idx] *
-                                                              (reverse_channels ? static_cast<float>(in_buffer[i +
-                                                                                                               (c - channel_idx -
-                                                                                                                1) *
-                                                                                                                   channel_size])
-                                                                                : static_cast<float>(in_buffer[i + channel_idx *
-                                                                                                                       channel_size]));
-                    } else if (output_data_type == RocalTensorDataType::FP16) {
-                        half *output_tensor_16 = static_cast<half *>(out_ptr) + batch_offset;
-                        for (unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                            for (unsigned i = 0; i < channel_size; i++)
-                                output_tensor_16[dest_buf_offset + channel_idx + i * c] =
-                                    offset[channel_idx] + multiplier[channel_idx] *
-                                                              (reverse_channels ? static_cast<half>(in_buffer[(c - channel_idx - 1) * channel_size + i])
-                                                                                : static_cast<half>(in_buffer[channel_idx * channel_size + i]));
-                    }
-                }
-                if (format == RocalTensorlayout::NCHW) {
-                    if (output_data_type == RocalTensorDataType::FP32) {
-                        float *output_tensor_32 = static_cast<float *>(out_ptr) + batch_offset;
-                        // output_tensor_32 += batch_offset;
-                        if (c != 3) {
-                            for (unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                                for (unsigned i = 0; i < channel_size; i++)
-                                    output_tensor_32[dest_buf_offset + channel_idx * channel_size + i] =
-                                        offset[channel_idx] + multiplier[channel_idx] *
-                                                                  (reverse_channels ? (float)(in_buffer[(c - channel_idx - 1) * channel_size + i])
-                                                                                    : (float)(in_buffer[channel_idx * channel_size + i]));
-                        } else {
-#if (ENABLE_SIMD && __AVX2__)
-
-                            float *B_buf = output_tensor_32 + dest_buf_offset;
-                            float *G_buf = B_buf + channel_size;
-                            float *R_buf = G_buf + channel_size;
-                            unsigned char *in_buffer_R = in_buffer;
-                            unsigned char *in_buffer_G = in_buffer + channel_size;
-                            unsigned char *in_buffer_B = in_buffer_G + channel_size;
-
-                            __m256 pmul0 = _mm256_set1_ps(multiplier0);
-                            __m256 pmul1 = _mm256_set1_ps(multiplier1);
-                            __m256 pmul2 = _mm256_set1_ps(multiplier2);
-                            __m256 padd0 = _mm256_set1_ps(offset0);
-                            __m256 padd1 = _mm256_set1_ps(offset1);
-                            __m256 padd2 = _mm256_set1_ps(offset2);
-                            unsigned int alignedLength = (channel_size & ~7);  // multiple of 8
-                            unsigned int i = 0;
-
-                            __m256 fR, fG, fB;
-                            for (; i < alignedLength; i += 8) {
-                                __m128i pixR, pixG, pixB;
-                                if (reverse_channels) {
-                                    pixB = _mm_loadl_epi64((const __m128i *)in_buffer_R);
-                                    pixG = _mm_loadl_epi64((const __m128i *)in_buffer_G);
-                                    pixR = _mm_loadl_epi64((const __m128i *)in_buffer_B);
-                                } else {
-                                    pixR = _mm_loadl_epi64((const __m128i *)in_buffer_R);
-                                    pixG = _mm_loadl_epi64((const __m128i *)in_buffer_G);
-                                    pixB = _mm_loadl_epi64((const __m128i *)in_buffer_B);
-                                }
-                                fB = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(pixR));
-                                fG = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(pixG));
-                                fR = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(pixB));
-                                fB = _mm256_mul_ps(fB, pmul0);
-                                fG = _mm256_mul_ps(fG, pmul1);
-                                fR = _mm256_mul_ps(fR, pmul2);
-                                fB = _mm256_add_ps(fB, padd0);
-                                fG = _mm256_add_ps(fG, padd1);
-                                fR = _mm256_add_ps(fR, padd2);
-                                _mm256_storeu_ps(B_buf, fB);
-                                _mm256_storeu_ps(G_buf, fG);
-                                _mm256_storeu_ps(R_buf, fR);
-                                B_buf += 8;
-                                G_buf += 8;
-                                R_buf += 8;
-                                in_buffer_R += 8, in_buffer_G += 8, in_buffer_B += 8;
-                            }
-                            for (; i < channel_size; i++) {
-                                *B_buf++ = (*in_buffer_R++ * multiplier0) + offset0;
-                                *G_buf++ = (*in_buffer_G++ * multiplier1) + offset1;
-                                *R_buf++ = (*in_buffer_B++ * multiplier2) + offset1;
-                            }
-
-#else
-                                for (unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                                    for (unsigned i = 0; i < channel_size; i++)
-                                        output_tensor_32[dest_buf_offset + channel_idx * channel_size + i] =
-                                            offset[channel_idx] + multiplier[channel_idx] * (reverse_channels ? (float)(in_buffer[i + (c - channel_idx - 1) * channel_size]) : (float)(in_buffer[i + channel_idx * channel_size]));
-#endif
-                        }
-                    } else if (output_data_type == RocalTensorDataType::FP16) {
-                        half *output_tensor_16 = static_cast<half *>(out_ptr) + batch_offset;
-                        for (unsigned channel_idx = 0; channel_idx < c; channel_idx++)
-                            for (unsigned i = 0; i < channel_size; i++)
-                                output_tensor_16[dest_buf_offset + channel_idx * channel_size + i] =
-                                    offset[channel_idx] + multiplier[channel_idx] *
-                                                              (reverse_channels ? (half)(in_buffer[i +
-                                                                                                   (c - channel_idx -
-                                                                                                    1) *
-                                                                                                       channel_size])
-                                                                                : (half)(in_buffer[i + channel_idx *
-                                                                                                           channel_size]));
-                    }
-                }
-            }
+                tensor_conversion::ConvertArgs sample_args = args;
+                sample_args.src = static_cast<unsigned char *>(out_tensor) + batch_offset;
+                sample_args.dst = static_cast<unsigned char *>(out_ptr) + (dest_buf_offset + batch_offset) * output_element_size;
+                tensor_conversion::convert(sample_args);
+            });
             dest_buf_offset += single_output_tensor_size;
         }
     }
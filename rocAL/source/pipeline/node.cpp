@@ -37,4 +37,25 @@ void Node::create(std::shared_ptr<Graph> graph) {
 
 void Node::update_parameters() {
     update_node();
+    // The vx kernels process the whole batch, the samples they leave unchanged are counted to tell how much work the parameters waste
+    for (size_t sample_idx = 0; sample_idx < _batch_size; sample_idx++)
+        if (is_identity(sample_idx))
+            _identity_sample_count++;
+    _sample_count += _batch_size;
+}
+
+std::shared_ptr<Node> Node::replicate(const std::map<Tensor *, Tensor *> &replica_tensors) {
+    if (!is_replicable())
+        THROW("The node cannot be replicated")
+
+    auto replica = _copy(*this);
+    for (auto &tensor : replica->_inputs)
+        tensor = replica_tensors.at(tensor);
+    for (auto &tensor : replica->_outputs)
+        tensor = replica_tensors.at(tensor);
+    // The copy gets its own vx node and parameters once created in the replica graph
+    replica->_node = nullptr;
+    replica->_graph = nullptr;
+    replica->detach_replica_state();
+    return replica;
 }
@@ -0,0 +1,221 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "pipeline/numa_placement.h"
+
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#if ENABLE_HIP
+#include "hip/hip_runtime.h"
+#endif
+
+namespace {
+//! Node the current thread was bound to by NumaPlacement::bind_current_thread()
+thread_local int current_node = -1;
+
+const std::string NODE_SYSFS_PATH = "/sys/devices/system/node/node";
+
+//! Parses a kernel cpulist such as "0-15,32-47" into \p cpus, returns false if it is malformed
+bool parse_cpu_list(const std::string &cpu_list, cpu_set_t &cpus) {
+    CPU_ZERO(&cpus);
+    std::stringstream ranges(cpu_list);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        if (range.empty() || range == "\n")
+            continue;
+        int first, last;
+        auto dash = range.find('-');
+        try {
+            first = std::stoi(range.substr(0, dash));
+            last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+        } catch (std::exception &) {
+            return false;
+        }
+        for (int cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++)
+            CPU_SET(cpu, &cpus);
+    }
+    return CPU_COUNT(&cpus) > 0;
+}
+
+//! Returns the node mask selecting \p node, the last bit of maxnode being ignored by the kernel it is one more than the bits of the mask
+std::vector<unsigned long> node_mask(int node, unsigned long &max_node) {
+    constexpr size_t BITS_PER_MASK_WORD = sizeof(unsigned long) * CHAR_BIT;
+    std::vector<unsigned long> mask(node / BITS_PER_MASK_WORD + 1, 0);
+    mask[node / BITS_PER_MASK_WORD] |= 1UL << (node % BITS_PER_MASK_WORD);
+    max_node = mask.size() * BITS_PER_MASK_WORD + 1;
+    return mask;
+}
+
+size_t page_size() {
+    static const size_t size = sysconf(_SC_PAGESIZE);
+    return size;
+}
+
+//! Largest node mask get_mempolicy is tried with, it fails with EINVAL when the mask is smaller than the nodes the kernel supports
+constexpr unsigned long MAX_MEMPOLICY_NODES = 1 << 16;
+}  // namespace
+
+NumaPlacement NumaPlacement::for_node(int node) {
+    std::ifstream cpu_list_file(NODE_SYSFS_PATH + TOSTR(node) + "/cpulist");
+    std::string cpu_list;
+    if (node < 0 || !cpu_list_file || !std::getline(cpu_list_file, cpu_list))
+        THROW("NUMA node " + TOSTR(node) + " does not exist on this host")
+    NumaPlacement placement;
+    if (!parse_cpu_list(cpu_list, placement._cpus))
+        THROW("NUMA node " + TOSTR(node) + " has no cores, cannot run the pipeline threads on it")
+    placement._node = node;
+    return placement;
+}
+
+NumaPlacement NumaPlacement::for_gpu(int gpu_id) {
+#if ENABLE_HIP
+    char pci_bus_id[64];
+    if (hipDeviceGetPCIBusId(pci_bus_id, sizeof(pci_bus_id), gpu_id) == hipSuccess) {
+        std::string bus_id(pci_bus_id);
+        for (auto &c : bus_id) c = std::tolower(c);  // sysfs names the devices in lower case
+        std::ifstream numa_node_file("/sys/bus/pci/devices/" + bus_id + "/numa_node");
+        int node = -1;
+        if (numa_node_file >> node && node >= 0)
+            return for_node(node);
+    }
+    WRN("Could not find out the NUMA node of GPU " + TOSTR(gpu_id) + ", the pipeline threads and buffers are left unbound")
+#else
+    WRN("NUMA placement local to the GPU needs a HIP backend, the pipeline threads and buffers are left unbound")
+#endif
+    return NumaPlacement();
+}
+
+int NumaPlacement::node_count() {
+    int count = 0;
+    while (std::ifstream(NODE_SYSFS_PATH + TOSTR(count) + "/cpulist"))
+        count++;
+    return std::max(count, 1);
+}
+
+int NumaPlacement::current_thread_node() {
+    return current_node;
+}
+
+void NumaPlacement::bind_current_thread() const {
+    if (!bound())
+        return;
+    auto ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &_cpus);
+    if (ret != 0) {
+        WRN("Unsuccessful in binding thread to NUMA node " + TOSTR(_node) + " err = " + STR(std::strerror(ret)))
+        return;
+    }
+    current_node = _node;
+    set_thread_memory_policy();
+}
+
+void NumaPlacement::set_thread_memory_policy() const {
+    if (!bound())
+        return;
+    // Preferred rather than bound, the thread falls back to the other nodes instead of failing once the node is out of memory
+    unsigned long max_node;
+    auto mask = node_mask(_node, max_node);
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask.data(), max_node) != 0)
+        WRN("Unsuccessful in setting the memory policy of thread to NUMA node " + TOSTR(_node) + " err = " + STR(std::strerror(errno)))
+}
+
+NumaPlacement::MemoryPolicy NumaPlacement::thread_memory_policy() {
+    constexpr unsigned long BITS_PER_MASK_WORD = sizeof(unsigned long) * CHAR_BIT;
+    MemoryPolicy policy;
+    for (unsigned long max_node = BITS_PER_MASK_WORD * 16; max_node <= MAX_MEMPOLICY_NODES; max_node *= 2) {
+        policy.nodes.assign(max_node / BITS_PER_MASK_WORD, 0);
+        if (syscall(SYS_get_mempolicy, &policy.mode, policy.nodes.data(), max_node, nullptr, 0) == 0)
+            return policy;
+        if (errno != EINVAL)
+            break;
+    }
+    WRN("Unsuccessful in reading the memory policy of thread, err = " + STR(std::strerror(errno)) + ", the default policy will be restored")
+    return MemoryPolicy();
+}
+
+void NumaPlacement::restore_thread_memory_policy(const MemoryPolicy &policy) {
+    constexpr unsigned long BITS_PER_MASK_WORD = sizeof(unsigned long) * CHAR_BIT;
+    // The last bit of maxnode is ignored by the kernel, one more than the bits of the mask
+    auto max_node = policy.nodes.empty() ? 0 : policy.nodes.size() * BITS_PER_MASK_WORD + 1;
+    if (syscall(SYS_set_mempolicy, policy.mode, policy.nodes.empty() ? nullptr : policy.nodes.data(), max_node) != 0)
+        WRN("Unsuccessful in restoring the memory policy of thread, err = " + STR(std::strerror(errno)))
+}
+
+void NumaPlacement::place_memory(void *ptr, size_t size) const {
+    if (!bound() || !ptr || size == 0)
+        return;
+    // mbind works on whole pages, the pages the buffer shares with other allocations are left to the policy they were allocated with
+    auto start = (reinterpret_cast<uintptr_t>(ptr) + page_size() - 1) & ~(page_size() - 1);
+    auto end = (reinterpret_cast<uintptr_t>(ptr) + size) & ~(page_size() - 1);
+    unsigned long max_node;
+    auto mask = node_mask(_node, max_node);
+    if (end > start && syscall(SYS_mbind, start, end - start, MPOL_BIND, mask.data(), max_node, MPOL_MF_MOVE) != 0)
+        WRN("Unsuccessful in binding " + TOSTR(size) + " bytes to NUMA node " + TOSTR(_node) + " err = " + STR(std::strerror(errno)))
+    // First touch, so that the pages are allocated now rather than while the first batch is loaded
+    memset(ptr, 0, size);
+}
+
+size_t NumaPlacement::buffer_alignment(size_t min_alignment) const {
+    return bound() ? std::max(min_alignment, page_size()) : min_alignment;
+}
+
+void NumaPlacement::count_pages(const void *ptr, size_t size, std::map<int, size_t> &pages_per_node) {
+    if (!ptr || size == 0)
+        return;
+    auto start = reinterpret_cast<uintptr_t>(ptr) & ~(page_size() - 1);
+    auto end = reinterpret_cast<uintptr_t>(ptr) + size;
+    std::vector<void *> pages;
+    for (auto page = start; page < end; page += page_size())
+        pages.push_back(reinterpret_cast<void *>(page));
+    std::vector<int> status(pages.size(), -1);
+    // With no target nodes move_pages only reports the node of each page
+    if (syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, status.data(), 0) != 0)
+        std::fill(status.begin(), status.end(), -1);
+    for (auto node : status)
+        pages_per_node[node < 0 ? -1 : node]++;
+}
+
+std::string NumaPlacement::describe_pages(const std::map<int, size_t> &pages_per_node) {
+    std::string description;
+    for (auto &node_pages : pages_per_node) {
+        if (!description.empty())
+            description += ", ";
+        description += (node_pages.first < 0 ? std::string("unallocated") : "node " + TOSTR(node_pages.first)) + ": " + TOSTR(node_pages.second) + " pages";
+    }
+    return description.empty() ? "no host pages" : description;
+}
+
+std::string NumaPlacement::description() const {
+    if (!bound())
+        return "unbound";
+    return "NUMA node " + TOSTR(_node) + " (" + TOSTR(cpu_count()) + " cores)";
+}
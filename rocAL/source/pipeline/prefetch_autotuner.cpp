@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "pipeline/prefetch_autotuner.h"
+
+#include <algorithm>
+
+PrefetchAutotuner::PrefetchAutotuner(size_t warmup_batch_count, const Settings &initial, const Settings &max) : _warmup_batch_count(std::max(warmup_batch_count, WARMUP_WINDOW)),
+                                                                                                             _current(initial),
+                                                                                                             _max(max) {
+}
+
+bool PrefetchAutotuner::batch_done() {
+    _batch_count++;
+    _window_batch_count++;
+    size_t window = (_batch_count <= _warmup_batch_count) ? WARMUP_WINDOW : _warmup_batch_count;
+    if (_window_batch_count < window)
+        return false;
+    _window_batch_count = 0;
+    return true;
+}
+
+PrefetchAutotuner::Settings PrefetchAutotuner::update(const Stalls &stalls, long long unsigned elapsed_us) {
+    auto stalled = [&](long long unsigned total, long long unsigned last, double fraction) {
+        return static_cast<double>(total - last) > fraction * std::max(elapsed_us, 1ull);
+    };
+    bool user_starved = stalled(stalls.user_wait, _last.user_wait, STALL_FRACTION);
+    bool user_idle = !stalled(stalls.user_wait, _last.user_wait, STALL_FRACTION / 10);
+    bool output_blocked = stalled(stalls.output_wait, _last.output_wait, STALL_FRACTION);
+    bool loader_starved = stalled(stalls.loader_wait, _last.loader_wait, STALL_FRACTION);
+    bool load_blocked = stalled(stalls.load_wait, _last.load_wait, STALL_FRACTION);
+    _last = stalls;
+
+    Settings next = _current;
+    if (user_starved) {
+        // The pipeline is slower than the user, the stage the other one waits on gets the threads
+        if (loader_starved && !load_blocked) {
+            next.decode_threads++;
+            next.graph_threads--;
+        } else if (!loader_starved) {
+            next.graph_threads++;
+            next.decode_threads--;
+        }
+        // Stalls on both sides of a queue come from bursts, a deeper queue absorbs them
+        if (output_blocked)
+            next.ring_depth++;
+        if (loader_starved && load_blocked)
+            next.loader_depth++;
+    } else if (user_idle) {
+        // The user is the bottleneck, the batches queued beyond what absorbs its jitter only add latency
+        if (output_blocked)
+            next.ring_depth--;
+        if (load_blocked && !loader_starved)
+            next.loader_depth--;
+    }
+    auto clamp = [](size_t value, size_t min, size_t max) { return std::min(std::max(value, min), max); };
+    // Minimum depths let a batch be written while the previous one is read, a loader queue of depth 1 would always be full
+    next.ring_depth = clamp(next.ring_depth, 2, _max.ring_depth);
+    next.loader_depth = clamp(next.loader_depth, 2, _max.loader_depth);
+    next.decode_threads = clamp(next.decode_threads, 1, _max.decode_threads);
+    next.graph_threads = clamp(next.graph_threads, 1, _max.graph_threads);
+    return next;
+}
+
+std::string PrefetchAutotuner::describe(const Settings &settings) {
+    return "ring buffer depth " + TOSTR(settings.ring_depth) + ", loader queue depth " + TOSTR(settings.loader_depth) +
+           ", " + TOSTR(settings.decode_threads) + " decode threads, " + TOSTR(settings.graph_threads) + " output threads";
+}
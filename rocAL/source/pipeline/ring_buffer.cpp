@@ -23,7 +23,40 @@ THE SOFTWARE.
 #include "pipeline/ring_buffer.h"
 #include "device/device_manager.h"
 
-RingBuffer::RingBuffer(unsigned buffer_depth) : BUFF_DEPTH(buffer_depth),
+SlotLeases::SlotLeases(RingBuffer *ring, unsigned slot_count) : _ring(ring),
+                                                                _counts(new std::atomic<unsigned>[slot_count]),
+                                                                _deferred_free(slot_count) {
+    for (unsigned slot = 0; slot < slot_count; slot++)
+        _counts[slot] = 0;
+}
+
+void SlotLeases::release(size_t slot) {
+    std::unique_lock<std::mutex> lock(_lock);
+    if (--_counts[slot] != 0)
+        return;
+    if (_ring) {
+        _ring->slot_returned();
+    } else if (_deferred_free[slot]) {
+        _deferred_free[slot]();
+        _deferred_free[slot] = nullptr;
+    }
+}
+
+bool SlotLeases::defer_free(size_t slot, std::function<void()> free_slot) {
+    std::unique_lock<std::mutex> lock(_lock);
+    if (!lent(slot))
+        return false;
+    _deferred_free[slot] = std::move(free_slot);
+    return true;
+}
+
+void SlotLeases::detach() {
+    std::unique_lock<std::mutex> lock(_lock);
+    _ring = nullptr;
+}
+
+RingBuffer::RingBuffer(unsigned buffer_depth) : _buff_depth(buffer_depth),
+                                                _depth(buffer_depth),
                                                 _dev_sub_buffer(buffer_depth),
                                                 _host_sub_buffers(buffer_depth),
                                                 _dev_roi_buffers(buffer_depth),
@@ -33,22 +66,51 @@ RingBuffer::RingBuffer(unsigned buffer_depth) : BUFF_DEPTH(buffer_depth),
     reset();
 }
 
+void RingBuffer::reserve_depth(unsigned max_buffer_depth) {
+    if (max_buffer_depth <= _buff_depth)
+        return;
+    _buff_depth = max_buffer_depth;
+    _dev_sub_buffer.resize(_buff_depth);
+    _host_sub_buffers.resize(_buff_depth);
+    _dev_roi_buffers.resize(_buff_depth);
+    _host_roi_buffers.resize(_buff_depth);
+    _dev_bbox_buffer.resize(_buff_depth);
+    _dev_labels_buffer.resize(_buff_depth);
+}
+
+unsigned RingBuffer::set_depth(unsigned buffer_depth) {
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        // The ring keeps cycling over all the allocated slots, only the number of them holding processed batches is limited
+        _depth = std::min(std::max(buffer_depth, 2u), _buff_depth);
+    }
+    unblock_writer();
+    return _depth;
+}
+
 void RingBuffer::block_if_empty() {
     std::unique_lock<std::mutex> lock(_lock);
     if (empty()) {  // if the current read buffer is being written wait on it
         if (_dont_block)
             return;
+        // The writer waits for the slot to be returned while the reader waits for the writer
+        if (_reserved == 0 && lent(_write_ptr))
+            THROW("All the output batches are borrowed, at least one of them must be released before reading the next one")
+        auto wait_start = std::chrono::steady_clock::now();
         _wait_for_load.wait(lock);
+        _reader_wait_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - wait_start).count();
     }
 }
 
 void RingBuffer::block_if_full() {
     std::unique_lock<std::mutex> lock(_lock);
     // Write the whole buffer except for the last spot which is being read by the reader thread
-    if (full()) {
+    while (full()) {
         if (_dont_block)
             return;
+        auto wait_start = std::chrono::steady_clock::now();
         _wait_for_unload.wait(lock);
+        _writer_wait_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - wait_start).count();
     }
 }
 
@@ -73,6 +135,30 @@ std::pair<std::vector<void *>, std::vector<unsigned *>> RingBuffer::get_write_bu
     return std::make_pair(_host_sub_buffers[_write_ptr], _host_roi_buffers[_write_ptr]);
 }
 
+std::pair<std::vector<void *>, std::vector<unsigned *>> RingBuffer::reserve_write_buffers() {
+    std::unique_lock<std::mutex> lock(_lock);
+    // Same as full() but also counting the slots already reserved for the batches still being processed
+    auto wait_start = std::chrono::steady_clock::now();
+    while (_level + _reserved >= _depth - 1 || lent((_write_ptr + _reserved) % _buff_depth)) {
+        if (_dont_block)
+            break;
+        _wait_for_unload.wait(lock);
+    }
+    _writer_wait_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - wait_start).count();
+    size_t slot = (_write_ptr + _reserved) % _buff_depth;
+    _reserved++;
+    if ((_mem_type == RocalMemType::OCL) || (_mem_type == RocalMemType::HIP))
+        return std::make_pair(_dev_sub_buffer[slot], _dev_roi_buffers[slot]);
+    return std::make_pair(_host_sub_buffers[slot], _host_roi_buffers[slot]);
+}
+
+std::shared_ptr<SlotLease> RingBuffer::lend_read_slot() {
+    block_if_empty();
+    if (!_leases)
+        THROW("The ring buffer is not initialized")
+    return std::make_shared<SlotLease>(_leases, _read_ptr);
+}
+
 std::pair<void *, void *> RingBuffer::get_box_encode_write_buffers() {
     block_if_full();
     if ((_mem_type == RocalMemType::OCL) || (_mem_type == RocalMemType::HIP))
@@ -110,13 +196,20 @@ void RingBuffer::unblock_writer() {
     _wait_for_unload.notify_all();
 }
 
+void RingBuffer::slot_returned() {
+    // Taking the lock makes sure the writer is either waiting already or sees the slot returned
+    { std::unique_lock<std::mutex> lock(_lock); }
+    _wait_for_unload.notify_all();
+}
+
 void RingBuffer::init(RocalMemType mem_type, void *devres, std::vector<size_t> &sub_buffer_size, std::vector<size_t> &roi_buffer_size) {
     _mem_type = mem_type;
     _dev = devres;
     _sub_buffer_size = sub_buffer_size;
     auto sub_buffer_count = sub_buffer_size.size();
-    if (BUFF_DEPTH < 2)
+    if (_buff_depth < 2)
         THROW("Error internal buffer size for the ring buffer should be greater than one")
+    _leases = std::make_shared<SlotLeases>(this, _buff_depth);
 
 #if ENABLE_OPENCL
     DeviceResources *dev_ocl = static_cast<DeviceResources *>(_dev);
@@ -127,7 +220,7 @@ void RingBuffer::init(RocalMemType mem_type, void *devres, std::vector<size_t> &
 
         cl_int err = CL_SUCCESS;
 
-        for (size_t buffIdx = 0; buffIdx < BUFF_DEPTH; buffIdx++) {
+        for (size_t buffIdx = 0; buffIdx < _buff_depth; buffIdx++) {
             cl_mem_flags flags = CL_MEM_READ_ONLY;
 
             _dev_sub_buffer[buffIdx].resize(sub_buffer_count);
@@ -151,7 +244,8 @@ void RingBuffer::init(RocalMemType mem_type, void *devres, std::vector<size_t> &
         if (dev_hip->device_id == -1)
             THROW("Error Hip Device is not initialzed");
 
-        for (size_t buffIdx = 0; buffIdx < BUFF_DEPTH; buffIdx++) {
+        auto thread_memory_policy = NumaPlacement::thread_memory_policy();
+        for (size_t buffIdx = 0; buffIdx < _buff_depth; buffIdx++) {
             _dev_sub_buffer[buffIdx].resize(sub_buffer_count);
             _dev_roi_buffers[buffIdx].resize(sub_buffer_count);
             for (unsigned sub_idx = 0; sub_idx < sub_buffer_count; sub_idx++) {
@@ -162,7 +256,9 @@ void RingBuffer::init(RocalMemType mem_type, void *devres, std::vector<size_t> &
                     THROW("hipMalloc of size " + TOSTR(_sub_buffer_size[sub_idx]) + " index " + TOSTR(sub_idx) +
                           " failed " + TOSTR(err));
                 }
-                err = hipHostMalloc((void **)&_dev_roi_buffers[buffIdx][sub_idx], roi_buffer_size[sub_idx], hipHostMallocDefault);  // Allocate HIP page locked ROI buffers
+                _numa_placement.set_thread_memory_policy();
+                err = hipHostMalloc((void **)&_dev_roi_buffers[buffIdx][sub_idx], roi_buffer_size[sub_idx], _numa_placement.bound() ? hipHostMallocNumaUser : hipHostMallocDefault);  // Allocate HIP page locked ROI buffers
+                NumaPlacement::restore_thread_memory_policy(thread_memory_policy);
                 if (err != hipSuccess || !_dev_roi_buffers[buffIdx][sub_idx]) {
                     _dev_roi_buffers.clear();
                     THROW("hipHostMalloc of size " + TOSTR(roi_buffer_size[sub_idx]) + " failed " + TOSTR(err))
@@ -171,18 +267,28 @@ void RingBuffer::init(RocalMemType mem_type, void *devres, std::vector<size_t> &
         }
     } else {
 #endif
-        for (size_t buffIdx = 0; buffIdx < BUFF_DEPTH; buffIdx++) {
-            // a minimum of extra MEM_ALIGNMENT is allocated
+        // Whole pages when the buffers are bound to a NUMA node, so that binding them leaves the other allocations where they are
+        size_t alignment = _numa_placement.buffer_alignment(MEM_ALIGNMENT);
+        for (size_t buffIdx = 0; buffIdx < _buff_depth; buffIdx++) {
+            // a minimum of extra alignment is allocated
             _host_sub_buffers[buffIdx].resize(sub_buffer_count);
             _host_roi_buffers[buffIdx].resize(sub_buffer_count);
             for (size_t sub_buff_idx = 0; sub_buff_idx < sub_buffer_count; sub_buff_idx++) {
-                _host_sub_buffers[buffIdx][sub_buff_idx] = aligned_alloc(MEM_ALIGNMENT, MEM_ALIGNMENT * (_sub_buffer_size[sub_buff_idx] / MEM_ALIGNMENT + 1));
+                _host_sub_buffers[buffIdx][sub_buff_idx] = aligned_alloc(alignment, alignment * (_sub_buffer_size[sub_buff_idx] / alignment + 1));
+                _numa_placement.place_memory(_host_sub_buffers[buffIdx][sub_buff_idx], _sub_buffer_size[sub_buff_idx]);
                 _host_roi_buffers[buffIdx][sub_buff_idx] = static_cast<unsigned *>(malloc(roi_buffer_size[sub_buff_idx]));  // Allocate HOST ROI buffers
             }
         }
 #if ENABLE_OPENCL || ENABLE_HIP
     }
 #endif
+    if (_numa_placement.bound() && _mem_type == RocalMemType::HOST) {
+        std::map<int, size_t> pages_per_node;
+        for (size_t buffIdx = 0; buffIdx < _buff_depth; buffIdx++)
+            for (size_t sub_buff_idx = 0; sub_buff_idx < sub_buffer_count; sub_buff_idx++)
+                NumaPlacement::count_pages(_host_sub_buffers[buffIdx][sub_buff_idx], _sub_buffer_size[sub_buff_idx], pages_per_node);
+        INFO("Output buffers bound to " + _numa_placement.description() + ", " + NumaPlacement::describe_pages(pages_per_node))
+    }
 }
 
 void RingBuffer::initBoxEncoderMetaData(RocalMemType mem_type, size_t encoded_bbox_size, size_t encoded_labels_size) {
@@ -193,7 +299,7 @@ void RingBuffer::initBoxEncoderMetaData(RocalMemType mem_type, size_t encoded_bb
         if (dev_hip->hip_stream == nullptr || dev_hip->device_id == -1)
             THROW("initBoxEncoderMetaData::Error Hip Device is not initialzed");
         hipError_t err;
-        for (size_t buffIdx = 0; buffIdx < BUFF_DEPTH; buffIdx++) {
+        for (size_t buffIdx = 0; buffIdx < _buff_depth; buffIdx++) {
             err = hipMalloc(&_dev_bbox_buffer[buffIdx], encoded_bbox_size);
             if (err != hipSuccess) {
                 _dev_bbox_buffer.clear();
@@ -213,7 +319,7 @@ void RingBuffer::initBoxEncoderMetaData(RocalMemType mem_type, size_t encoded_bb
                 THROW("Error ocl structure needed since memory type is OCL");
 
             cl_int err = CL_SUCCESS;
-            for (size_t buffIdx = 0; buffIdx < BUFF_DEPTH; buffIdx++) {
+            for (size_t buffIdx = 0; buffIdx < _buff_depth; buffIdx++) {
                 _dev_bbox_buffer[buffIdx] = clCreateBuffer(dev_ocl->context, CL_MEM_READ_WRITE, encoded_bbox_size, NULL, &err);
                 if (err) {
                     _dev_bbox_buffer.clear();
@@ -231,18 +337,18 @@ void RingBuffer::initBoxEncoderMetaData(RocalMemType mem_type, size_t encoded_bb
         if (_meta_data_sub_buffer_count < 2)
             THROW("Insufficient HOST metadata buffers for Box Encoder");
         // Check if sufficient data has been allocated for the labels and bbox host buffers if not reallocate
-        for (size_t buffIdx = 0; buffIdx < BUFF_DEPTH; buffIdx++) {
-            if (_meta_data_sub_buffer_size[BUFF_DEPTH][0] < encoded_labels_size)
-                rellocate_meta_data_buffer(_host_meta_data_buffers[BUFF_DEPTH][0], _meta_data_sub_buffer_size[BUFF_DEPTH][0], 0);
-            if (_meta_data_sub_buffer_size[BUFF_DEPTH][1] < encoded_bbox_size)
-                rellocate_meta_data_buffer(_host_meta_data_buffers[BUFF_DEPTH][1], _meta_data_sub_buffer_size[BUFF_DEPTH][1], 1);
+        for (size_t buffIdx = 0; buffIdx < _buff_depth; buffIdx++) {
+            if (_meta_data_sub_buffer_size[_buff_depth][0] < encoded_labels_size)
+                rellocate_meta_data_buffer(_host_meta_data_buffers[_buff_depth][0], _meta_data_sub_buffer_size[_buff_depth][0], 0);
+            if (_meta_data_sub_buffer_size[_buff_depth][1] < encoded_bbox_size)
+                rellocate_meta_data_buffer(_host_meta_data_buffers[_buff_depth][1], _meta_data_sub_buffer_size[_buff_depth][1], 1);
         }
     }
 #endif
 }
 
 void RingBuffer::init_metadata(RocalMemType mem_type, std::vector<size_t> &sub_buffer_size) {
-    if (BUFF_DEPTH < 2)
+    if (_buff_depth < 2)
         THROW("Error internal buffer size for the ring buffer should be greater than one")
 
     // Allocating buffers
@@ -250,9 +356,9 @@ void RingBuffer::init_metadata(RocalMemType mem_type, std::vector<size_t> &sub_b
     if (mem_type == RocalMemType::OCL || mem_type == RocalMemType::HIP) {
         THROW("Metadata is not supported with GPU backends")
     } else {
-        _host_meta_data_buffers.resize(BUFF_DEPTH);
-        _meta_data_sub_buffer_size.resize(BUFF_DEPTH);
-        for (size_t buffIdx = 0; buffIdx < BUFF_DEPTH; buffIdx++) {
+        _host_meta_data_buffers.resize(_buff_depth);
+        _meta_data_sub_buffer_size.resize(_buff_depth);
+        for (size_t buffIdx = 0; buffIdx < _buff_depth; buffIdx++) {
             _host_meta_data_buffers[buffIdx].resize(_meta_data_sub_buffer_count);
             for (size_t sub_buff_idx = 0; sub_buff_idx < _meta_data_sub_buffer_count; sub_buff_idx++) {
                 _meta_data_sub_buffer_size[buffIdx].emplace_back(sub_buffer_size[sub_buff_idx]);
@@ -282,6 +388,7 @@ void RingBuffer::reset() {
     _write_ptr = 0;
     _read_ptr = 0;
     _level = 0;
+    _reserved = 0;
     _dont_block = false;
     while (!_meta_ring_buffer.empty())
         _meta_ring_buffer.pop();
@@ -290,19 +397,25 @@ void RingBuffer::reset() {
 void RingBuffer::release_gpu_res() {
 #if ENABLE_HIP
     if (_mem_type == RocalMemType::HIP) {
+        if (_leases)
+            _leases->detach();
         for (size_t buffIdx = 0; buffIdx < _dev_sub_buffer.size(); buffIdx++) {
-            for (unsigned sub_buf_idx = 0; sub_buf_idx < _dev_sub_buffer[buffIdx].size(); sub_buf_idx++) {
-                if (_dev_sub_buffer[buffIdx][sub_buf_idx])
-                    if (hipFree((void *)_dev_sub_buffer[buffIdx][sub_buf_idx]) != hipSuccess) {
-                        // printf("Error Freeing device buffer <%d, %d, %p>\n", buffIdx, sub_buf_idx, _dev_sub_buffer[buffIdx][sub_buf_idx]);
-                        ERR("Could not release hip memory in the ring buffer")
-                    }
-                if (_dev_roi_buffers[buffIdx][sub_buf_idx]) {
-                    if (hipHostFree((void *)_dev_roi_buffers[buffIdx][sub_buf_idx]) != hipSuccess) {
-                        ERR("Could not release hip memory for ROI in the ring buffer")
+            auto free_slot = [sub_buffers = _dev_sub_buffer[buffIdx], roi_buffers = _dev_roi_buffers[buffIdx]]() {
+                for (unsigned sub_buf_idx = 0; sub_buf_idx < sub_buffers.size(); sub_buf_idx++) {
+                    if (sub_buffers[sub_buf_idx])
+                        if (hipFree((void *)sub_buffers[sub_buf_idx]) != hipSuccess) {
+                            ERR("Could not release hip memory in the ring buffer")
+                        }
+                    if (roi_buffers[sub_buf_idx]) {
+                        if (hipHostFree((void *)roi_buffers[sub_buf_idx]) != hipSuccess) {
+                            ERR("Could not release hip memory for ROI in the ring buffer")
+                        }
                     }
                 }
-            }
+            };
+            // A slot the consumer still borrows is freed when it's returned
+            if (!_leases || !_leases->defer_free(buffIdx, free_slot))
+                free_slot();
             if (_host_meta_data_buffers.size() != 0) {
                 for (unsigned sub_buf_idx = 0; sub_buf_idx < _host_meta_data_buffers[buffIdx].size(); sub_buf_idx++) {
                     if (_host_meta_data_buffers[buffIdx][sub_buf_idx])
@@ -336,14 +449,21 @@ void RingBuffer::release_gpu_res() {
 }
 
 RingBuffer::~RingBuffer() {
+    if (_leases)
+        _leases->detach();
     if (_mem_type == RocalMemType::HOST) {
         for (unsigned buffIdx = 0; buffIdx < _host_sub_buffers.size(); buffIdx++) {
-            for (unsigned sub_buf_idx = 0; sub_buf_idx < _host_sub_buffers[buffIdx].size(); sub_buf_idx++) {
-                if (_host_sub_buffers[buffIdx][sub_buf_idx])
-                    free(_host_sub_buffers[buffIdx][sub_buf_idx]);
-                if (_host_roi_buffers[buffIdx][sub_buf_idx])
-                    free(_host_roi_buffers[buffIdx][sub_buf_idx]);
-            }
+            auto free_slot = [sub_buffers = _host_sub_buffers[buffIdx], roi_buffers = _host_roi_buffers[buffIdx]]() {
+                for (unsigned sub_buf_idx = 0; sub_buf_idx < sub_buffers.size(); sub_buf_idx++) {
+                    if (sub_buffers[sub_buf_idx])
+                        free(sub_buffers[sub_buf_idx]);
+                    if (roi_buffers[sub_buf_idx])
+                        free(roi_buffers[sub_buf_idx]);
+                }
+            };
+            // A slot the consumer still borrows is freed when it's returned
+            if (!_leases || !_leases->defer_free(buffIdx, free_slot))
+                free_slot();
             if (_host_meta_data_buffers.size() != 0) {
                 for (unsigned sub_buf_idx = 0; sub_buf_idx < _host_meta_data_buffers[buffIdx].size(); sub_buf_idx++) {
                     if (_host_meta_data_buffers[buffIdx][sub_buf_idx])
@@ -362,7 +482,8 @@ bool RingBuffer::empty() {
 }
 
 bool RingBuffer::full() {
-    return (_level >= BUFF_DEPTH - 1);
+    // The slot to be written next may still be borrowed by the consumer after it got popped
+    return (_level >= _depth - 1) || lent(_write_ptr);
 }
 
 size_t RingBuffer::level() {
@@ -370,7 +491,7 @@ size_t RingBuffer::level() {
 }
 void RingBuffer::increment_read_ptr() {
     std::unique_lock<std::mutex> lock(_lock);
-    _read_ptr = (_read_ptr + 1) % BUFF_DEPTH;
+    _read_ptr = (_read_ptr + 1) % _buff_depth;
     _level--;
     lock.unlock();
     // Wake up the writer thread (in case waiting) since there is an empty spot to write to,
@@ -379,8 +500,10 @@ void RingBuffer::increment_read_ptr() {
 
 void RingBuffer::increment_write_ptr() {
     std::unique_lock<std::mutex> lock(_lock);
-    _write_ptr = (_write_ptr + 1) % BUFF_DEPTH;
+    _write_ptr = (_write_ptr + 1) % _buff_depth;
     _level++;
+    if (_reserved > 0)
+        _reserved--;
     lock.unlock();
     // Wake up the reader thread (in case waiting) since there is a new load to be read
     _wait_for_load.notify_all();
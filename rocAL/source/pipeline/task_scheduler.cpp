@@ -0,0 +1,195 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "pipeline/task_scheduler.h"
+
+#include <algorithm>
+#include <exception>
+#include <map>
+
+namespace {
+//! Index of the worker running the current thread and its pool, -1 and null outside of the pools
+thread_local int current_worker_idx = -1;
+thread_local const TaskScheduler *current_pool = nullptr;
+
+//! State of a parallel_for() shared with its helper tasks, which may only start once the call returned
+struct ParallelFor {
+    std::function<void(size_t, size_t)> func;
+    size_t count;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex lock;
+    std::condition_variable finished;
+
+    void run(size_t slot) {
+        size_t idx;
+        while ((idx = next.fetch_add(1)) < count) {
+            if (!failed) {
+                try {
+                    func(idx, slot);
+                } catch (...) {
+                    std::unique_lock<std::mutex> error_lock(lock);
+                    if (!failed.exchange(true))
+                        error = std::current_exception();
+                }
+            }
+            if (done.fetch_add(1) + 1 == count) {
+                std::unique_lock<std::mutex> done_lock(lock);
+                finished.notify_all();
+            }
+        }
+    }
+};
+}  // namespace
+
+TaskScheduler &TaskScheduler::instance(int numa_node) {
+    static std::mutex schedulers_lock;
+    static std::map<int, std::unique_ptr<TaskScheduler>> schedulers;
+    std::unique_lock<std::mutex> lock(schedulers_lock);
+    auto &scheduler = schedulers[numa_node < 0 ? -1 : numa_node];
+    if (!scheduler)
+        scheduler.reset(new TaskScheduler(numa_node < 0 ? NumaPlacement() : NumaPlacement::for_node(numa_node)));
+    return *scheduler;
+}
+
+TaskScheduler::TaskScheduler(const NumaPlacement &placement) : _placement(placement) {
+    size_t max_workers = _placement.bound() ? _placement.cpu_count() : std::max(std::thread::hardware_concurrency(), 1u);
+    _workers.resize(max_workers);
+    for (auto &worker : _workers)
+        worker = std::make_unique<Worker>();
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _running = false;
+    }
+    _wait_for_task.notify_all();
+    for (auto &thread : _threads)
+        if (thread.joinable())
+            thread.join();
+}
+
+void TaskScheduler::reserve(size_t thread_budget) {
+    std::unique_lock<std::mutex> lock(_lock);
+    size_t worker_count = std::min(thread_budget > 0 ? thread_budget - 1 : 0, _workers.size());
+    if (worker_count <= _threads.size())
+        return;
+    while (_threads.size() < worker_count)
+        _threads.emplace_back(&TaskScheduler::routine, this, _threads.size());
+    _worker_count = _threads.size();
+    LOG("Task scheduler running " + TOSTR(_worker_count) + " worker threads, " + _placement.description())
+}
+
+void TaskScheduler::push(Task task, TaskPriority priority) {
+    size_t worker_count = _worker_count;
+    if (worker_count == 0) {
+        // No worker was started yet, the caller is the only thread of the pool
+        task();
+        return;
+    }
+    // Tasks queued from a worker stay on it, so that nested work runs where its data is
+    size_t worker_idx = current_pool == this ? current_worker_idx : _next_worker++ % worker_count;
+    // Counted before it is queued, a worker taking it right away decrements a count which already includes it
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _pending++;
+    }
+    {
+        std::unique_lock<std::mutex> lock(_workers[worker_idx]->lock);
+        _workers[worker_idx]->queues[static_cast<size_t>(priority)].push_back(std::move(task));
+    }
+    _wait_for_task.notify_one();
+}
+
+bool TaskScheduler::pop_or_steal(size_t worker_idx, Task &task) {
+    size_t worker_count = _worker_count;
+    for (size_t level = 0; level < PRIORITY_LEVELS; level++) {
+        {
+            auto &own = *_workers[worker_idx];
+            std::unique_lock<std::mutex> lock(own.lock);
+            if (!own.queues[level].empty()) {
+                task = std::move(own.queues[level].back());
+                own.queues[level].pop_back();
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < worker_count; offset++) {
+            auto &victim = *_workers[(worker_idx + offset) % worker_count];
+            std::unique_lock<std::mutex> lock(victim.lock);
+            if (!victim.queues[level].empty()) {
+                task = std::move(victim.queues[level].front());
+                victim.queues[level].pop_front();
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::routine(size_t worker_idx) {
+    _placement.bind_current_thread();
+    current_worker_idx = worker_idx;
+    current_pool = this;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            _wait_for_task.wait(lock, [&] { return _pending > 0 || !_running; });
+            if (!_running)
+                return;
+        }
+        Task task;
+        if (!pop_or_steal(worker_idx, task))
+            continue;  // Another worker took it first
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            _pending--;
+        }
+        task();
+    }
+}
+
+void TaskScheduler::parallel_for(size_t count, size_t max_parallelism, TaskPriority priority, const std::function<void(size_t, size_t)> &func) {
+    if (count == 0)
+        return;
+    size_t helper_count = std::min({max_parallelism > 0 ? max_parallelism - 1 : 0, count - 1, static_cast<size_t>(_worker_count)});
+    if (helper_count == 0) {
+        for (size_t idx = 0; idx < count; idx++)
+            func(idx, 0);
+        return;
+    }
+    auto state = std::make_shared<ParallelFor>();
+    state->func = func;
+    state->count = count;
+    // Helpers starting late find no index left and return right away, the state is kept alive by them till then
+    for (size_t slot = 1; slot <= helper_count; slot++)
+        push([state, slot] { state->run(slot); }, priority);
+    state->run(0);
+    {
+        std::unique_lock<std::mutex> lock(state->lock);
+        state->finished.wait(lock, [&] { return state->done == count; });
+    }
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
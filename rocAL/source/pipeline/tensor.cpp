@@ -27,6 +27,7 @@ THE SOFTWARE.
 #endif
 #include <vx_ext_amd.h>
 
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
 
@@ -471,6 +472,115 @@ unsigned Tensor::copy_data(void *user_buffer, uint x_offset, uint y_offset, uint
     return 0;
 }
 
+Tensor::RaggedSample Tensor::ragged_sample(unsigned sample_idx) {
+    if (!_info.is_image())
+        THROW("Ragged copies are only supported for image and video tensors")
+    auto roi = _info.roi().get_2D_roi();
+    size_t x, y, width, height;
+    if (_info.roi_type() == RocalROIType::LTRB) {
+        x = roi[sample_idx].ltrb.l;
+        y = roi[sample_idx].ltrb.t;
+        width = roi[sample_idx].ltrb.r - roi[sample_idx].ltrb.l + 1;
+        height = roi[sample_idx].ltrb.b - roi[sample_idx].ltrb.t + 1;
+    } else {
+        x = roi[sample_idx].xywh.x;
+        y = roi[sample_idx].xywh.y;
+        width = roi[sample_idx].xywh.w;
+        height = roi[sample_idx].xywh.h;
+    }
+    size_t max_width = _info.max_shape()[0], max_height = _info.max_shape()[1];
+    x = std::min(x, max_width);
+    y = std::min(y, max_height);
+    width = std::min(width, max_width - x);
+    height = std::min(height, max_height - y);
+
+    // The frames of a sequence are the samples of the batch, their ROIs are kept one after the other
+    auto layout = _info.layout();
+    bool sequence = (layout == RocalTensorlayout::NFHWC || layout == RocalTensorlayout::NFCHW);
+    size_t sample_stride = _info.strides()[sequence ? 1 : 0];
+    size_t dtype_size = _info.data_type_size();
+    size_t channels = _info.get_channels();
+    RaggedSample sample;
+    if (layout == RocalTensorlayout::NCHW || layout == RocalTensorlayout::NFCHW) {
+        sample.row_size = width * dtype_size;
+        sample.row_pitch = max_width * dtype_size;
+        sample.plane_count = channels;
+        sample.plane_pitch = max_height * sample.row_pitch;
+        sample.offset = sample_idx * sample_stride + y * sample.row_pitch + x * dtype_size;
+    } else {
+        sample.row_size = width * channels * dtype_size;
+        sample.row_pitch = max_width * channels * dtype_size;
+        sample.plane_count = 1;
+        sample.plane_pitch = 0;
+        sample.offset = sample_idx * sample_stride + y * sample.row_pitch + x * channels * dtype_size;
+    }
+    sample.row_count = height;
+    return sample;
+}
+
+size_t Tensor::ragged_sample_count() {
+    // The sequences of a batch are copied frame by frame, matching the N * F ROIs they have
+    auto layout = _info.layout();
+    if (layout == RocalTensorlayout::NFHWC || layout == RocalTensorlayout::NFCHW)
+        return _info.dims()[0] * _info.dims()[1];
+    return _info.batch_size();
+}
+
+size_t Tensor::ragged_data_size() {
+    size_t size = 0;
+    size_t sample_count = ragged_sample_count();
+    for (unsigned sample_idx = 0; sample_idx < sample_count; sample_idx++)
+        size += ragged_sample(sample_idx).size();
+    return size;
+}
+
+unsigned Tensor::copy_data_ragged(void *user_buffer, size_t *sample_offsets, RocalOutputMemType external_mem_type) {
+    if (_mem_handle == nullptr) return 0;
+    if (external_mem_type != RocalOutputMemType::ROCAL_MEMCPY_HOST && external_mem_type != RocalOutputMemType::ROCAL_MEMCPY_GPU)
+        THROW("copy_data_ragged requested mem type not supported")
+#if ENABLE_HIP
+    hipMemcpyKind kind;
+    if (_info._mem_type == RocalMemType::HIP)
+        kind = (external_mem_type == RocalOutputMemType::ROCAL_MEMCPY_GPU) ? hipMemcpyDeviceToDevice : hipMemcpyDeviceToHost;
+    else
+        kind = (external_mem_type == RocalOutputMemType::ROCAL_MEMCPY_GPU) ? hipMemcpyHostToDevice : hipMemcpyHostToHost;
+#else
+    if (_info._mem_type == RocalMemType::HIP || external_mem_type == RocalOutputMemType::ROCAL_MEMCPY_GPU)
+        THROW("copy_data_ragged failed as HIP is not supported")
+#endif
+    size_t dst_offset = 0;
+    size_t sample_count = ragged_sample_count();
+    for (unsigned sample_idx = 0; sample_idx < sample_count; sample_idx++) {
+        auto sample = ragged_sample(sample_idx);
+        if (sample_offsets)
+            sample_offsets[sample_idx] = dst_offset;
+        for (size_t plane = 0; plane < sample.plane_count; plane++) {
+            auto src_ptr = static_cast<unsigned char *>(_mem_handle) + sample.offset + plane * sample.plane_pitch;
+            auto dst_ptr = static_cast<unsigned char *>(user_buffer) + dst_offset;
+#if ENABLE_HIP
+            if (kind != hipMemcpyHostToHost) {
+                hipError_t status;
+                if ((status = hipMemcpy2D(dst_ptr, sample.row_size, src_ptr, sample.row_pitch, sample.row_size, sample.row_count, kind)))
+                    THROW("copy_data_ragged::hipMemcpy2D failed: " + TOSTR(status))
+                dst_offset += sample.row_size * sample.row_count;
+                continue;
+            }
+#endif
+            if (sample.row_size == sample.row_pitch) {
+                memcpy(dst_ptr, src_ptr, sample.row_size * sample.row_count);
+            } else {
+                for (size_t row = 0; row < sample.row_count; row++) {
+                    memcpy(dst_ptr, src_ptr, sample.row_size);
+                    src_ptr += sample.row_pitch;
+                    dst_ptr += sample.row_size;
+                }
+            }
+            dst_offset += sample.row_size * sample.row_count;
+        }
+    }
+    return 0;
+}
+
 int Tensor::swap_handle(void *handle) {
     vx_status status;
     if ((status = vxSwapTensorHandle(_vx_handle, handle, nullptr)) != VX_SUCCESS) {
@@ -0,0 +1,138 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "pipeline/tensor_conversion.h"
+
+#if ENABLE_SIMD
+#include <cpuid.h>
+#endif
+
+#include "pipeline/tensor_conversion_kernels.h"
+
+namespace tensor_conversion {
+
+namespace {
+
+#if ENABLE_SIMD
+//! Returns the register states the OS saves on context switches (XCR0)
+uint64_t os_saved_states() {
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+}
+#endif
+
+Isa detect_isa() {
+    Isa isa = Isa::SCALAR;
+#if ENABLE_SIMD
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return isa;
+    const bool sse42 = (ecx & bit_SSSE3) && (ecx & bit_SSE4_1) && (ecx & bit_SSE4_2);
+    if (!sse42)
+        return isa;
+    isa = Isa::SSE42;
+    const bool fma_f16c = (ecx & bit_FMA) && (ecx & bit_F16C);
+    if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX) || !fma_f16c)
+        return isa;
+    const uint64_t states = os_saved_states();
+    if ((states & 0x6) != 0x6)  // SSE and AVX registers
+        return isa;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) || !(ebx & bit_AVX2))
+        return isa;
+    isa = Isa::AVX2;
+    if ((ebx & bit_AVX512F) && (states & 0xE0) == 0xE0)  // Opmask and ZMM registers
+        isa = Isa::AVX512;
+#endif
+    return isa;
+}
+
+}  // namespace
+
+size_t output_element_size(RocalTensorDataType data_type) {
+    switch (data_type) {
+        case RocalTensorDataType::FP32:
+            return sizeof(float);
+        case RocalTensorDataType::FP16:
+        case RocalTensorDataType::BF16:
+            return sizeof(uint16_t);
+        case RocalTensorDataType::UINT8:
+            return sizeof(uint8_t);
+        default:
+            THROW("Unsupported output data type " + TOSTR(data_type))
+    }
+}
+
+const char *isa_name(Isa isa) {
+    switch (isa) {
+        case Isa::SSE42:
+            return "SSE4.2";
+        case Isa::AVX2:
+            return "AVX2";
+        case Isa::AVX512:
+            return "AVX-512";
+        default:
+            return "scalar";
+    }
+}
+
+Isa best_supported_isa() {
+    static const Isa isa = detect_isa();
+    return isa;
+}
+
+bool is_supported(Isa isa) {
+    return static_cast<int>(isa) <= static_cast<int>(best_supported_isa());
+}
+
+void convert(const ConvertArgs &args) {
+    convert(args, best_supported_isa());
+}
+
+void convert(const ConvertArgs &args, Isa isa) {
+    if (args.channels != 1 && args.channels != 3)
+        THROW("Only 1 and 3 channel images can be converted, got " + TOSTR(args.channels))
+    if (args.dst_layout != RocalTensorlayout::NHWC && args.dst_layout != RocalTensorlayout::NCHW)
+        THROW("Only NHWC and NCHW outputs are supported")
+    if (!is_supported(isa))
+        THROW(STR(isa_name(isa)) + " conversion kernels are not supported by the CPU")
+    switch (isa) {
+        case Isa::SSE42:
+            convert_sse42(args);
+            break;
+        case Isa::AVX2:
+            convert_avx2(args);
+            break;
+        case Isa::AVX512:
+            convert_avx512(args);
+            break;
+        default:
+            convert_scalar(args);
+            break;
+    }
+}
+
+void convert_scalar(const ConvertArgs &args) {
+    convert_with<ScalarVec>(args);
+}
+
+}  // namespace tensor_conversion
@@ -0,0 +1,125 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <immintrin.h>
+
+#include "pipeline/tensor_conversion_kernels.h"
+
+// Built with -msse4.2, four pixels per step
+namespace {
+
+//! Vector float to half conversion rounding to the nearest even, F16C is not part of SSE4.2 (F. Giesen, float_to_half_SSE2)
+inline __m128i float_to_half_sse(__m128 value) {
+    const __m128i f16_max = _mm_set1_epi32((127 + 16) << 23);
+    const __m128i f32_infinity = _mm_set1_epi32(255 << 23);
+    const __m128i min_normal = _mm_set1_epi32((127 - 14) << 23);
+    const __m128i subnormal_magic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i normal_bias = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+    const __m128 sign = _mm_and_ps(value, _mm_set1_ps(-0.0f));
+    const __m128i abs_bits = _mm_castps_si128(_mm_xor_ps(value, sign));
+    const __m128i mantissa_odd = _mm_srai_epi32(_mm_slli_epi32(abs_bits, 31 - 13), 31);
+    const __m128i is_nan = _mm_cmpgt_epi32(abs_bits, f32_infinity);
+    const __m128i is_regular = _mm_cmpgt_epi32(f16_max, abs_bits);
+    const __m128i is_subnormal = _mm_cmpgt_epi32(min_normal, abs_bits);
+    const __m128i inf_or_nan = _mm_or_si128(_mm_and_si128(is_nan, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+    const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(abs_bits), _mm_castsi128_ps(subnormal_magic))), subnormal_magic);
+    const __m128i normal = _mm_srli_epi32(_mm_add_epi32(abs_bits, _mm_sub_epi32(normal_bias, mantissa_odd)), 13);
+    const __m128i finite = _mm_blendv_epi8(normal, subnormal, is_subnormal);
+    const __m128i joined = _mm_blendv_epi8(inf_or_nan, finite, is_regular);
+    return _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+}
+
+//! Rounds to the nearest even bfloat16, the result in the low 16 bits of each lane
+inline __m128i float_to_bfloat16_sse(__m128 value) {
+    __m128i bits = _mm_castps_si128(value);
+    __m128i lsb = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(1));
+    return _mm_srli_epi32(_mm_add_epi32(bits, _mm_add_epi32(lsb, _mm_set1_epi32(0x7FFF))), 16);
+}
+
+inline __m128 u8_dword_to_float(__m128i bytes) {
+    return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(bytes));
+}
+
+inline int32_t load_u32(const uint8_t *src) {
+    int32_t value;
+    std::memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+struct Sse42Vec {
+    static constexpr unsigned P = 4;
+    static constexpr unsigned OVERREAD_PIXELS = 2;  // 16 bytes loaded for the 12 of 4 pixels
+    using F = __m128;
+    using Mask = __m128i;
+
+    static F set1(float value) { return _mm_set1_ps(value); }
+    static F load(const float *src) { return _mm_loadu_ps(src); }
+    static F fmadd(F x, F multiplier, F offset) { return _mm_add_ps(_mm_mul_ps(x, multiplier), offset); }
+    static F load_u8(const uint8_t *src) { return u8_dword_to_float(_mm_cvtsi32_si128(load_u32(src))); }
+    //! Gathers the bytes of each channel of 4 pixels into one dword
+    static Mask deinterleave_mask(bool reverse_channels) {
+        return reverse_channels ? _mm_setr_epi8(2, 5, 8, 11, 1, 4, 7, 10, 0, 3, 6, 9, -1, -1, -1, -1)
+                                : _mm_setr_epi8(0, 3, 6, 9, 1, 4, 7, 10, 2, 5, 8, 11, -1, -1, -1, -1);
+    }
+    static Mask reverse_mask() { return _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, -1, -1, -1, -1); }
+    static void split(__m128i bytes, F out[3]) {
+        out[0] = u8_dword_to_float(bytes);
+        out[1] = u8_dword_to_float(_mm_srli_si128(bytes, 4));
+        out[2] = u8_dword_to_float(_mm_srli_si128(bytes, 8));
+    }
+    static void deinterleave(const uint8_t *src, Mask mask, F out[3]) {
+        split(_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src)), mask), out);
+    }
+    static void reverse(const uint8_t *src, Mask mask, F out[3]) {
+        split(_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src)), mask), out);
+    }
+    static void interleave(const uint8_t *src0, const uint8_t *src1, const uint8_t *src2, F out[3]) {
+        __m128i planes = _mm_setr_epi32(load_u32(src0), load_u32(src1), load_u32(src2), 0);
+        split(_mm_shuffle_epi8(planes, _mm_setr_epi8(0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11, -1, -1, -1, -1)), out);
+    }
+    template <RocalTensorDataType T>
+    static void store(Out<T> *dst, F value) {
+        if constexpr (T == RocalTensorDataType::FP32) {
+            _mm_storeu_ps(dst, value);
+        } else if constexpr (T == RocalTensorDataType::FP16) {
+            __m128i half = float_to_half_sse(value);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), _mm_packs_epi32(half, half));
+        } else if constexpr (T == RocalTensorDataType::BF16) {
+            __m128i bfloat = float_to_bfloat16_sse(value);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), _mm_packus_epi32(bfloat, bfloat));
+        } else {
+            __m128i words = _mm_packs_epi32(_mm_cvtps_epi32(value), _mm_setzero_si128());
+            int32_t bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+            std::memcpy(dst, &bytes, sizeof(bytes));
+        }
+    }
+};
+
+}  // namespace
+
+namespace tensor_conversion {
+
+void convert_sse42(const ConvertArgs &args) {
+    convert_with<Sse42Vec>(args);
+}
+
+}  // namespace tensor_conversion
@@ -0,0 +1,219 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "readers/async_file_reader.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+AsyncFileReader::AsyncFileReader(size_t queue_depth, size_t num_threads) : _backend(Backend::THREAD_POOL),
+                                                                           _queue_depth(std::max(queue_depth, (size_t)1)) {
+#if ENABLE_IO_URING
+    if (io_uring_queue_init(_queue_depth, &_ring, 0) == 0) {
+        _backend = Backend::IO_URING;
+        LOG("AsyncFileReader using io_uring with queue depth " + TOSTR(_queue_depth))
+        return;
+    }
+    WRN("AsyncFileReader could not initialize io_uring, falling back to reader threads")
+#endif
+    size_t thread_count = std::min(std::max(num_threads, (size_t)1), _queue_depth);
+    for (size_t i = 0; i < thread_count; i++)
+        _workers.emplace_back(&AsyncFileReader::worker_routine, this);
+    LOG("AsyncFileReader using " + TOSTR(thread_count) + " reader threads")
+}
+
+AsyncFileReader::~AsyncFileReader() {
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+#if ENABLE_IO_URING
+        while (_backend == Backend::IO_URING && _in_flight > 0)
+            reap_completion();
+#endif
+        _running = false;
+    }
+    _wait_for_request.notify_all();
+    for (auto &worker : _workers)
+        if (worker.joinable()) worker.join();
+#if ENABLE_IO_URING
+    if (_backend == Backend::IO_URING)
+        io_uring_queue_exit(&_ring);
+#endif
+}
+
+void AsyncFileReader::reset(size_t slot_count) {
+    std::unique_lock<std::mutex> lock(_lock);
+    if (_pending_count > 0)
+        THROW("AsyncFileReader cannot be reset while " + TOSTR(_pending_count) + " reads are pending")
+    _requests.clear();
+    _requests.resize(slot_count);
+}
+
+void AsyncFileReader::submit(size_t slot, const std::string &path, std::vector<unsigned char> *buffer) {
+    std::unique_lock<std::mutex> lock(_lock);
+    if (slot >= _requests.size())
+        THROW("AsyncFileReader slot " + TOSTR(slot) + " is out of range")
+    auto &request = _requests[slot];
+    if (request.pending)
+        THROW("AsyncFileReader slot " + TOSTR(slot) + " has a pending read")
+    request.path = path;
+    request.buffer = buffer;
+    request.size = request.read_size = 0;
+    request.pending = true;
+    _pending_count++;
+#if ENABLE_IO_URING
+    if (_backend == Backend::IO_URING) {
+        struct stat file_stat;
+        request.fd = ::open(path.c_str(), O_RDONLY);
+        if (request.fd < 0 || fstat(request.fd, &file_stat) != 0 || file_stat.st_size == 0) {
+            if (request.fd >= 0) ::close(request.fd);
+            request.fd = -1;
+            complete(slot, 0);
+            return;
+        }
+        request.size = file_stat.st_size;
+        if (buffer->size() < request.size)
+            buffer->resize(request.size);
+        while (_in_flight >= _queue_depth)
+            reap_completion();
+        struct io_uring_sqe *sqe = io_uring_get_sqe(&_ring);
+        io_uring_prep_read(sqe, request.fd, buffer->data(), request.size, 0);
+        io_uring_sqe_set_data(sqe, reinterpret_cast<void *>(slot));
+        io_uring_submit(&_ring);
+        _in_flight++;
+        return;
+    }
+#endif
+    _queue.push_back(slot);
+    lock.unlock();
+    _wait_for_request.notify_one();
+}
+
+size_t AsyncFileReader::wait(size_t slot) {
+    std::unique_lock<std::mutex> lock(_lock);
+    if (slot >= _requests.size())
+        THROW("AsyncFileReader slot " + TOSTR(slot) + " is out of range")
+#if ENABLE_IO_URING
+    if (_backend == Backend::IO_URING) {
+        // Whichever caller holds the lock reaps completions on behalf of all the waiting callers
+        while (_requests[slot].pending)
+            reap_completion();
+        return _requests[slot].read_size;
+    }
+#endif
+    _wait_for_completion.wait(lock, [&] { return !_requests[slot].pending; });
+    return _requests[slot].read_size;
+}
+
+void AsyncFileReader::wait_all() {
+    std::unique_lock<std::mutex> lock(_lock);
+#if ENABLE_IO_URING
+    if (_backend == Backend::IO_URING) {
+        while (_pending_count > 0)
+            reap_completion();
+        return;
+    }
+#endif
+    _wait_for_completion.wait(lock, [&] { return _pending_count == 0; });
+}
+
+std::chrono::high_resolution_clock::time_point AsyncFileReader::last_completion_time() {
+    std::unique_lock<std::mutex> lock(_lock);
+    return _last_completion;
+}
+
+void AsyncFileReader::complete(size_t slot, size_t read_size) {
+    auto &request = _requests[slot];
+    request.read_size = read_size;
+    request.pending = false;
+    _pending_count--;
+    _last_completion = std::chrono::high_resolution_clock::now();
+}
+
+size_t AsyncFileReader::read_file(Request &request) {
+    struct stat file_stat;
+    int fd = ::open(request.path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return 0;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+        ::close(fd);
+        return 0;
+    }
+    size_t file_size = file_stat.st_size;
+    if (request.buffer->size() < file_size)
+        request.buffer->resize(file_size);
+    size_t read_size = 0;
+    while (read_size < file_size) {
+        auto ret = pread(fd, request.buffer->data() + read_size, file_size - read_size, read_size);
+        if (ret <= 0) break;
+        read_size += ret;
+    }
+    ::close(fd);
+    return read_size;
+}
+
+void AsyncFileReader::worker_routine() {
+    while (true) {
+        size_t slot;
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            _wait_for_request.wait(lock, [&] { return !_queue.empty() || !_running; });
+            if (!_running)
+                return;
+            slot = _queue.front();
+            _queue.pop_front();
+            request.path = _requests[slot].path;
+            request.buffer = _requests[slot].buffer;
+        }
+        auto read_size = read_file(request);
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            complete(slot, read_size);
+        }
+        _wait_for_completion.notify_all();
+    }
+}
+
+#if ENABLE_IO_URING
+// Must be called with _lock held
+void AsyncFileReader::reap_completion() {
+    struct io_uring_cqe *cqe = nullptr;
+    if (io_uring_wait_cqe(&_ring, &cqe) < 0 || !cqe)
+        THROW("AsyncFileReader failed waiting on the io_uring completion queue")
+    auto slot = reinterpret_cast<size_t>(io_uring_cqe_get_data(cqe));
+    auto result = cqe->res;
+    io_uring_cqe_seen(&_ring, cqe);
+    _in_flight--;
+    auto &request = _requests[slot];
+    size_t read_size = (result > 0) ? result : 0;
+    // Short reads are rare for regular files, finish them synchronously
+    while (result > 0 && read_size < request.size) {
+        auto ret = pread(request.fd, request.buffer->data() + read_size, request.size - read_size, read_size);
+        if (ret <= 0) break;
+        read_size += ret;
+    }
+    ::close(request.fd);
+    request.fd = -1;
+    complete(slot, read_size);
+}
+#endif
@@ -0,0 +1,360 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "readers/dataset_manifest.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+namespace {
+const char MANIFEST_MAGIC[8] = {'R', 'M', 'A', 'N', 'I', 'F', 'S', 'T'};
+
+class ManifestWriter {
+   public:
+    template <typename T>
+    void put(T value) { _buffer.append(reinterpret_cast<const char *>(&value), sizeof(T)); }
+    void put(const std::string &value) {
+        put((uint32_t)value.size());
+        _buffer.append(value);
+    }
+    void put(const char *data, size_t size) { _buffer.append(data, size); }
+    const std::string &buffer() const { return _buffer; }
+
+   private:
+    std::string _buffer;
+};
+
+class ManifestParser {
+   public:
+    ManifestParser(const std::vector<char> &buffer) : _ptr(buffer.data()), _end(buffer.data() + buffer.size()) {}
+    template <typename T>
+    bool get(T &value) {
+        if ((size_t)(_end - _ptr) < sizeof(T)) return false;
+        memcpy(&value, _ptr, sizeof(T));
+        _ptr += sizeof(T);
+        return true;
+    }
+    bool get(std::string &value) {
+        uint32_t length;
+        if (!get(length) || (size_t)(_end - _ptr) < length) return false;
+        value.assign(_ptr, length);
+        _ptr += length;
+        return true;
+    }
+
+   private:
+    const char *_ptr, *_end;
+};
+
+bool entry_is(int dir_fd, const struct dirent *entity, mode_t type) {
+    // d_type spares a stat per entry, file systems which don't report it and symbolic links need one
+    if (entity->d_type != DT_UNKNOWN && entity->d_type != DT_LNK)
+        return (type == S_IFREG) ? entity->d_type == DT_REG : entity->d_type == DT_DIR;
+    struct stat entry_stat;
+    if (fstatat(dir_fd, entity->d_name, &entry_stat, 0) != 0)
+        return false;
+    return (entry_stat.st_mode & S_IFMT) == type;
+}
+
+bool same_mtime(const struct stat &stat, int64_t sec, int64_t nsec) {
+    return stat.st_mtim.tv_sec == sec && stat.st_mtim.tv_nsec == nsec;
+}
+}  // namespace
+
+std::shared_ptr<DatasetManifest> DatasetManifest::get(const std::string &manifest_dir, const std::string &root_path) {
+    static std::mutex cache_lock;
+    static std::map<std::string, std::weak_ptr<DatasetManifest>> cache;  // Readers of the same pipeline share the manifest while any of them holds it
+    char resolved[PATH_MAX];
+    std::string root = realpath(root_path.c_str(), resolved) ? std::string(resolved) : root_path;
+    // Manifests are keyed by the root path, FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : root) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx", (unsigned long long)hash);
+    std::string manifest_path = manifest_dir + "/" + name + ".rocal_manifest";
+
+    std::unique_lock<std::mutex> lock(cache_lock);
+    auto manifest = cache[manifest_path].lock();
+    if (!manifest) {
+        manifest = std::make_shared<DatasetManifest>(manifest_path, root);
+        if (!manifest->load())
+            LOG("DatasetManifest: Creating the manifest of " + root + " at " + manifest_path)
+        cache[manifest_path] = manifest;
+    }
+    std::unique_lock<std::mutex> manifest_lock(manifest->_lock);
+    manifest->refresh();
+    manifest_lock.unlock();
+    manifest->save();
+    return manifest;
+}
+
+bool DatasetManifest::is_supported_file(const std::string &file_name) {
+    auto file_extension_idx = file_name.find_last_of(".");
+    if (file_extension_idx == std::string::npos)
+        return true;  // Same as the file readers, files without extension are not filtered out
+    std::string file_extension = file_name.substr(file_extension_idx + 1);
+    std::transform(file_extension.begin(), file_extension.end(), file_extension.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return (file_extension == "jpg") || (file_extension == "jpeg") || (file_extension == "png") || (file_extension == "ppm") || (file_extension == "bmp") ||
+           (file_extension == "pgm") || (file_extension == "tif") || (file_extension == "tiff") || (file_extension == "webp") || (file_extension == "wav");
+}
+
+std::string DatasetManifest::folder_path(size_t folder_idx) const {
+    return folder_idx == 0 ? _root_path : _root_path + "/" + _folders[folder_idx].name;
+}
+
+std::string DatasetManifest::relative_path(size_t folder_idx, size_t file_idx) const {
+    auto &file_name = _folders[folder_idx].files[file_idx].name;
+    return folder_idx == 0 ? file_name : _folders[folder_idx].name + "/" + file_name;
+}
+
+bool DatasetManifest::find(const std::string &relative_path, size_t &folder_idx, size_t &file_idx) {
+    std::unique_lock<std::mutex> lock(_lock);
+    if (_path_map.empty()) {
+        for (size_t i = 0; i < _folders.size(); i++)
+            for (size_t j = 0; j < _folders[i].files.size(); j++)
+                _path_map.emplace(this->relative_path(i, j), std::make_pair(i, j));
+    }
+    auto it = _path_map.find(relative_path);
+    if (it == _path_map.end())
+        return false;
+    std::tie(folder_idx, file_idx) = it->second;
+    return true;
+}
+
+void DatasetManifest::set_dimensions(size_t folder_idx, size_t file_idx, uint32_t width, uint32_t height) {
+    std::unique_lock<std::mutex> lock(_lock);
+    auto &file = _folders[folder_idx].files[file_idx];
+    if (file.width == width && file.height == height)
+        return;
+    file.width = width;
+    file.height = height;
+    _dirty = true;
+}
+
+void DatasetManifest::scan_folder(Folder &folder, const std::string &path) {
+    DIR *dir = opendir(path.c_str());
+    if (!dir) {
+        WRN("DatasetManifest: Failed opening the directory at " + path)
+        folder.files.clear();
+        return;
+    }
+    // Keep the dimensions already found for the files which didn't change
+    std::unordered_map<std::string, const File *> known_files;
+    for (auto &file : folder.files)
+        known_files.emplace(file.name, &file);
+    std::vector<File> files;
+    int dir_fd = dirfd(dir);
+    struct dirent *entity;
+    while ((entity = readdir(dir)) != nullptr) {
+        if (!entry_is(dir_fd, entity, S_IFREG))
+            continue;
+        File file;
+        file.name = entity->d_name;
+        struct stat file_stat;
+        if (fstatat(dir_fd, entity->d_name, &file_stat, 0) == 0)
+            file.size = file_stat.st_size;
+        auto it = known_files.find(file.name);
+        if (it != known_files.end() && it->second->size == file.size) {
+            file.width = it->second->width;
+            file.height = it->second->height;
+        }
+        files.push_back(std::move(file));
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end(), [](const File &a, const File &b) { return a.name < b.name; });
+    folder.files = std::move(files);
+}
+
+void DatasetManifest::refresh() {
+    struct stat root_stat;
+    if (stat(_root_path.c_str(), &root_stat) != 0 || !S_ISDIR(root_stat.st_mode))
+        THROW("DatasetManifest: Failed opening the directory at " + _root_path)
+    if (!same_mtime(root_stat, _root_mtime_sec, _root_mtime_nsec)) {
+        // Entries were added to or removed from the root, list it again and carry over the sub folders that are still there
+        DIR *dir = opendir(_root_path.c_str());
+        if (!dir)
+            THROW("DatasetManifest: Failed opening the directory at " + _root_path)
+        std::vector<RootEntry> root_entries;
+        int dir_fd = dirfd(dir);
+        struct dirent *entity;
+        while ((entity = readdir(dir)) != nullptr) {
+            if (strcmp(entity->d_name, ".") == 0 || strcmp(entity->d_name, "..") == 0)
+                continue;
+            RootEntry entry;
+            entry.name = entity->d_name;
+            entry.is_directory = entry_is(dir_fd, entity, S_IFDIR);
+            if (!entry.is_directory && !entry_is(dir_fd, entity, S_IFREG))
+                continue;
+            root_entries.push_back(entry);
+        }
+        closedir(dir);
+        std::sort(root_entries.begin(), root_entries.end(), [](const RootEntry &a, const RootEntry &b) { return a.name < b.name; });
+
+        std::unordered_map<std::string, size_t> known_folders;
+        for (size_t i = 1; i < _folders.size(); i++)
+            known_folders.emplace(_folders[i].name, i);
+        std::vector<Folder> folders(1);
+        if (!_folders.empty())
+            folders[0] = std::move(_folders[0]);
+        scan_folder(folders[0], _root_path);
+        int label = 0;
+        for (auto &entry : root_entries) {
+            if (!entry.is_directory)
+                continue;
+            auto it = known_folders.find(entry.name);
+            if (it != known_folders.end()) {
+                folders.push_back(std::move(_folders[it->second]));
+            } else {
+                folders.emplace_back();
+                folders.back().name = entry.name;
+            }
+            folders.back().label = label++;
+            entry.folder_idx = folders.size() - 1;
+        }
+        _root_entries = std::move(root_entries);
+        _folders = std::move(folders);
+        _root_mtime_sec = root_stat.st_mtim.tv_sec;
+        _root_mtime_nsec = root_stat.st_mtim.tv_nsec;
+        _dirty = true;
+    }
+    for (size_t i = 1; i < _folders.size(); i++) {
+        auto &folder = _folders[i];
+        std::string path = folder_path(i);
+        struct stat folder_stat;
+        if (stat(path.c_str(), &folder_stat) != 0)
+            THROW("DatasetManifest: Failed opening the directory at " + path)
+        if (same_mtime(folder_stat, folder.mtime_sec, folder.mtime_nsec))
+            continue;
+        scan_folder(folder, path);
+        folder.mtime_sec = folder_stat.st_mtim.tv_sec;
+        folder.mtime_nsec = folder_stat.st_mtim.tv_nsec;
+        _dirty = true;
+    }
+    if (_dirty)
+        _path_map.clear();
+}
+
+bool DatasetManifest::load() {
+    std::ifstream manifest_file(_manifest_path, std::ios::binary | std::ios::ate);
+    if (!manifest_file)
+        return false;
+    std::vector<char> buffer(manifest_file.tellg());
+    manifest_file.seekg(0, std::ios::beg);
+    if (!manifest_file.read(buffer.data(), buffer.size()))
+        return false;
+    ManifestParser parser(buffer);
+    char magic[sizeof(MANIFEST_MAGIC)];
+    uint32_t version, entry_count, folder_count;
+    std::string root_path;
+    if (!parser.get(magic) || memcmp(magic, MANIFEST_MAGIC, sizeof(magic)) != 0 || !parser.get(version) || version != VERSION ||
+        !parser.get(root_path) || root_path != _root_path || !parser.get(_root_mtime_sec) || !parser.get(_root_mtime_nsec) || !parser.get(entry_count))
+        return false;
+    std::vector<RootEntry> root_entries(entry_count);
+    for (auto &entry : root_entries) {
+        uint8_t is_directory;
+        uint64_t folder_idx;
+        if (!parser.get(entry.name) || !parser.get(is_directory) || !parser.get(folder_idx))
+            return false;
+        entry.is_directory = is_directory;
+        entry.folder_idx = folder_idx;
+    }
+    if (!parser.get(folder_count) || folder_count == 0)
+        return false;
+    std::vector<Folder> folders(folder_count);
+    for (auto &folder : folders) {
+        uint64_t file_count;
+        int32_t label;
+        if (!parser.get(folder.name) || !parser.get(folder.mtime_sec) || !parser.get(folder.mtime_nsec) || !parser.get(label) || !parser.get(file_count))
+            return false;
+        folder.label = label;
+        folder.files.resize(file_count);
+        for (auto &file : folder.files)
+            if (!parser.get(file.name) || !parser.get(file.size) || !parser.get(file.width) || !parser.get(file.height))
+                return false;
+    }
+    for (auto &entry : root_entries)
+        if (entry.folder_idx >= folders.size())
+            return false;
+    _root_entries = std::move(root_entries);
+    _folders = std::move(folders);
+    _dirty = false;
+    return true;
+}
+
+void DatasetManifest::save() {
+    std::unique_lock<std::mutex> lock(_lock);
+    if (!_dirty)
+        return;
+    ManifestWriter writer;
+    writer.put(MANIFEST_MAGIC, sizeof(MANIFEST_MAGIC));
+    writer.put(VERSION);
+    writer.put(_root_path);
+    writer.put(_root_mtime_sec);
+    writer.put(_root_mtime_nsec);
+    writer.put((uint32_t)_root_entries.size());
+    for (auto &entry : _root_entries) {
+        writer.put(entry.name);
+        writer.put((uint8_t)entry.is_directory);
+        writer.put((uint64_t)entry.folder_idx);
+    }
+    writer.put((uint32_t)_folders.size());
+    for (auto &folder : _folders) {
+        writer.put(folder.name);
+        writer.put(folder.mtime_sec);
+        writer.put(folder.mtime_nsec);
+        writer.put((int32_t)folder.label);
+        writer.put((uint64_t)folder.files.size());
+        for (auto &file : folder.files) {
+            writer.put(file.name);
+            writer.put(file.size);
+            writer.put(file.width);
+            writer.put(file.height);
+        }
+    }
+    // Publish the manifest atomically, other processes may be loading it
+    std::string tmp_path = _manifest_path + ".tmp." + TOSTR(getpid());
+    bool written = false;
+    {
+        std::ofstream manifest_file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (manifest_file)
+            written = static_cast<bool>(manifest_file.write(writer.buffer().data(), writer.buffer().size()));
+    }
+    if (!written || rename(tmp_path.c_str(), _manifest_path.c_str()) != 0) {
+        unlink(tmp_path.c_str());
+        WRN("DatasetManifest: Could not write the manifest " + _manifest_path)
+        return;
+    }
+    _dirty = false;
+}
@@ -24,8 +24,14 @@ THE SOFTWARE.
 #include <algorithm>
 #include <cstring>
 #include <math.h>
+#include <numeric>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "pipeline/commons.h"
 #include "readers/file_source_reader.h"
+#include "readers/dataset_manifest.h"
 #include "pipeline/filesystem.h"
 
 FileSourceReader::FileSourceReader() {
@@ -69,6 +75,8 @@ Reader::Status FileSourceReader::initialize(ReaderConfig desc) {
     _batch_size = desc.get_batch_size();
     _shuffle = desc.shuffle();
     _loop = desc.loop();
+    _file_read_mode = desc.file_read_mode();
+    _manifest_dir = desc.manifest_dir();
     _meta_data_reader = desc.meta_data_reader();
     _last_batch_info = desc.get_sharding_info();
     _pad_last_batch_repeated = _last_batch_info.pad_last_batch_repeated;
@@ -77,8 +85,8 @@ Reader::Status FileSourceReader::initialize(ReaderConfig desc) {
     ret = subfolder_reading();
     // shuffle dataset if set
     if (ret == Reader::Status::OK && _shuffle)
-        std::random_shuffle(_file_names.begin() + _shard_start_idx_vector[_shard_id],
-                            _file_names.begin() + _shard_end_idx_vector[_shard_id]);
+        std::random_shuffle(_file_order.begin() + _shard_start_idx_vector[_shard_id],
+                            _file_order.begin() + _shard_end_idx_vector[_shard_id]);
 
     return ret;
 }
@@ -101,14 +109,24 @@ void FileSourceReader::incremenet_read_ptr() {
     increment_curr_file_idx();
 }
 
-size_t FileSourceReader::open() {
-    auto file_path = _file_names[_curr_file_idx];  // Get next file name
+std::string FileSourceReader::advance_to_next_file() {
+    _last_sample_index = _file_order[_curr_file_idx];
+    auto file_path = _file_names[_last_sample_index];  // Get next file name
     incremenet_read_ptr();
     _last_file_path = _last_id = file_path;
     auto last_slash_idx = _last_id.find_last_of("\\/");
     if (std::string::npos != last_slash_idx) {
         _last_id.erase(0, last_slash_idx + 1);
     }
+    return file_path;
+}
+
+void FileSourceReader::open_deferred() {
+    advance_to_next_file();
+}
+
+size_t FileSourceReader::open() {
+    auto file_path = advance_to_next_file();
 
     _current_fPtr = fopen(file_path.c_str(), "rb");  // Open the file,
 
@@ -141,6 +159,35 @@ size_t FileSourceReader::read_data(unsigned char* buf, size_t read_size) {
     return actual_read_size;
 }
 
+unsigned char* FileSourceReader::map_data(size_t& size) {
+    open_deferred();
+    size = 0;
+    int fd = ::open(_last_file_path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    int flags = MAP_PRIVATE;
+    if (_file_read_mode == FileReadMode::MMAP_POPULATE)
+        flags |= MAP_POPULATE;
+    void* data = mmap(nullptr, file_stat.st_size, PROT_READ, flags, fd, 0);
+    ::close(fd);  // The mapping keeps its own reference to the file
+    if (data == MAP_FAILED)
+        return nullptr;
+    if (_file_read_mode == FileReadMode::MMAP)
+        madvise(data, file_stat.st_size, MADV_WILLNEED);
+    size = file_stat.st_size;
+    return static_cast<unsigned char*>(data);
+}
+
+void FileSourceReader::unmap_data(unsigned char* data, size_t size) {
+    if (data && size)
+        munmap(data, size);
+}
+
 int FileSourceReader::close() {
     return release();
 }
@@ -159,8 +206,8 @@ int FileSourceReader::release() {
 
 void FileSourceReader::reset() {
     if (_shuffle)
-        std::random_shuffle(_file_names.begin() + _shard_start_idx_vector[_shard_id],
-                            _file_names.begin() + _shard_start_idx_vector[_shard_id] + actual_shard_size_without_padding());
+        std::random_shuffle(_file_order.begin() + _shard_start_idx_vector[_shard_id],
+                            _file_order.begin() + _shard_start_idx_vector[_shard_id] + actual_shard_size_without_padding());
 
     if (_stick_to_shard == false)  // Pick elements from the next shard - hence increment shard_id
         increment_shard_id();      // Should work for both single and multiple shards
@@ -178,20 +225,6 @@ void FileSourceReader::increment_shard_id() {
 }
 
 Reader::Status FileSourceReader::generate_file_names() {
-    if ((_sub_dir = opendir(_folder_path.c_str())) == nullptr)
-        THROW("FileReader ShardID [" + TOSTR(_shard_id) + "] ERROR: Failed opening the directory at " + _folder_path);
-
-    std::vector<std::string> entry_name_list;
-    std::string _full_path = _folder_path;
-
-    while ((_entity = readdir(_sub_dir)) != nullptr) {
-        std::string entry_name(_entity->d_name);
-        if (strcmp(_entity->d_name, ".") == 0 || strcmp(_entity->d_name, "..") == 0) continue;
-        entry_name_list.push_back(entry_name);
-    }
-    closedir(_sub_dir);
-    std::sort(entry_name_list.begin(), entry_name_list.end());
-
     auto ret = Reader::Status::OK;
     if (!_file_list_path.empty()) {  // Reads the file paths from the file list and adds to file_names vector for decoding
         if (_meta_data_reader) {
@@ -232,20 +265,30 @@ Reader::Status FileSourceReader::generate_file_names() {
                 }
             }
         }
+    } else if (!_manifest_dir.empty()) {
+        ret = manifest_reading();
     } else {
+        if ((_sub_dir = opendir(_folder_path.c_str())) == nullptr)
+            THROW("FileReader ShardID [" + TOSTR(_shard_id) + "] ERROR: Failed opening the directory at " + _folder_path);
+
+        std::vector<std::string> entry_name_list;
+        std::string _full_path = _folder_path;
+
+        while ((_entity = readdir(_sub_dir)) != nullptr) {
+            std::string entry_name(_entity->d_name);
+            if (strcmp(_entity->d_name, ".") == 0 || strcmp(_entity->d_name, "..") == 0) continue;
+            entry_name_list.push_back(entry_name);
+        }
+        closedir(_sub_dir);
+        std::sort(entry_name_list.begin(), entry_name_list.end());
+
         for (unsigned dir_count = 0; dir_count < entry_name_list.size(); ++dir_count) {
             std::string subfolder_path = _full_path + "/" + entry_name_list[dir_count];
             filesys::path pathObj(subfolder_path);
             if (filesys::exists(pathObj) && filesys::is_regular_file(pathObj)) {
                 // ignore files with unsupported extensions
-                auto file_extension_idx = subfolder_path.find_last_of(".");
-                if (file_extension_idx != std::string::npos) {
-                    std::string file_extension = subfolder_path.substr(file_extension_idx + 1);
-                    std::transform(file_extension.begin(), file_extension.end(), file_extension.begin(),
-                                   [](unsigned char c) { return std::tolower(c); });
-                    if ((file_extension != "jpg") && (file_extension != "jpeg") && (file_extension != "png") && (file_extension != "ppm") && (file_extension != "bmp") && (file_extension != "pgm") && (file_extension != "tif") && (file_extension != "tiff") && (file_extension != "webp") && (file_extension != "wav"))
-                        continue;
-                }
+                if (!DatasetManifest::is_supported_file(subfolder_path))
+                    continue;
                 ret = open_folder();
                 break;  // assume directory has only files.
             } else if (filesys::exists(pathObj) && filesys::is_directory(pathObj)) {
@@ -286,6 +329,8 @@ Reader::Status FileSourceReader::generate_file_names() {
     }
 
     _last_file_name = _file_names[_file_names.size() - 1];
+    _file_order.resize(_file_names.size());
+    std::iota(_file_order.begin(), _file_order.end(), 0);
     compute_start_and_end_idx_of_all_shards();
 
     return ret;
@@ -311,14 +356,8 @@ Reader::Status FileSourceReader::open_folder() {
         if (!filesys::is_regular_file(filesys::path(file_path)))
             continue;
 
-        auto file_extension_idx = file_path.find_last_of(".");
-        if (file_extension_idx != std::string::npos) {
-            std::string file_extension = file_path.substr(file_extension_idx + 1);
-            std::transform(file_extension.begin(), file_extension.end(), file_extension.begin(),
-                           [](unsigned char c) { return std::tolower(c); });
-            if ((file_extension != "jpg") && (file_extension != "jpeg") && (file_extension != "png") && (file_extension != "ppm") && (file_extension != "bmp") && (file_extension != "pgm") && (file_extension != "tif") && (file_extension != "tiff") && (file_extension != "webp") && (file_extension != "wav"))
-                continue;
-        }
+        if (!DatasetManifest::is_supported_file(file_path))
+            continue;
         if (!_meta_data_reader || _meta_data_reader->exists(filename)) {  // Check if the file is present in metadata reader and add to file names list, to avoid issues while lookup
             _file_names.push_back(file_path);
             _last_file_name = file_path;
@@ -334,6 +373,36 @@ Reader::Status FileSourceReader::open_folder() {
     return Reader::Status::OK;
 }
 
+Reader::Status FileSourceReader::manifest_reading() {
+    // Same listing as open_folder() on the root or on each of its sub folders, taken from the dataset manifest
+    auto manifest = DatasetManifest::get(_manifest_dir, _folder_path);
+    auto add_folder = [&](size_t folder_idx) {
+        auto &folder = manifest->folder(folder_idx);
+        for (size_t file_idx = 0; file_idx < folder.files.size(); file_idx++) {
+            auto &filename = folder.files[file_idx].name;
+            if (!DatasetManifest::is_supported_file(filename))
+                continue;
+            if (!_meta_data_reader || _meta_data_reader->exists(filename)) {  // Check if the file is present in metadata reader and add to file names list, to avoid issues while lookup
+                _file_names.push_back(_folder_path + "/" + manifest->relative_path(folder_idx, file_idx));
+                _last_file_name = _file_names.back();
+                _file_count_all_shards++;
+            } else {
+                WRN("Skipping file," + filename + " as it is not present in metadata reader")
+            }
+        }
+    };
+    for (auto &entry : manifest->root_entries()) {
+        if (!entry.is_directory) {
+            if (!DatasetManifest::is_supported_file(entry.name))
+                continue;
+            add_folder(0);
+            break;  // assume directory has only files.
+        }
+        add_folder(entry.folder_idx);
+    }
+    return Reader::Status::OK;
+}
+
 size_t FileSourceReader::last_batch_padded_size() {
     return _last_batch_padded_size;
 }
@@ -25,8 +25,39 @@ THE SOFTWARE.
 #include <sstream>
 #include <string>
 #include <vector>
+#include "readers/image/proto_wire_format.h"
 using namespace std;
 
+namespace {
+// Locates the byte_data (= 5) of the first TensorProto in a serialized caffe2_protos::TensorProtos (protos = 1)
+// \return false if there is no TensorProto, throws if the first one has no byte_data
+bool locate_image_bytes(unsigned char *value, size_t size, unsigned char *&data, size_t &data_size) {
+    const uint8_t *image_proto = nullptr, *image_proto_end = nullptr;
+    data = nullptr;
+    data_size = 0;
+    if (!proto_wire::for_each_field(value, value + size, [&](uint64_t field, const uint8_t *begin, const uint8_t *end) {
+            if (field == 1 && !image_proto) {
+                image_proto = begin;
+                image_proto_end = end;
+            }
+            return true;
+        }))
+        THROW("Parsing Protos Failed");
+    if (!image_proto)
+        return false;
+    proto_wire::for_each_field(image_proto, image_proto_end, [&](uint64_t field, const uint8_t *begin, const uint8_t *end) {
+        if (field == 5) {
+            data = const_cast<unsigned char *>(begin);
+            data_size = end - begin;
+        }
+        return true;
+    });
+    if (!data)
+        THROW("\n Image parsing failed");
+    return true;
+}
+}  // namespace
+
 Caffe2LMDBRecordReader::Caffe2LMDBRecordReader() {
     _src_dir = nullptr;
     _sub_dir = nullptr;
@@ -85,6 +116,16 @@ size_t Caffe2LMDBRecordReader::open() {
     return _current_file_size;
 }
 
+unsigned char *Caffe2LMDBRecordReader::map_data(size_t &size) {
+    open();
+    auto it = _record_data.find(_file_names[_curr_file_idx]);
+    if (_record_data.end() == it)
+        THROW("Key Not found");
+    size = it->second.size;
+    incremenet_read_ptr();
+    return it->second.data;
+}
+
 size_t Caffe2LMDBRecordReader::read_data(unsigned char *buf, size_t read_size) {
     read_image(buf, _file_names[_curr_file_idx]);
     incremenet_read_ptr();
@@ -96,13 +137,15 @@ int Caffe2LMDBRecordReader::close() {
 }
 
 Caffe2LMDBRecordReader::~Caffe2LMDBRecordReader() {
-    _open_env = 0;
-    mdb_txn_abort(_read_mdb_txn);
-    mdb_close(_read_mdb_env, _read_mdb_dbi);
-    mdb_env_close(_read_mdb_env);
+    release();
+    _record_data.clear();
+    if (_read_mdb_env) {
+        mdb_txn_abort(_read_mdb_txn);
+        mdb_close(_read_mdb_env, _read_mdb_dbi);
+        mdb_env_close(_read_mdb_env);
+    }
     _read_mdb_txn = nullptr;
     _read_mdb_env = nullptr;
-    release();
 }
 
 int Caffe2LMDBRecordReader::release() {
@@ -156,7 +199,6 @@ void Caffe2LMDBRecordReader::replicate_last_batch_to_pad_partial_shard() {
 }
 
 Reader::Status Caffe2LMDBRecordReader::Caffe2_LMDB_reader() {
-    _open_env = 0;
     string tmp1 = _folder_path + "/data.mdb";
     string tmp2 = _folder_path + "/lock.mdb";
     uint file_size, file_size1;
@@ -180,30 +222,17 @@ size_t Caffe2LMDBRecordReader::get_file_shard_id() {
 
 void Caffe2LMDBRecordReader::read_image_names() {
     int rc;
-    MDB_env *env;
-    MDB_dbi dbi;
     MDB_val key, data;
-    MDB_txn *txn;
     MDB_cursor *cursor;
-    string str_key, str_data;
-
-    // Creating an LMDB environment handle
-    CHECK_LMDB_RETURN_STATUS(mdb_env_create(&env));
-    // Setting the size of the memory map to use for this environment.
-    // The size of the memory map is also the maximum size of the database.
-    CHECK_LMDB_RETURN_STATUS(mdb_env_set_mapsize(env, _file_byte_size));
-    // Opening an environment handle.
-    CHECK_LMDB_RETURN_STATUS(mdb_env_open(env, _folder_path.c_str(), 0, 0664));
-    // Creating a transaction for use with the environment.
-    CHECK_LMDB_RETURN_STATUS(mdb_txn_begin(env, NULL, MDB_RDONLY, &txn));
-    // Opening a database in the environment.
-    CHECK_LMDB_RETURN_STATUS(mdb_dbi_open(txn, NULL, 0, &dbi));
+    string str_key;
+    open_env_for_read_image();
 
     // Creating a cursor handle.
     // A cursor is associated with a specific transaction and database
-    CHECK_LMDB_RETURN_STATUS(mdb_cursor_open(txn, dbi, &cursor));
+    CHECK_LMDB_RETURN_STATUS(mdb_cursor_open(_read_mdb_txn, _read_mdb_dbi, &cursor));
 
     // Retrieve by cursor. It retrieves key/data pairs from the database
+    // The location of the image bytes of each record is kept, the values stay mapped as long as _read_mdb_txn is open
     while ((rc = mdb_cursor_get(cursor, &key, &data, MDB_NEXT)) == 0) {
         str_key = string((char *)key.mv_data);
         if (get_file_shard_id() != _shard_id) {
@@ -212,29 +241,18 @@ void Caffe2LMDBRecordReader::read_image_names() {
         }
         _in_batch_read_count++;
         _in_batch_read_count = (_in_batch_read_count % _batch_count == 0) ? 0 : _in_batch_read_count;
-        str_data = string((char *)data.mv_data);
-        caffe2_protos::TensorProtos tens_protos;
-        tens_protos.ParseFromArray((char *)data.mv_data, data.mv_size);
-        int protos_size = tens_protos.protos_size();
-        if (protos_size != 0) {
-            caffe2_protos::TensorProto image_proto = tens_protos.protos(0);
-            bool chk_byte_data = image_proto.has_byte_data();
-            if (chk_byte_data) {
-                _file_names.push_back(str_key.c_str());
-                _last_file_name = str_key.c_str();
-                _last_file_size = image_proto.byte_data().size();
-                _file_size.insert(pair<std::string, unsigned int>(_last_file_name, _last_file_size));
-            } else {
-                THROW("\n Image parsing failed");
-            }
+        RecordData record;
+        if (locate_image_bytes((unsigned char *)data.mv_data, data.mv_size, record.data, record.size)) {
+            _file_names.push_back(str_key.c_str());
+            _last_file_name = str_key.c_str();
+            _last_file_size = record.size;
+            _file_size.insert(pair<std::string, unsigned int>(_last_file_name, _last_file_size));
+            _record_data[_last_file_name] = record;
         }
         incremenet_file_id();
     }
 
     mdb_cursor_close(cursor);
-    mdb_txn_abort(txn);
-    mdb_close(env, dbi);
-    mdb_env_close(env);
 }
 
 void Caffe2LMDBRecordReader::open_env_for_read_image() {
@@ -249,50 +267,11 @@ void Caffe2LMDBRecordReader::open_env_for_read_image() {
     CHECK_LMDB_RETURN_STATUS(mdb_txn_begin(_read_mdb_env, NULL, MDB_RDONLY, &_read_mdb_txn));
     // Opening a database in the environment.
     CHECK_LMDB_RETURN_STATUS(mdb_open(_read_mdb_txn, NULL, 0, &_read_mdb_dbi));
-    _open_env = 1;
 }
 
-void Caffe2LMDBRecordReader::read_image(unsigned char *buff, std::string file_name) {
-    if (_open_env == 0)
-        open_env_for_read_image();
-
-    // Creating a cursor handle.
-    // A cursor is associated with a specific transaction and database
-    CHECK_LMDB_RETURN_STATUS(mdb_cursor_open(_read_mdb_txn, _read_mdb_dbi, &_read_mdb_cursor));
-
-    string checkedStr = string((char *)file_name.c_str());
-    string newStr = checkedStr.substr(0, checkedStr.find(".")) + ".JPEG";
-
-    _read_mdb_key.mv_size = newStr.size();
-    _read_mdb_key.mv_data = (char *)newStr.c_str();
-
-    int _mdb_status = mdb_cursor_get(_read_mdb_cursor, &_read_mdb_key, &_read_mdb_value, MDB_SET_RANGE);
-    if (_mdb_status == MDB_NOTFOUND) {
+void Caffe2LMDBRecordReader::read_image(unsigned char *buff, const std::string &file_name) {
+    auto it = _record_data.find(file_name);
+    if (_record_data.end() == it)
         THROW("Key Not found");
-    } else {
-        // Parsing Image and Label Protos using the key and data values
-        // read from LMDB records
-        caffe2_protos::TensorProtos tens_protos;
-
-        tens_protos.ParseFromArray((char *)_read_mdb_value.mv_data, _read_mdb_value.mv_size);
-
-        // Checking size of the protos
-        int protos_size = tens_protos.protos_size();
-        if (protos_size != 0) {
-            caffe2_protos::TensorProto image_proto = tens_protos.protos(0);
-            // Checking if image bytes is present or not
-            bool chk_byte_data = image_proto.has_byte_data();
-
-            if (chk_byte_data) {
-                memcpy(buff, image_proto.byte_data().c_str(), image_proto.byte_data().size());
-            } else {
-                THROW("Image Parsing Failed");
-            }
-        } else {
-            THROW("Parsing Protos Failed");
-        }
-    }
-    // Closing cursor handles
-    mdb_cursor_close(_read_mdb_cursor);
-    _read_mdb_cursor = nullptr;
+    memcpy(buff, it->second.data, it->second.size);
 }
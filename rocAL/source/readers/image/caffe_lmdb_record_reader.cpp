@@ -23,13 +23,40 @@ THE SOFTWARE.
 #include "readers/image/caffe_lmdb_record_reader.h"
 
 #include "pipeline/commons.h"
+#include "readers/image/proto_wire_format.h"
 #include <iostream>
 #include <sstream>
 #include <string>
 #include <vector>
 
 using namespace std;
-using caffe_protos::Datum;
+
+namespace {
+// Locates the image bytes of a serialized caffe_protos::Datum (data = 4), which is wrapped in an AnnotatedDatum (datum = 1) for detection.
+// A Datum starts with its varint channels field, an AnnotatedDatum with the length delimited datum, which tells them apart.
+bool locate_datum_data(unsigned char *value, size_t size, unsigned char *&data, size_t &data_size) {
+    const uint8_t *datum = value, *datum_end = value + size;
+    data = nullptr;
+    data_size = 0;
+    if (proto_wire::is_length_delimited(value, value + size, 1)) {
+        if (!proto_wire::for_each_field(value, value + size, [&](uint64_t field, const uint8_t *begin, const uint8_t *end) {
+                if (field == 1) {
+                    datum = begin;
+                    datum_end = end;
+                }
+                return true;
+            }))
+            return false;
+    }
+    return proto_wire::for_each_field(datum, datum_end, [&](uint64_t field, const uint8_t *begin, const uint8_t *end) {
+        if (field == 4) {
+            data = const_cast<unsigned char *>(begin);
+            data_size = end - begin;
+        }
+        return true;
+    });
+}
+}  // namespace
 
 CaffeLMDBRecordReader::CaffeLMDBRecordReader()
 {
@@ -90,6 +117,16 @@ size_t CaffeLMDBRecordReader::open() {
     return _current_file_size;
 }
 
+unsigned char *CaffeLMDBRecordReader::map_data(size_t &size) {
+    open();
+    auto it = _record_data.find(_file_names[_curr_file_idx]);
+    if (_record_data.end() == it)
+        THROW("\nKey Not found");
+    size = it->second.size;
+    incremenet_read_ptr();
+    return it->second.data;
+}
+
 size_t CaffeLMDBRecordReader::read_data(unsigned char *buf, size_t read_size) {
     read_image(buf, _file_names[_curr_file_idx]);
     incremenet_read_ptr();
@@ -101,24 +138,18 @@ int CaffeLMDBRecordReader::close() {
 }
 
 CaffeLMDBRecordReader::~CaffeLMDBRecordReader() {
-    _open_env = 0;
-    mdb_txn_abort(_read_mdb_txn);
-    mdb_close(_read_mdb_env, _read_mdb_dbi);
-    mdb_env_close(_read_mdb_env);
+    release();
+    _record_data.clear();
+    if (_read_mdb_env) {
+        mdb_txn_abort(_read_mdb_txn);
+        mdb_close(_read_mdb_env, _read_mdb_dbi);
+        mdb_env_close(_read_mdb_env);
+    }
     _read_mdb_txn = nullptr;
     _read_mdb_env = nullptr;
-    release();
 }
 
 int CaffeLMDBRecordReader::release() {
-    mdb_cursor_close(_mdb_cursor);
-    mdb_txn_abort(_mdb_txn);
-    mdb_close(_mdb_env, _mdb_dbi);
-
-    mdb_env_close(_mdb_env);
-    _mdb_cursor = nullptr;
-    _mdb_txn = nullptr;
-    _mdb_env = nullptr;
     return 0;
 }
 
@@ -155,7 +186,6 @@ void CaffeLMDBRecordReader::replicate_last_image_to_fill_last_shard() {
 }
 
 Reader::Status CaffeLMDBRecordReader::Caffe_LMDB_reader() {
-    _open_env = 0;
     string tmp1 = _folder_path + "/data.mdb";
     string tmp2 = _folder_path + "/lock.mdb";
     uint file_size, file_size1;
@@ -179,52 +209,38 @@ size_t CaffeLMDBRecordReader::get_file_shard_id() {
 
 void CaffeLMDBRecordReader::read_image_names() {
     int rc;
-    // Creating an LMDB environment handle
-    CHECK_LMDB_RETURN_STATUS(mdb_env_create(&_mdb_env));
-    // Setting the size of the memory map to use for this environment.
-    // The size of the memory map is also the maximum size of the database.
-    CHECK_LMDB_RETURN_STATUS(mdb_env_set_mapsize(_mdb_env, _file_byte_size));
-    // Opening an environment handle.
-    CHECK_LMDB_RETURN_STATUS(mdb_env_open(_mdb_env, _path.c_str(), MDB_RDONLY, 0664));
-    // Creating a transaction for use with the environment
-    CHECK_LMDB_RETURN_STATUS(mdb_txn_begin(_mdb_env, NULL, MDB_RDONLY, &_mdb_txn));
-    // Opening a database in the environment.
-    CHECK_LMDB_RETURN_STATUS(mdb_open(_mdb_txn, NULL, 0, &_mdb_dbi));
+    MDB_val mdb_key, mdb_value;
+    MDB_cursor *mdb_cursor;
+    open_env_for_read_image();
     // Creating a cursor handle.
     // A cursor is associated with a specific transaction and database
-    CHECK_LMDB_RETURN_STATUS(mdb_cursor_open(_mdb_txn, _mdb_dbi, &_mdb_cursor));
+    CHECK_LMDB_RETURN_STATUS(mdb_cursor_open(_read_mdb_txn, _read_mdb_dbi, &mdb_cursor));
 
     // Retrieve by cursor. It retrieves key/data pairs from the database
-    while ((rc = mdb_cursor_get(_mdb_cursor, &_mdb_key, &_mdb_value, MDB_NEXT)) == 0) {
-        Datum datum;
-        caffe_protos::AnnotatedDatum annotatedDatum_protos;
-        annotatedDatum_protos.ParseFromArray((char *)_mdb_value.mv_data, _mdb_value.mv_size);
-        // Checking image Datum
-        int check_image_datum = annotatedDatum_protos.has_datum();
-
-        if (check_image_datum)
-            datum = annotatedDatum_protos.datum();  // parse datum for detection
-        else
-            datum.ParseFromArray((const void *)_mdb_value.mv_data, _mdb_value.mv_size);  // parse datum for classification
-        if ((!_meta_data_reader || _meta_data_reader->exists(string((char *)_mdb_key.mv_data).c_str()))) {
+    // The location of the image bytes of each record is kept, the values stay mapped as long as _read_mdb_txn is open
+    while ((rc = mdb_cursor_get(mdb_cursor, &mdb_key, &mdb_value, MDB_NEXT)) == 0) {
+        if ((!_meta_data_reader || _meta_data_reader->exists(string((char *)mdb_key.mv_data).c_str()))) {
             if (get_file_shard_id() != _shard_id) {
                 _file_count_all_shards++;
                 incremenet_file_id();
                 continue;
             }
+            RecordData record;
+            if (!locate_datum_data((unsigned char *)mdb_value.mv_data, mdb_value.mv_size, record.data, record.size))
+                THROW("CaffeLMDBRecordReader: Datum parsing failed")
             _in_batch_read_count++;
             _in_batch_read_count = (_in_batch_read_count % _batch_count == 0) ? 0 : _in_batch_read_count;
-            string image_key = string((char *)_mdb_key.mv_data);
+            string image_key = string((char *)mdb_key.mv_data);
             _file_names.push_back(image_key.c_str());
             _last_file_name = image_key.c_str();
             _file_count_all_shards++;
             incremenet_file_id();
-            _last_file_size = datum.data().size();
+            _last_file_size = record.size;
             _file_size.insert(pair<std::string, unsigned int>(_last_file_name, _last_file_size));
+            _record_data[_last_file_name] = record;
         }
     }
-
-    release();
+    mdb_cursor_close(mdb_cursor);
 }
 
 void CaffeLMDBRecordReader::replicate_last_batch_to_pad_partial_shard() {
@@ -252,43 +268,11 @@ void CaffeLMDBRecordReader::open_env_for_read_image() {
     CHECK_LMDB_RETURN_STATUS(mdb_txn_begin(_read_mdb_env, NULL, MDB_RDONLY, &_read_mdb_txn));
     // Opening a database in the environment.
     CHECK_LMDB_RETURN_STATUS(mdb_open(_read_mdb_txn, NULL, 0, &_read_mdb_dbi));
-    _open_env = 1;
 }
 
-void CaffeLMDBRecordReader::read_image(unsigned char *buff, std::string file_name) {
-    if (_open_env == 0) {
-        open_env_for_read_image();
-    }
-
-    // Creating a cursor handle.
-    // A cursor is associated with a specific transaction and database
-    CHECK_LMDB_RETURN_STATUS(mdb_cursor_open(_read_mdb_txn, _read_mdb_dbi, &_read_mdb_cursor));
-
-    string checkedStr = string((char *)file_name.c_str());
-    string newStr = checkedStr.substr(0, checkedStr.find(".")) + ".JPEG";
-
-    _read_mdb_key.mv_size = newStr.size();
-    _read_mdb_key.mv_data = (char *)newStr.c_str();
-
-    int _mdb_status = mdb_cursor_get(_read_mdb_cursor, &_read_mdb_key, &_read_mdb_value, MDB_SET_RANGE);
-    if (_mdb_status == MDB_NOTFOUND) {
+void CaffeLMDBRecordReader::read_image(unsigned char *buff, const std::string &file_name) {
+    auto it = _record_data.find(file_name);
+    if (_record_data.end() == it)
         THROW("\nKey Not found");
-    } else {
-        Datum datum;
-        caffe_protos::AnnotatedDatum annotatedDatum_protos;
-        annotatedDatum_protos.ParseFromArray((char *)_read_mdb_value.mv_data, _read_mdb_value.mv_size);
-
-        // Checking image Datum
-        int check_image_datum = annotatedDatum_protos.has_datum();
-
-        if (check_image_datum)
-            datum = annotatedDatum_protos.datum();  // parse datum for detection
-        else
-            datum.ParseFromArray((const void *)_read_mdb_value.mv_data, _read_mdb_value.mv_size);  // parse datum for classification
-
-        memcpy(buff, datum.data().c_str(), datum.data().size());
-    }
-
-    mdb_cursor_close(_read_mdb_cursor);
-    _read_mdb_cursor = nullptr;
+    memcpy(buff, it->second.data, it->second.size);
 }
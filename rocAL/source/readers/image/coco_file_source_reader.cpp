@@ -24,6 +24,7 @@ THE SOFTWARE.
 #include "meta_data/meta_data_reader_factory.h"
 #include "meta_data/meta_data_graph_factory.h"
 #include "pipeline/filesystem.h"
+#include "readers/dataset_manifest.h"
 
 #define USE_STDIO_FILE 0
 
@@ -59,6 +60,7 @@ Reader::Status COCOFileSourceReader::initialize(ReaderConfig desc) {
     _loop = desc.loop();
     _shuffle = desc.shuffle();
     _meta_data_reader = desc.meta_data_reader();
+    _manifest_dir = desc.manifest_dir();
 
     if (_json_path == "") {
         std::cout << "\n _json_path has to be set manually";
@@ -67,7 +69,7 @@ Reader::Status COCOFileSourceReader::initialize(ReaderConfig desc) {
     // if (!_meta_data_reader )
     //     std::cout<<"Metadata reader not initialized for COCO file source\n";
 
-    ret = subfolder_reading();
+    ret = _manifest_dir.empty() ? subfolder_reading() : manifest_reading();
     // the following code is required to make every shard the same size:: required for multi-gpu training
     if (_shard_count > 1 && _batch_count > 1) {
         int _num_batches = _file_names.size() / _batch_count;
@@ -118,14 +120,23 @@ void COCOFileSourceReader::incremenet_read_ptr() {
     _read_counter++;
     _curr_file_idx = (_curr_file_idx + 1) % _file_names.size();
 }
-size_t COCOFileSourceReader::open() {
+std::string COCOFileSourceReader::advance_to_next_file() {
     auto file_path = _file_names[_curr_file_idx];  // Get next file name
     incremenet_read_ptr();
-    _last_id = file_path;
+    _last_file_path = _last_id = file_path;
     auto last_slash_idx = _last_id.find_last_of("\\/");
     if (std::string::npos != last_slash_idx) {
         _last_id.erase(0, last_slash_idx + 1);
     }
+    return file_path;
+}
+
+void COCOFileSourceReader::open_deferred() {
+    advance_to_next_file();
+}
+
+size_t COCOFileSourceReader::open() {
+    auto file_path = advance_to_next_file();
 
 #if USE_STDIO_FILE
     _current_fPtr = fopen(file_path.c_str(), "rb");  // Open the file,
@@ -261,6 +272,50 @@ Reader::Status COCOFileSourceReader::subfolder_reading() {
     closedir(_sub_dir);
     return ret;
 }
+Reader::Status COCOFileSourceReader::manifest_reading() {
+    auto manifest = DatasetManifest::get(_manifest_dir, _folder_path);
+    auto &root_entries = manifest->root_entries();
+    if (root_entries.empty())
+        THROW("FileReader ShardID [" + TOSTR(_shard_id) + "] ERROR: No files found at " + _folder_path);
+    // Same listing as open_folder() on the root or on each of its sub folders, taken from the dataset manifest
+    auto add_folder = [&](size_t folder_idx) {
+        auto &folder = manifest->folder(folder_idx);
+        for (size_t file_idx = 0; file_idx < folder.files.size(); file_idx++) {
+            if (_meta_data_reader && !_meta_data_reader->exists(folder.files[file_idx].name))
+                continue;
+            if (get_file_shard_id() != _shard_id) {
+                _file_count_all_shards++;
+                incremenet_file_id();
+                continue;
+            }
+            _in_batch_read_count++;
+            _in_batch_read_count = (_in_batch_read_count % _batch_count == 0) ? 0 : _in_batch_read_count;
+            _file_names.push_back(_folder_path + "/" + manifest->relative_path(folder_idx, file_idx));
+            _file_count_all_shards++;
+            incremenet_file_id();
+        }
+    };
+    if (!root_entries[0].is_directory) {
+        add_folder(0);
+    } else {
+        for (auto &entry : root_entries)
+            if (entry.is_directory)
+                add_folder(entry.folder_idx);
+    }
+    if (_file_names.empty())
+        WRN("FileReader ShardID [" + TOSTR(_shard_id) + "] Did not load any file from " + _folder_path)
+    std::sort(_file_names.begin(), _file_names.end());
+    if (!_file_names.empty())
+        _last_file_name = _file_names.back();
+    if (_in_batch_read_count > 0 && _in_batch_read_count < _batch_count) {
+        replicate_last_image_to_fill_last_shard();
+        LOG("FileReader ShardID [" + TOSTR(_shard_id) + "] Replicated " + _last_file_name + " " + TOSTR((_batch_count - _in_batch_read_count)) + " times to fill the last batch")
+    }
+    if (!_file_names.empty())
+        LOG("FileReader ShardID [" + TOSTR(_shard_id) + "] Total of " + TOSTR(_file_names.size()) + " images loaded from " + _folder_path)
+    return Reader::Status::OK;
+}
+
 void COCOFileSourceReader::replicate_last_image_to_fill_last_shard() {
     for (size_t i = _in_batch_read_count; i < _batch_count; i++)
         _file_names.push_back(_last_file_name);
@@ -23,10 +23,14 @@ THE SOFTWARE.
 #include "readers/image/mxnet_recordio_reader.h"
 
 #include "pipeline/commons.h"
+#include <fcntl.h>
 #include <memory.h>
 #include <stdint.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "readers/image/mxnet_recordio_reader.h"
 #include "pipeline/filesystem.h"
+#include "pipeline/task_scheduler.h"
 
 using namespace std;
 
@@ -58,6 +62,8 @@ Reader::Status MXNetRecordIOReader::initialize(ReaderConfig desc) {
     _batch_count = desc.get_batch_size();
     _loop = desc.loop();
     _shuffle = desc.shuffle();
+    _file_read_mode = desc.file_read_mode();
+    _num_threads = std::max(desc.get_cpu_num_threads(), (size_t)1);
     ret = record_reading();
     // the following code is required to make every shard the same size:: required for multi-gpu training
     if (_shard_count > 1 && _batch_count > 1) {
@@ -87,10 +93,24 @@ size_t MXNetRecordIOReader::open() {
     return _current_file_size;
 }
 
+unsigned char *MXNetRecordIOReader::map_data(size_t &size) {
+    open();
+    size = _current_file_size;
+    unsigned char *data = _rec_data + _seek_pos;
+    if (_file_read_mode == FileReadMode::MMAP) {
+        // Prefetch the pages of this record only, advising the whole .rec file would read it in entirely
+        static const uintptr_t page_mask = ~((uintptr_t)sysconf(_SC_PAGESIZE) - 1);
+        unsigned char *page_start = (unsigned char *)((uintptr_t)data & page_mask);
+        madvise(page_start, (data + size) - page_start, MADV_WILLNEED);
+    }
+    incremenet_read_ptr();
+    return data;
+}
+
 size_t MXNetRecordIOReader::read_data(unsigned char *buf, size_t read_size) {
     auto it = _record_properties.find(_file_names[_curr_file_idx]);
     std::tie(_current_file_size, _seek_pos, _data_size_to_read) = it->second;
-    read_image(buf, _seek_pos, _data_size_to_read);
+    read_image(buf, _seek_pos, _current_file_size);
     incremenet_read_ptr();
     return read_size;
 }
@@ -100,6 +120,12 @@ int MXNetRecordIOReader::close() {
 }
 
 MXNetRecordIOReader::~MXNetRecordIOReader() {
+    if (_rec_data)
+        munmap(_rec_data, _rec_size);
+    _rec_data = nullptr;
+    if (_rec_fd >= 0)
+        ::close(_rec_fd);
+    _rec_fd = -1;
 }
 
 int MXNetRecordIOReader::release() {
@@ -167,13 +193,14 @@ Reader::Status MXNetRecordIOReader::MXNet_reader() {
         }
     }
     closedir(_src_dir);
-    uint rec_size;
-    _file_contents.open(_rec_file, ios::binary);
-    if (!_file_contents)
+    size_t rec_size;
+    struct stat rec_stat;
+    _rec_fd = ::open(_rec_file.c_str(), O_RDONLY);
+    if (_rec_fd < 0 || fstat(_rec_fd, &rec_stat) != 0)
         THROW("MXNetRecordIOReader ERROR: Failed opening the file " + _rec_file);
-    _file_contents.seekg(0, ifstream::end);
-    rec_size = _file_contents.tellg();
-    _file_contents.seekg(0, ifstream::beg);
+    rec_size = rec_stat.st_size;
+    if (_file_read_mode != FileReadMode::COPY)
+        map_record_file(rec_size);
 
     ifstream index_file(_idx_file);
     if (!index_file)
@@ -199,27 +226,54 @@ size_t MXNetRecordIOReader::get_file_shard_id() {
     return _file_id % _shard_count;
 }
 
+void MXNetRecordIOReader::map_record_file(size_t rec_size) {
+    int flags = MAP_SHARED;
+    if (_file_read_mode == FileReadMode::MMAP_POPULATE)
+        flags |= MAP_POPULATE;
+    void *data = mmap(nullptr, rec_size, PROT_READ, flags, _rec_fd, 0);
+    if (data == MAP_FAILED) {
+        WRN("MXNetRecordIOReader could not map the .rec file, falling back to copying the records")
+        return;
+    }
+    _rec_data = static_cast<unsigned char *>(data);
+    _rec_size = rec_size;
+}
+
 void MXNetRecordIOReader::read_image_names() {
-    for (int current_index = 0; current_index < (int)_indices.size(); current_index++) {
-        uint32_t _magic, _length_flag;
+    // Only the magic, length and ImageRecordIOHeader of each record are needed here, they are fetched in parallel
+    // straight from the mapping or with pread() without touching the image data
+    static const size_t record_header_size = 2 * sizeof(uint32_t) + sizeof(ImageRecordIOHeader);
+    const int record_count = _indices.size();
+    std::vector<uint32_t> length_flags(record_count);
+    std::vector<ImageRecordIOHeader> headers(record_count);
+    std::vector<int> valid(record_count, 0);
+    // The scan runs on the shared task scheduler so that it stays within the thread budget of the pipeline
+    TaskScheduler::instance().parallel_for(record_count, _num_threads, TaskPriority::NORMAL, [&](size_t current_index, size_t) {
+        int64_t seek_pos, data_size;
+        std::tie(seek_pos, data_size) = _indices[current_index];
+        if (data_size < (int64_t)record_header_size)
+            return;
+        uint8_t header[record_header_size];
+        if (_rec_data)
+            memcpy(header, _rec_data + seek_pos, record_header_size);
+        else if (pread(_rec_fd, header, record_header_size, seek_pos) != (ssize_t)record_header_size)
+            return;
+        uint32_t magic;
+        memcpy(&magic, header, sizeof(magic));
+        if (magic != _kMagic)
+            return;
+        memcpy(&length_flags[current_index], header + sizeof(magic), sizeof(uint32_t));
+        memcpy(&headers[current_index], header + 2 * sizeof(uint32_t), sizeof(ImageRecordIOHeader));
+        valid[current_index] = 1;
+    });
+    for (int current_index = 0; current_index < record_count; current_index++) {
+        if (!valid[current_index])
+            THROW("MXNetRecordIOReader ERROR: Invalid MXNet RecordIO: wrong _magic number or truncated record");
         std::tie(_seek_pos, _data_size_to_read) = _indices[current_index];
-        _file_contents.seekg(_seek_pos, ifstream::beg);
-        uint8_t *_data = new uint8_t[_data_size_to_read];
-        uint8_t *_data_ptr = _data;
-        auto ret = _file_contents.read((char *)_data_ptr, _data_size_to_read).gcount();
-        if (ret == -1 || ret != _data_size_to_read)
-            THROW("MXNetRecordIOReader ERROR:  Unable to read the data from the file ");
-
-        _magic = *((uint32_t *)_data_ptr);
-        _data_ptr += sizeof(_magic);
-        if (_magic != _kMagic)
-            THROW("MXNetRecordIOReader ERROR: Invalid MXNet RecordIO: wrong _magic number");
-        _length_flag = *((uint32_t *)_data_ptr);
-        _data_ptr += sizeof(_length_flag);
-        uint32_t _clength = DecodeLength(_length_flag);
-        _hdr = *((ImageRecordIOHeader *)_data_ptr);
+        uint32_t _clength = DecodeLength(length_flags[current_index]);
+        _hdr = headers[current_index];
 
-        if (_hdr.flag == 0)
+        if (_hdr.flag == 0 && DecodeFlag(length_flags[current_index]) == 0)
             _image_key = to_string(_hdr.image_id[0]);
         else {
             WRN("\nMXNetRecordIOReader Multiple record reading has not supported");
@@ -227,8 +281,8 @@ void MXNetRecordIOReader::read_image_names() {
         }
         /* _clength - sizeof(ImageRecordIOHeader) to get the data size.
         Subtracting label size(_hdr.flag * sizeof(float)) from data size to get image size*/
-        int64_t image_size = (_clength - sizeof(ImageRecordIOHeader)) - (_hdr.flag * sizeof(float));
-        delete[] _data;
+        int64_t label_size = _hdr.flag * sizeof(float);
+        int64_t image_size = (_clength - sizeof(ImageRecordIOHeader)) - label_size;
 
         if (get_file_shard_id() != _shard_id) {
             incremenet_file_id();
@@ -245,38 +299,23 @@ void MXNetRecordIOReader::read_image_names() {
         _file_count_all_shards++;
 
         _last_file_size = image_size;
-        _last_seek_pos = _seek_pos;
+        _last_seek_pos = _seek_pos + record_header_size + label_size;
         _last_data_size = _data_size_to_read;
-        //_record_properties vector used to keep track of image size, seek position and data size of the single
+        //_record_properties vector used to keep track of image size, image offset in the .rec file and data size of the single record
         _record_properties.insert(pair<std::string, std::tuple<unsigned int, int64_t, int64_t>>(_last_file_name, std::make_tuple(_last_file_size, _last_seek_pos, _last_data_size)));
     }
 }
 
-void MXNetRecordIOReader::read_image(unsigned char *buff, int64_t seek_position, int64_t _data_size_to_read) {
-    uint32_t _magic, _length_flag;
-    _file_contents.seekg(seek_position, ifstream::beg);
-    uint8_t *_data = new uint8_t[_data_size_to_read];
-    uint8_t *_data_ptr = _data;
-    auto ret = _file_contents.read((char *)_data_ptr, _data_size_to_read).gcount();
-    if (ret == -1 || ret != _data_size_to_read)
-        THROW("MXNetRecordIOReader ERROR:  Unable to read the data from the file ");
-    _magic = *((uint32_t *)_data_ptr);
-    _data_ptr += sizeof(_magic);
-    if (_magic != _kMagic)
-        THROW("MXNetRecordIOReader ERROR: Invalid RecordIO: wrong _magic number");
-    _length_flag = *((uint32_t *)_data_ptr);
-    _data_ptr += sizeof(_length_flag);
-    uint32_t _cflag = DecodeFlag(_length_flag);
-    uint32_t _clength = DecodeLength(_length_flag);
-    _hdr = *((ImageRecordIOHeader *)_data_ptr);
-    _data_ptr += sizeof(_hdr);
-
-    int64_t data_size = _clength - sizeof(ImageRecordIOHeader);
-    int64_t label_size = _hdr.flag * sizeof(float);
-    int64_t image_size = data_size - label_size;
-    if (_cflag == 0)
-        memcpy(buff, _data_ptr + label_size, image_size);
-    else
-        THROW("\nMultiple record reading has not supported");
-    delete[] _data;
-}
\ No newline at end of file
+void MXNetRecordIOReader::read_image(unsigned char *buff, int64_t image_offset, int64_t image_size) {
+    if (_rec_data) {
+        memcpy(buff, _rec_data + image_offset, image_size);
+        return;
+    }
+    int64_t read_size = 0;
+    while (read_size < image_size) {
+        auto ret = pread(_rec_fd, buff + read_size, image_size - read_size, image_offset + read_size);
+        if (ret <= 0)
+            THROW("MXNetRecordIOReader ERROR:  Unable to read the data from the file ");
+        read_size += ret;
+    }
+}
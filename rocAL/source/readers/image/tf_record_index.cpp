@@ -0,0 +1,245 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "readers/image/tf_record_index.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "readers/image/proto_wire_format.h"
+
+namespace {
+using proto_wire::for_each_field;
+
+const char INDEX_MAGIC[8] = {'R', 'T', 'F', 'R', 'I', 'D', 'X', '\0'};
+
+// Locates the first bytes_list value of every requested feature of a serialized tensorflow::Example
+// Example { Features features = 1; }, Features { map<string, Feature> feature = 1; }, Feature { BytesList bytes_list = 1; }, BytesList { repeated bytes value = 1; }
+bool locate_features(const uint8_t *data, size_t size, const std::vector<std::string> &keys, std::vector<std::pair<const uint8_t *, size_t>> &values) {
+    values.assign(keys.size(), std::make_pair(nullptr, 0));
+    return for_each_field(data, data + size, [&](uint64_t field, const uint8_t *features, const uint8_t *features_end) {
+        if (field != 1) return true;
+        return for_each_field(features, features_end, [&](uint64_t field, const uint8_t *map_entry, const uint8_t *map_entry_end) {
+            if (field != 1) return true;
+            std::string key;
+            const uint8_t *feature = nullptr, *feature_end = nullptr;
+            bool ok = for_each_field(map_entry, map_entry_end, [&](uint64_t field, const uint8_t *begin, const uint8_t *end) {
+                if (field == 1)
+                    key.assign((const char *)begin, end - begin);
+                else if (field == 2) {
+                    feature = begin;
+                    feature_end = end;
+                }
+                return true;
+            });
+            if (!ok) return false;
+            auto key_it = std::find(keys.begin(), keys.end(), key);
+            if (key_it == keys.end() || !feature) return true;
+            auto &value = values[key_it - keys.begin()];
+            return for_each_field(feature, feature_end, [&](uint64_t field, const uint8_t *bytes_list, const uint8_t *bytes_list_end) {
+                if (field != 1) return true;
+                return for_each_field(bytes_list, bytes_list_end, [&](uint64_t field, const uint8_t *begin, const uint8_t *end) {
+                    if (field == 1 && !value.first)
+                        value = std::make_pair(begin, (size_t)(end - begin));
+                    return true;
+                });
+            });
+        });
+    });
+}
+
+uint64_t hash_keys(const std::string &encoded_key, const std::string &filename_key) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    std::string keys = encoded_key + '\0' + filename_key;
+    for (unsigned char c : keys) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+}  // namespace
+
+TFRecordIndex::~TFRecordIndex() {
+    release();
+}
+
+bool TFRecordIndex::is_index_file(const std::string &path) {
+    return path.find(INDEX_SUFFIX) != std::string::npos;
+}
+
+void TFRecordIndex::release() {
+    if (_map)
+        munmap(_map, _map_size);
+    _map = nullptr;
+    _map_size = 0;
+    _owned.clear();
+    _entries = nullptr;
+    _names = nullptr;
+    _entry_count = 0;
+}
+
+void TFRecordIndex::load(const std::string &record_path, const std::string &encoded_key, const std::string &filename_key) {
+    release();
+    struct stat record_stat;
+    if (stat(record_path.c_str(), &record_stat) != 0)
+        THROW("TFRecordIndex: Failed to access " + record_path)
+    Header header = {};
+    memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.version = VERSION;
+    header.record_file_size = record_stat.st_size;
+    header.record_file_mtime = record_stat.st_mtime;
+    header.key_hash = hash_keys(encoded_key, filename_key);
+    std::string index_path = record_path + INDEX_SUFFIX;
+    if (map_index(index_path, header))
+        return;
+    build(record_path, encoded_key, filename_key, header);
+    // Use the sidecar just written so that the index lives in the page cache rather than in the process heap
+    if (!_owned.empty() && map_index(index_path, header))
+        std::vector<char>().swap(_owned);
+}
+
+bool TFRecordIndex::map_index(const std::string &index_path, const Header &expected) {
+    int fd = ::open(index_path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat index_stat;
+    if (fstat(fd, &index_stat) != 0 || (size_t)index_stat.st_size < sizeof(Header)) {
+        ::close(fd);
+        return false;
+    }
+    void *map = mmap(nullptr, index_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+        return false;
+    auto header = static_cast<const Header *>(map);
+    bool valid = memcmp(header->magic, expected.magic, sizeof(header->magic)) == 0 && header->version == expected.version &&
+                 header->record_file_size == expected.record_file_size && header->record_file_mtime == expected.record_file_mtime &&
+                 header->key_hash == expected.key_hash &&
+                 header->entry_count <= (index_stat.st_size - sizeof(Header)) / sizeof(Entry);
+    if (valid) {
+        // A sidecar whose header matches can still be truncated or corrupt, an entry pointing out of the name table or of
+        // the record file would crash the readers later on, it is rebuilt instead
+        auto entries = reinterpret_cast<const Entry *>(static_cast<const char *>(map) + sizeof(Header));
+        uint64_t names_size = index_stat.st_size - sizeof(Header) - header->entry_count * sizeof(Entry);
+        uint64_t record_file_size = header->record_file_size;
+        for (uint64_t idx = 0; idx < header->entry_count && valid; idx++) {
+            const Entry &entry = entries[idx];
+            valid = entry.name_offset <= names_size && entry.name_length <= names_size - entry.name_offset &&
+                    entry.record_offset <= record_file_size && record_file_size - entry.record_offset >= 16 &&
+                    entry.record_length <= record_file_size - entry.record_offset - 16 &&
+                    entry.encoded_offset >= entry.record_offset + 12 && entry.encoded_offset - entry.record_offset - 12 <= entry.record_length &&
+                    entry.encoded_size <= entry.record_length - (entry.encoded_offset - entry.record_offset - 12);
+        }
+        if (!valid)
+            WRN("TFRecordIndex: The index " + index_path + " has entries out of bounds, rebuilding it")
+    }
+    if (!valid) {
+        munmap(map, index_stat.st_size);
+        return false;
+    }
+    _owned.clear();
+    _map = map;
+    _map_size = index_stat.st_size;
+    _entry_count = header->entry_count;
+    _entries = reinterpret_cast<const Entry *>(static_cast<const char *>(map) + sizeof(Header));
+    _names = reinterpret_cast<const char *>(_entries + _entry_count);
+    return true;
+}
+
+void TFRecordIndex::build(const std::string &record_path, const std::string &encoded_key, const std::string &filename_key, const Header &header) {
+    std::ifstream file_contents(record_path.c_str(), std::ios::binary);
+    if (!file_contents)
+        THROW("TFRecordIndex: Failed to open file " + record_path)
+    std::vector<std::string> keys = {encoded_key};
+    if (!filename_key.empty())
+        keys.push_back(filename_key);
+    std::vector<Entry> entries;
+    std::string names;
+    std::vector<uint8_t> data;
+    std::vector<std::pair<const uint8_t *, size_t>> values;
+    uint64_t offset = 0;
+    while (offset + 16 <= header.record_file_size) {
+        // Each record is stored as uint64 length, uint32 masked crc of length, data, uint32 masked crc of data
+        uint64_t data_length;
+        uint32_t crc;
+        file_contents.read((char *)&data_length, sizeof(data_length));
+        file_contents.read((char *)&crc, sizeof(crc));
+        if (!file_contents || offset + data_length + 16 > header.record_file_size)
+            THROW("TFRecordIndex: Error in reading TF records of " + record_path)
+        data.resize(data_length);
+        file_contents.read((char *)data.data(), data_length);
+        file_contents.read((char *)&crc, sizeof(crc));
+        if (!file_contents)
+            THROW("TFRecordIndex: Error in reading TF records of " + record_path)
+        if (!locate_features(data.data(), data.size(), keys, values) || !values[0].first)
+            THROW("TFRecordIndex: Feature " + encoded_key + " not found in record at offset " + std::to_string(offset) + " of " + record_path)
+        Entry entry;
+        entry.record_offset = offset;
+        entry.record_length = data_length;
+        entry.encoded_offset = offset + 12 + (values[0].first - data.data());
+        entry.encoded_size = values[0].second;
+        entry.name_offset = names.size();
+        entry.name_length = 0;
+        if (values.size() > 1) {
+            if (!values[1].first)
+                THROW("TFRecordIndex: Feature " + filename_key + " not found in record at offset " + std::to_string(offset) + " of " + record_path)
+            names.append((const char *)values[1].first, values[1].second);
+            entry.name_length = values[1].second;
+        }
+        entries.push_back(entry);
+        offset += data_length + 16;
+    }
+    Header index_header = header;
+    index_header.entry_count = entries.size();
+    _owned.resize(sizeof(Header) + entries.size() * sizeof(Entry) + names.size());
+    memcpy(_owned.data(), &index_header, sizeof(Header));
+    if (!entries.empty())
+        memcpy(_owned.data() + sizeof(Header), entries.data(), entries.size() * sizeof(Entry));
+    if (!names.empty())
+        memcpy(_owned.data() + sizeof(Header) + entries.size() * sizeof(Entry), names.data(), names.size());
+    _entry_count = entries.size();
+    _entries = reinterpret_cast<const Entry *>(_owned.data() + sizeof(Header));
+    _names = reinterpret_cast<const char *>(_entries + _entry_count);
+
+    // Publish the sidecar atomically, concurrent readers of the same record file may be building it too
+    std::string index_path = record_path + INDEX_SUFFIX;
+    std::string tmp_path = index_path + ".tmp." + TOSTR(getpid());
+    bool written = false;
+    {
+        std::ofstream index_file(tmp_path.c_str(), std::ios::binary | std::ios::trunc);
+        if (index_file)
+            written = static_cast<bool>(index_file.write(_owned.data(), _owned.size()));
+    }
+    if (!written || rename(tmp_path.c_str(), index_path.c_str()) != 0) {
+        unlink(tmp_path.c_str());
+        WRN("TFRecordIndex: Could not write the index " + index_path + ", keeping it in memory")
+    } else {
+        LOG("TFRecordIndex: Indexed " + TOSTR(_entry_count) + " records of " + record_path)
+    }
+}
@@ -21,6 +21,8 @@ THE SOFTWARE.
 */
 
 #include "readers/image/tf_record_reader.h"
+#include <fcntl.h>
+#include <unistd.h>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -106,6 +108,9 @@ int TFRecordReader::close() {
 
 TFRecordReader::~TFRecordReader() {
     release();
+    for (auto fd : _record_fds)
+        ::close(fd);
+    _record_fds.clear();
 }
 
 int TFRecordReader::release() {
@@ -130,6 +135,8 @@ Reader::Status TFRecordReader::folder_reading() {
         std::string entry_name(_entity->d_name);
         if (strcmp(_entity->d_name, ".") == 0 || strcmp(_entity->d_name, "..") == 0)
             continue;
+        if (TFRecordIndex::is_index_file(entry_name))
+            continue;
         entry_name_list.push_back(entry_name);
         // std::cerr<<"\n entry_name::"<<entry_name;
     }
@@ -168,21 +175,18 @@ Reader::Status TFRecordReader::tf_record_reader() {
     std::string fname = _folder_path;
     // if _record_name_prefix is specified, read only the records with prefix
     if (_record_name_prefix.empty() || fname.find(_record_name_prefix) != std::string::npos) {
-        uint file_size;
-        std::ifstream file_contents(fname.c_str(), std::ios::binary);
-        if (!file_contents)
+        int record_fd = ::open(fname.c_str(), O_RDONLY);
+        if (record_fd < 0)
             THROW("TFRecordReader: Failed to open file " + fname);
-        file_contents.seekg(0, std::ifstream::end);
-        file_size = file_contents.tellg();
-        // std::cerr<<"\n length of the file:: "<<length<<std::endl;
-        file_contents.seekg(0, std::ifstream::beg);
-        auto ret = read_image_names(file_contents, file_size);
+        _record_fds.push_back(record_fd);
+        TFRecordIndex index;
+        index.load(fname, _encoded_key, _filename_key);
+        auto ret = read_image_names(index, record_fd);
         if (ret != Reader::Status::OK)
             THROW("TFRecordReader: Error in reading TF records");
         _last_rec = false;
         if (_file_names.size() != _file_size.size())
             std::cerr << "\n Size of vectors are not same";
-        file_contents.close();
     }
     return Reader::Status::OK;
 }
@@ -193,112 +197,52 @@ size_t TFRecordReader::get_file_shard_id() {
     return _file_id % _shard_count;
 }
 
-Reader::Status TFRecordReader::read_image_names(std::ifstream &file_contents, uint file_size) {
+Reader::Status TFRecordReader::read_image_names(const TFRecordIndex &index, int record_fd) {
     auto ret = Reader::Status::OK;
-    while (!_last_rec) {
-        uint length;
-        uint64_t data_length;
-        uint32_t length_crc, data_crc;
-
-        length = file_contents.tellg();
-        file_contents.read((char *)&data_length, sizeof(data_length));
-        if (!file_contents)
-            THROW("TFRecordReader: Error in reading TF records")
-        file_contents.read((char *)&length_crc, sizeof(length_crc));
-        if (!file_contents)
-            THROW("TFRecordReader: Error in reading TF records")
-        if (uint(length + data_length + 16) == file_size) {
-            _last_rec = true;
-        }
-        std::unique_ptr<char[]> data(new char[data_length]);
-        file_contents.read(data.get(), data_length);
-        if (!file_contents)
-            THROW("TFRecordReader: Error in reading TF records")
-        _single_example.ParseFromArray(data.get(), data_length);
-        _features = _single_example.features();
-        auto feature = _features.feature();
+    for (size_t record_idx = 0; record_idx < index.size(); record_idx++) {
+        const auto &entry = index.entry(record_idx);
         std::string file_path = _folder_path;
         std::string fname;
         if (!_filename_key.empty()) {
-            _single_feature = feature.at(_filename_key);
-            fname = _single_feature.bytes_list().value()[0];
-            file_path.append("/");
-            file_path.append(fname);
+            fname = index.name(record_idx);
         } else {
             // generate filename based on file_id
             fname = std::to_string(_file_id);
-            file_path.append("/");
-            file_path.append(fname);
         }
-        _image_record_starting.insert(std::pair<std::string, uint>(fname, length));
+        file_path.append("/");
+        file_path.append(fname);
         _in_batch_read_count++;
         _in_batch_read_count = (_in_batch_read_count % _batch_count == 0) ? 0 : _in_batch_read_count;
         _last_file_name = file_path;
+        _last_file_size = entry.encoded_size;
+        // The last record may be replicated to fill the last batch even if it belongs to another shard
+        _record_locations[file_path] = {record_fd, entry.encoded_offset};
         if (get_file_shard_id() != _shard_id) {
             incremenet_file_id();
             _file_count_all_shards++;
-            file_contents.read((char *)&data_crc, sizeof(data_crc));
-            if (!file_contents)
-                THROW("TFRecordReader: Error in reading TF records")
             continue;
         }
         _file_names.push_back(file_path);
         incremenet_file_id();
         _file_count_all_shards++;
-        _single_feature = feature.at(_encoded_key);
-        _last_file_size = _single_feature.bytes_list().value()[0].size();
         _file_size.insert(std::pair<std::string, unsigned int>(_last_file_name, _last_file_size));
-        file_contents.read((char *)&data_crc, sizeof(data_crc));
-        if (!file_contents)
-            THROW("TFRecordReader: Error in reading TF records")
     }
+    _last_rec = true;
     return ret;
 }
 
-Reader::Status TFRecordReader::read_image(unsigned char *buff, std::string file_name, uint file_size) {
-    auto ret = Reader::Status::OK;
-    std::string temp = file_name.substr(0, file_name.find_last_of("\\/"));
-    const size_t last_slash_idx = file_name.find_last_of("\\/");
-    if (std::string::npos != last_slash_idx) {
-        file_name.erase(0, last_slash_idx + 1);
-    }
-    std::ifstream file_contents(temp.c_str(), std::ios::binary);
-    if (!file_contents)
-        THROW("TFRecordReader: Failed to open file " + file_name);
-    auto it = _image_record_starting.find(file_name);
-    if (_image_record_starting.end() == it) {
+Reader::Status TFRecordReader::read_image(unsigned char *buff, const std::string &file_name, uint file_size) {
+    auto it = _record_locations.find(file_name);
+    if (_record_locations.end() == it) {
         THROW("ERROR: Given name not present in the map" + file_name)
     }
-    // std::cerr<<"\n image present at loc:: "<<it->second;
-    file_contents.seekg(it->second, std::ifstream::beg);
-    uint64_t data_length;
-    uint32_t length_crc, data_crc;
-    file_contents.read((char *)&data_length, sizeof(data_length));
-    if (!file_contents)
-        THROW("TFRecordReader: Error in reading TF records")
-    file_contents.read((char *)&length_crc, sizeof(length_crc));
-    if (!file_contents)
-        THROW("TFRecordReader: Error in reading TF records")
-    std::unique_ptr<char[]> data(new char[data_length]);
-    file_contents.read(data.get(), data_length);
-    if (!file_contents)
-        THROW("TFRecordReader: Error in reading TF records")
-    _single_example.ParseFromArray(data.get(), data_length);
-    _features = _single_example.features();
-    auto feature = _features.feature();
-    std::string fname;
-    if (!_filename_key.empty()) {
-        _single_feature = feature.at(_filename_key);
-        fname = _single_feature.bytes_list().value()[0];
-    }
-    // if _filename key is empty, just read the encoded/raw feature
-    if (_filename_key.empty() || (fname == file_name)) {
-        _single_feature = feature.at(_encoded_key);
-        memcpy(buff, _single_feature.bytes_list().value()[0].c_str(), _single_feature.bytes_list().value()[0].size());
+    // Only the encoded image bytes are read, the index gives their location within the record file
+    size_t read_size = 0;
+    while (read_size < file_size) {
+        ssize_t ret = pread(it->second.fd, buff + read_size, file_size - read_size, it->second.offset + read_size);
+        if (ret <= 0)
+            THROW("TFRecordReader: Error in reading TF records")
+        read_size += ret;
     }
-    file_contents.read((char *)&data_crc, sizeof(data_crc));
-    if (!file_contents)
-        THROW("TFRecordReader: Error in reading TF records")
-    file_contents.close();
-    return ret;
+    return Reader::Status::OK;
 }
@@ -0,0 +1,103 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+#include "pipeline/commons.h"
+#include "readers/size_bucketing_reader.h"
+
+SizeBucketingReader::SizeBucketingReader(std::shared_ptr<Reader> reader, std::shared_ptr<Decoder> header_decoder, size_t batch_size, size_t pool_batch_count, bool shuffle)
+    : _reader(reader), _header_decoder(header_decoder), _batch_size(std::max(batch_size, static_cast<size_t>(1))), _pool_size(_batch_size * std::max(pool_batch_count, static_cast<size_t>(1))), _shuffle(shuffle) {
+    if (!_reader || !_header_decoder)
+        THROW("Size bucketing needs a reader and a decoder")
+    _pool.resize(_pool_size);
+}
+
+void SizeBucketingReader::fill_pool() {
+    size_t count = 0;
+    while (count < _pool_size && _reader->count_items() > 0) {
+        auto &sample = _pool[count];
+        size_t fsize = _reader->open();
+        if (fsize == 0) {
+            WRN("Opened file " + _reader->id() + " of size 0");
+            continue;
+        }
+        if (sample.data.size() < fsize)
+            sample.data.resize(fsize);
+        sample.size = _reader->read_data(sample.data.data(), fsize);
+        sample.id = _reader->id();
+        sample.sample_index = _reader->sample_index();
+        _reader->close();
+        int width = 0, height = 0, jpeg_sub_samp;
+        if (_header_decoder->decode_info(sample.data.data(), sample.size, &width, &height, &jpeg_sub_samp) != Decoder::Status::OK)
+            width = height = 0;
+        sample.width = width;
+        sample.height = height;
+        count++;
+    }
+    // The last batch of the epoch keeps its images in order, the readers pad it at its end
+    size_t sorted_count = count;
+    if (_reader->count_items() == 0 && _reader->last_batch_padded_size() > 0)
+        sorted_count = count - std::min(count, _batch_size);
+    std::vector<size_t> sorted(sorted_count);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::stable_sort(sorted.begin(), sorted.end(), [&](size_t a, size_t b) {
+        return static_cast<uint64_t>(_pool[a].width) * _pool[a].height < static_cast<uint64_t>(_pool[b].width) * _pool[b].height;
+    });
+    std::vector<size_t> buckets((sorted_count + _batch_size - 1) / _batch_size);
+    std::iota(buckets.begin(), buckets.end(), 0);
+    // A partial bucket stays last, so that the following pools still start on a batch boundary
+    if (_shuffle)
+        std::random_shuffle(buckets.begin(), buckets.begin() + sorted_count / _batch_size);
+    _order.clear();
+    for (auto bucket : buckets)
+        _order.insert(_order.end(), sorted.begin() + bucket * _batch_size, sorted.begin() + std::min((bucket + 1) * _batch_size, sorted_count));
+    for (size_t idx = sorted_count; idx < count; idx++)
+        _order.push_back(idx);
+    _next = 0;
+}
+
+size_t SizeBucketingReader::open() {
+    if (_next >= _order.size())
+        fill_pool();
+    if (_next >= _order.size())
+        return 0;
+    _current = _order[_next++];
+    _last_id = _pool[_current].id;
+    _last_sample_index = _pool[_current].sample_index;
+    return _pool[_current].size;
+}
+
+size_t SizeBucketingReader::read_data(unsigned char *buf, size_t read_size) {
+    auto &sample = _pool[_current];
+    size_t size = std::min(read_size, sample.size);
+    memcpy(buf, sample.data.data(), size);
+    return size;
+}
+
+void SizeBucketingReader::reset() {
+    _reader->reset();
+    _order.clear();
+    _next = 0;
+}
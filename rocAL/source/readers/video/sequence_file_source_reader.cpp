@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include "pipeline/commons.h"
 #include "readers/video/sequence_file_source_reader.h"
 #include "pipeline/filesystem.h"
+#include "readers/dataset_manifest.h"
 
 SequenceFileSourceReader::SequenceFileSourceReader() {
     _src_dir = nullptr;
@@ -60,7 +61,8 @@ Reader::Status SequenceFileSourceReader::initialize(ReaderConfig desc) {
     _step = desc.get_frame_step();
     _stride = desc.get_frame_stride();
     _batch_count = _user_batch_count / _sequence_length;
-    ret = subfolder_reading();
+    _manifest_dir = desc.manifest_dir();
+    ret = _manifest_dir.empty() ? subfolder_reading() : manifest_reading();
     if (ret != Reader::Status::OK)
         return ret;
     ret = get_sequences();
@@ -224,6 +226,35 @@ Reader::Status SequenceFileSourceReader::subfolder_reading() {
     return ret;
 }
 
+Reader::Status SequenceFileSourceReader::manifest_reading() {
+    // Same grouping as subfolder_reading(), taken from the dataset manifest
+    auto manifest = DatasetManifest::get(_manifest_dir, _folder_path);
+    for (auto &entry : manifest->root_entries()) {
+        if (!entry.is_directory) {
+            // ignore files with extensions .tar, .zip, .7z, .mp4
+            auto file_extension_idx = entry.name.find_last_of(".");
+            if (file_extension_idx != std::string::npos) {
+                std::string file_extension = entry.name.substr(file_extension_idx + 1);
+                if ((file_extension == "tar") || (file_extension == "zip") || (file_extension == "7z") || (file_extension == "rar") || (file_extension == "mp4"))
+                    continue;
+            }
+            _file_names.push_back(_folder_path + "/" + entry.name);
+        } else {
+            auto &folder = manifest->folder(entry.folder_idx);
+            for (size_t file_idx = 0; file_idx < folder.files.size(); file_idx++)
+                _file_names.push_back(_folder_path + "/" + manifest->relative_path(entry.folder_idx, file_idx));
+            std::sort(_file_names.begin(), _file_names.end());
+            _folder_file_names.push_back(_file_names);
+            _file_names.clear();
+        }
+    }
+    if (!_file_names.empty()) {
+        _folder_file_names.push_back(_file_names);
+        _file_names.clear();
+    }
+    return Reader::Status::OK;
+}
+
 void SequenceFileSourceReader::replicate_last_sequence_to_fill_last_shard() {
     for (size_t i = _in_batch_read_count; i < _batch_count; i++)
         _sequence_frame_names.push_back(_last_sequence);
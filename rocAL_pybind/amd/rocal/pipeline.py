@@ -53,6 +53,8 @@ class Pipeline(object):
     @param std (int, optional, default = 0)                                                               Standard deviation value used for the image normalization
     @param tensor_dtype (int, optional, default = 0)                                                      Tensor datatype used for the pipeline
     @param output_memory_type (int, optional, default = 0)                                                Output memory type used for the output tensors
+    @param numa_policy (int, optional, default = types.NUMA_NONE)                                         NUMA node the loader, decode and graph threads and the host buffers of the pipeline are bound to, local to the GPU with types.NUMA_GPU_LOCAL or numa_node with types.NUMA_NODE
+    @param numa_node (int, optional, default = -1)                                                        NUMA node used with types.NUMA_NODE
     """
     '''.
     Args: batch_size
@@ -66,13 +68,13 @@ class Pipeline(object):
     def __init__(self, batch_size=-1, num_threads=0, device_id=0, seed=1,
                  exec_pipelined=True, prefetch_queue_depth=2,
                  exec_async=True, bytes_per_sample=0,
-                 rocal_cpu=False, max_streams=-1, default_cuda_stream_priority=0, tensor_layout=types.NCHW, reverse_channels=False, mean=None, std=None, tensor_dtype=types.FLOAT, output_memory_type=None): 
+                 rocal_cpu=False, max_streams=-1, default_cuda_stream_priority=0, tensor_layout=types.NCHW, reverse_channels=False, mean=None, std=None, tensor_dtype=types.FLOAT, output_memory_type=None, numa_policy=types.NUMA_NONE, numa_node=-1): 
         if (rocal_cpu):
             self._handle = b.rocalCreate(
-                batch_size, types.CPU, device_id, num_threads, prefetch_queue_depth, tensor_dtype)
+                batch_size, types.CPU, device_id, num_threads, prefetch_queue_depth, tensor_dtype, numa_policy, numa_node)
         else:
             self._handle = b.rocalCreate(
-                batch_size, types.GPU, device_id, num_threads, prefetch_queue_depth, tensor_dtype)
+                batch_size, types.GPU, device_id, num_threads, prefetch_queue_depth, tensor_dtype, numa_policy, numa_node)
 
         if (b.getStatus(self._handle) == types.OK):
             print("Pipeline has been created succesfully")
@@ -139,6 +141,12 @@ class Pipeline(object):
         status = b.rocalRun(self._handle)
         return status
 
+    def rocal_run_async(self):
+        """! Starts rocalRun on a thread of its own and returns a future whose wait() gives its status.
+            The outputs of the current batch must have been borrowed or copied before, and the pipeline must not be used until wait() returns.
+        """
+        return b.rocalRunAsync(self._handle)
+
     def define_graph(self):
         """!This function is defined by the user to construct the
         graph of operations for their pipeline.
@@ -252,6 +260,10 @@ class Pipeline(object):
 
     def get_output_tensors(self):
         return b.getOutputTensors(self._handle)
+
+    def borrow_output_tensors(self):
+        """!Lends the outputs of the last batch without copying them, see rocalBorrowedOutputs.to_dlpack()"""
+        return b.borrowOutputTensors(self._handle)
     
     def get_last_batch_padded_size(self):
         return b.getLastBatchPaddedSize(self._handle)
@@ -23,6 +23,7 @@
 # @brief File containing iterators to be used with pytorch trainings
 
 import torch
+import torch.utils.dlpack
 import numpy as np
 import rocal_pybind as b
 import amd.rocal.types as types
@@ -41,9 +42,12 @@ class ROCALGenericIterator(object):
         @param display             Whether to display images during processing
         @param device              The device to use for processing
         @param device_id           The ID of the device to use
+        @param zero_copy           Whether the output tensors view the rocAL output buffers in place instead of a copy of them.
+                                   A batch is not overwritten as long as its tensors are alive, so they must not all be kept around.
+                                   The next batch is then requested before the current one is returned, except with an external source
     """
 
-    def __init__(self, pipeline, tensor_layout=types.NCHW, reverse_channels=False, multiplier=[1.0, 1.0, 1.0], offset=[0.0, 0.0, 0.0], tensor_dtype=types.FLOAT, device="cpu", device_id=0, display=False):
+    def __init__(self, pipeline, tensor_layout=types.NCHW, reverse_channels=False, multiplier=[1.0, 1.0, 1.0], offset=[0.0, 0.0, 0.0], tensor_dtype=types.FLOAT, device="cpu", device_id=0, display=False, zero_copy=False):
         self.loader = pipeline
         self.tensor_format = tensor_layout
         self.multiplier = multiplier
@@ -56,6 +60,11 @@ class ROCALGenericIterator(object):
         self.labels_size = ((self.batch_size * self.loader._num_classes)
                             if self.loader._one_hot_encoding else self.batch_size)
         self.output_list = None
+        self.labels_tensor = None
+        self.zero_copy = zero_copy
+        # The outputs are borrowed, so the next run can pop the batch while the model consumes it
+        self.prefetch = zero_copy and not self.loader._is_external_source_operator
+        self.next_run = None
         self.output_memory_type = self.loader._output_memory_type
         self.iterator_length = b.getRemainingImages(self.loader._handle)
         self.display = display
@@ -76,6 +85,17 @@ class ROCALGenericIterator(object):
         return self.__next__()
 
     def __next__(self):
+        outputs = self._next_batch()
+        if self.prefetch:
+            self.next_run = self.loader.rocal_run_async()
+        return outputs
+
+    def _wait_next_run(self):
+        status = self.next_run.wait()
+        self.next_run = None
+        return status
+
+    def _next_batch(self):
         if (self.loader._is_external_source_operator):
             if (self.index + 1) == self.num_batches:
                 self.eos = True
@@ -109,12 +129,21 @@ class ROCALGenericIterator(object):
                     "eos": self.eos}
                 b.externalSourceFeedInput(*(kwargs_pybind.values()))
             self.index = self.index + 1
-        if self.loader.rocal_run() != 0:
+        status = self._wait_next_run() if self.next_run is not None else self.loader.rocal_run()
+        if status != 0:
             raise StopIteration
-        else:
+        elif not self.zero_copy:
             self.output_tensor_list = self.loader.get_output_tensors()
 
-        if self.output_list is None:
+        if self.zero_copy:
+            # The torch tensors own the batch, it goes back to rocAL once all of them are freed
+            borrowed = self.loader.borrow_output_tensors()
+            self.output_list = [torch.utils.dlpack.from_dlpack(borrowed.to_dlpack(i)) for i in range(len(borrowed))]
+            borrowed.release()
+            if self.labels_tensor is None:
+                labels_device = torch.device('cuda', self.device_id) if self.device != "cpu" else None
+                self.labels_tensor = torch.empty(self.labels_size, dtype=getattr(torch, "int32"), device=labels_device)
+        elif self.output_list is None:
             # Output list used to store pipeline outputs - can support multiple augmentation outputs
             self.output_list = []
             for i in range(len(self.output_tensor_list)):
@@ -223,6 +252,8 @@ class ROCALGenericIterator(object):
                 return self.output_list, self.labels_tensor
 
     def reset(self):
+        if self.next_run is not None:
+            self._wait_next_run()
         b.rocalResetLoaders(self.loader._handle)
 
     def __iter__(self):
@@ -232,6 +263,8 @@ class ROCALGenericIterator(object):
         return self.iterator_length
 
     def __del__(self):
+        if self.next_run is not None:
+            self._wait_next_run()
         b.rocalRelease(self.loader._handle)
 
 
@@ -280,10 +313,11 @@ class ROCALClassificationIterator(ROCALGenericIterator):
                  last_batch_padded=False,
                  display=False,
                  device="cpu",
-                 device_id=0):
+                 device_id=0,
+                 zero_copy=False):
         pipe = pipelines
         super(ROCALClassificationIterator, self).__init__(pipe, tensor_layout=pipe._tensor_layout, tensor_dtype=pipe._tensor_dtype,
-                                                          multiplier=pipe._multiplier, offset=pipe._offset, display=display, device=device, device_id=device_id)
+                                                          multiplier=pipe._multiplier, offset=pipe._offset, display=display, device=device, device_id=device_id, zero_copy=zero_copy)
 
 
 class ROCALAudioIterator(object):
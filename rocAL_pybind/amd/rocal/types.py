@@ -37,6 +37,7 @@ from rocal_pybind.types import CPU
 from rocal_pybind.types import UINT8
 from rocal_pybind.types import FLOAT
 from rocal_pybind.types import FLOAT16
+from rocal_pybind.types import BFLOAT16
 from rocal_pybind.types import UINT8
 
 #  RocalOutputMemType
@@ -117,6 +118,11 @@ from rocal_pybind.types import LAST_BATCH_FILL
 from rocal_pybind.types import LAST_BATCH_DROP
 from rocal_pybind.types import LAST_BATCH_PARTIAL
 
+#     RocalNumaPolicy
+from rocal_pybind.types import NUMA_NONE
+from rocal_pybind.types import NUMA_GPU_LOCAL
+from rocal_pybind.types import NUMA_NODE
+
 _known_types = {
 
     OK: ("OK", OK),
@@ -130,6 +136,7 @@ _known_types = {
     UINT8: ("UINT8", UINT8),
     FLOAT: ("FLOAT", FLOAT),
     FLOAT16: ("FLOAT16", FLOAT16),
+    BFLOAT16: ("BFLOAT16", BFLOAT16),
     UINT8: ("UINT8", UINT8),
     HOST_MEMORY: ("HOST_MEMORY", HOST_MEMORY),
     DEVICE_MEMORY: ("DEVICE_MEMORY", DEVICE_MEMORY),
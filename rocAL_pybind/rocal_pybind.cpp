@@ -23,6 +23,8 @@ THE SOFTWARE.
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
+#include <chrono>
+#include <future>
 #include <iostream>
 #include <pybind11/embed.h>
 #include <pybind11/eval.h>
@@ -89,10 +91,13 @@ py::object wrapper_copy_to_tensor(RocalContext context, py::object p,
                                   float multiplier1, float multiplier2, float offset0, float offset1, float offset2,
                                   bool reverse_channels, RocalOutputMemType output_mem_type, uint max_roi_height, uint max_roi_width) {
     auto ptr = ctypes_void_ptr(p);
-    // call pure C++ function
-    int status = rocalToTensor(context, ptr, tensor_format, tensor_output_type, multiplier0,
-                               multiplier1, multiplier2, offset0, offset1, offset2,
-                               reverse_channels, output_mem_type, max_roi_height, max_roi_width);
+    {
+        py::gil_scoped_release release;
+        // call pure C++ function
+        rocalToTensor(context, ptr, tensor_format, tensor_output_type, multiplier0,
+                      multiplier1, multiplier2, offset0, offset1, offset2,
+                      reverse_channels, output_mem_type, max_roi_height, max_roi_width);
+    }
     return py::cast<py::none>(Py_None);
 }
 
@@ -115,7 +120,11 @@ py::object wrapperRocalExternalSourceFeedInput(
     if (labels.is_none()) {
         enable_labels = false;
     }
-    int status = rocalExternalSourceFeedInput(context, input_images_names, enable_labels, uchar_arrays, roi_xywh, max_width, max_height, channels, mode, layout, eos);
+    {
+        // The numpy buffers are kept alive by the caller's arguments
+        py::gil_scoped_release release;
+        rocalExternalSourceFeedInput(context, input_images_names, enable_labels, uchar_arrays, roi_xywh, max_width, max_height, channels, mode, layout, eos);
+    }
 
     // Update labels in the tensorList
     if (enable_labels) {
@@ -131,8 +140,11 @@ py::object wrapperRocalExternalSourceFeedInput(
 
     py::object wrapper_one_hot_label_copy(RocalContext context, size_t array_ptr, unsigned num_of_classes, RocalOutputMemType dest_mem_type) {
         void* ptr = reinterpret_cast<void*>(array_ptr);
-        // call pure C++ function
-        rocalGetOneHotImageLabels(context, ptr, num_of_classes, dest_mem_type);
+        {
+            py::gil_scoped_release release;
+            // call pure C++ function
+            rocalGetOneHotImageLabels(context, ptr, num_of_classes, dest_mem_type);
+        }
         return py::cast<py::none>(Py_None);
     }
 
@@ -155,20 +167,189 @@ std::unordered_map<int, std::string> rocalToPybindOutputDtype = {
     {5, "int32"},
 };
 
+// The DLPack ABI (https://github.com/dmlc/dlpack), the bindings only produce the capsules so the few types they use are declared here
+namespace dlpack {
+enum DLDeviceType : int32_t { kDLCPU = 1,
+                              kDLROCM = 10 };
+enum DLDataTypeCode : uint8_t { kDLInt = 0,
+                                kDLUInt = 1,
+                                kDLFloat = 2,
+                                kDLBfloat = 4 };
+struct DLDevice {
+    int32_t device_type;
+    int32_t device_id;
+};
+struct DLDataType {
+    uint8_t code;
+    uint8_t bits;
+    uint16_t lanes;
+};
+struct DLTensor {
+    void *data;
+    DLDevice device;
+    int32_t ndim;
+    DLDataType dtype;
+    int64_t *shape;
+    int64_t *strides;  //!< In elements
+    uint64_t byte_offset;
+};
+struct DLManagedTensor {
+    DLTensor dl_tensor;
+    void *manager_ctx;
+    void (*deleter)(DLManagedTensor *self);
+};
+}  // namespace dlpack
+
+//! Output tensors borrowed from the ring buffer, returned to it when the last reference goes away
+struct BorrowedSlot {
+    explicit BorrowedSlot(RocalBorrowedOutput borrowed_output) : handle(borrowed_output) {}
+    ~BorrowedSlot() { rocalReleaseOutputTensors(handle); }
+    RocalBorrowedOutput handle;
+};
+
+//! The Python side of a borrow, release() drops its reference while the DLPack capsules and the framework tensors made from them keep theirs
+struct BorrowedOutputs {
+    std::shared_ptr<BorrowedSlot> slot;
+    std::shared_ptr<BorrowedSlot> &get() {
+        if (!slot)
+            throw py::value_error("The borrowed outputs have been released");
+        return slot;
+    }
+};
+
+struct DLPackTensor {
+    dlpack::DLManagedTensor managed;
+    std::shared_ptr<BorrowedSlot> slot;
+    std::vector<int64_t> shape, strides;
+};
+
+static dlpack::DLDataType dlpack_data_type(RocalTensorOutputType data_type) {
+    switch (data_type) {
+        case RocalTensorOutputType::ROCAL_FP32:
+            return {dlpack::kDLFloat, 32, 1};
+        case RocalTensorOutputType::ROCAL_FP16:
+            return {dlpack::kDLFloat, 16, 1};
+        case RocalTensorOutputType::ROCAL_BF16:
+            return {dlpack::kDLBfloat, 16, 1};
+        case RocalTensorOutputType::ROCAL_UINT8:
+            return {dlpack::kDLUInt, 8, 1};
+        case RocalTensorOutputType::ROCAL_INT8:
+            return {dlpack::kDLInt, 8, 1};
+        case RocalTensorOutputType::ROCAL_UINT32:
+            return {dlpack::kDLUInt, 32, 1};
+        case RocalTensorOutputType::ROCAL_INT32:
+            return {dlpack::kDLInt, 32, 1};
+        default:
+            throw py::type_error("Unknown rocAL data type");
+    }
+}
+
+//! Wraps a borrowed output tensor in a "dltensor" capsule viewing the ring buffer memory, the borrow is held until the consumer calls the deleter
+static py::capsule to_dlpack(const std::shared_ptr<BorrowedSlot> &slot, uint idx) {
+    auto output_tensor_list = rocalGetBorrowedTensors(slot->handle);
+    if (idx >= output_tensor_list->size())
+        throw py::index_error("Output tensor index out of range");
+    auto output_tensor = output_tensor_list->at(idx);
+    auto dims = output_tensor->dims();
+    auto strides = output_tensor->strides();  // In bytes, the innermost one being the size of an element
+    auto dl_tensor = std::make_unique<DLPackTensor>();
+    dl_tensor->slot = slot;
+    for (size_t i = 0; i < dims.size(); i++) {
+        dl_tensor->shape.push_back(static_cast<int64_t>(dims[i]));
+        dl_tensor->strides.push_back(static_cast<int64_t>(strides[i] / strides.back()));
+    }
+    auto &tensor = dl_tensor->managed.dl_tensor;
+    tensor.data = output_tensor->buffer();
+    if (output_tensor->backend() == RocalTensorBackend::ROCAL_GPU)
+        tensor.device = {dlpack::kDLROCM, rocalGetBorrowedDeviceId(slot->handle)};
+    else
+        tensor.device = {dlpack::kDLCPU, 0};
+    tensor.ndim = static_cast<int32_t>(dims.size());
+    tensor.dtype = dlpack_data_type(output_tensor->data_type());
+    tensor.shape = dl_tensor->shape.data();
+    tensor.strides = dl_tensor->strides.data();
+    tensor.byte_offset = 0;
+    dl_tensor->managed.manager_ctx = dl_tensor.get();
+    dl_tensor->managed.deleter = [](dlpack::DLManagedTensor *self) {
+        delete static_cast<DLPackTensor *>(self->manager_ctx);
+    };
+    // A consumer renames the capsule to "used_dltensor" and calls the deleter itself once its tensor is freed
+    auto capsule = PyCapsule_New(&dl_tensor->managed, "dltensor", [](PyObject *capsule) {
+        if (PyCapsule_IsValid(capsule, "dltensor")) {
+            auto managed = static_cast<dlpack::DLManagedTensor *>(PyCapsule_GetPointer(capsule, "dltensor"));
+            managed->deleter(managed);
+        }
+    });
+    if (!capsule)
+        throw py::error_already_set();
+    dl_tensor.release();
+    return py::reinterpret_steal<py::capsule>(capsule);
+}
+
+//! A rocalRun() in flight on a thread of its own, so that Python can ask for the next batch while it consumes the current one
+class RunFuture {
+   public:
+    explicit RunFuture(RocalContext context) : _result(std::async(std::launch::async, [context]() { return rocalRun(context); })) {}
+    ~RunFuture() {
+        if (_result.valid()) {
+            py::gil_scoped_release release;
+            _result.wait();
+        }
+    }
+    bool done() {
+        return !_result.valid() || _result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+    RocalStatus wait() {
+        if (_result.valid()) {
+            py::gil_scoped_release release;
+            _status = _result.get();
+        }
+        return _status;
+    }
+
+   private:
+    std::future<RocalStatus> _result;
+    RocalStatus _status = ROCAL_OK;
+};
+
 PYBIND11_MODULE(rocal_pybind, m) {
     m.doc() = "Python bindings for the C++ portions of ROCAL";
     // Bind the C++ structure
     // rocal_api.h
     m.def("rocalCreate", &rocalCreate, "Creates context with the arguments sent and returns it", py::return_value_policy::reference);
-    m.def("rocalVerify", &rocalVerify);
-    m.def("rocalRun", &rocalRun, py::return_value_policy::reference);
-    m.def("rocalRelease", &rocalRelease, py::return_value_policy::reference);
+    m.def("rocalVerify", &rocalVerify, py::call_guard<py::gil_scoped_release>());
+    m.def("rocalSetPipelinedExecution", &rocalSetPipelinedExecution);
+    m.def("rocalSetGraphReplicaCount", &rocalSetGraphReplicaCount);
+    m.def("rocalSetGraphFusion", &rocalSetGraphFusion);
+    m.def("rocalSetContinuousEpochs", &rocalSetContinuousEpochs);
+    m.def("rocalSetTaskPriority", &rocalSetTaskPriority);
+    m.def("rocalSetPrefetchAutotune", &rocalSetPrefetchAutotune);
+    m.def("rocalRun", &rocalRun, py::return_value_policy::reference, py::call_guard<py::gil_scoped_release>());
+    py::class_<RunFuture>(m, "rocalRunFuture")
+        .def("done", &RunFuture::done,
+             R"code(
+                Returns True once the run has finished, without waiting for it.
+                )code")
+        .def("wait", &RunFuture::wait,
+             R"code(
+                Waits for the run to finish and returns its status, the outputs of the batch can be read after it.
+                )code");
+    m.def(
+        "rocalRunAsync", [](RocalContext context) {
+            return std::make_unique<RunFuture>(context);
+        },
+        R"code(
+            Starts rocalRun() on a thread of its own and returns a rocalRunFuture, so that the next batch is waited for while the current one is consumed.
+            The outputs of the current batch must have been borrowed or copied, and the context must not be used until wait() returns.
+            )code");
+    m.def("rocalRelease", &rocalRelease, py::return_value_policy::reference, py::call_guard<py::gil_scoped_release>());
     // rocal_api_types.h
     py::class_<TimingInfo>(m, "TimingInfo")
         .def_readwrite("load_time", &TimingInfo::load_time)
         .def_readwrite("decode_time", &TimingInfo::decode_time)
         .def_readwrite("process_time", &TimingInfo::process_time)
-        .def_readwrite("transfer_time", &TimingInfo::transfer_time);
+        .def_readwrite("transfer_time", &TimingInfo::transfer_time)
+        .def_readwrite("decode_tail_time", &TimingInfo::decode_tail_time);
     py::class_<rocalTensor>(m, "rocalTensor")
         .def(
             "__add__",
@@ -248,6 +429,7 @@ PYBIND11_MODULE(rocal_pybind, m) {
         .def(
             "copy_data", [](rocalTensor &output_tensor, py::object p, RocalOutputMemType external_mem_type) {
                 auto ptr = ctypes_void_ptr(p);
+                py::gil_scoped_release release;
                 output_tensor.copy_data(static_cast<void *>(ptr), external_mem_type);
             },
             R"code(
@@ -256,6 +438,7 @@ PYBIND11_MODULE(rocal_pybind, m) {
         .def(
             "copy_data", [](rocalTensor &output_tensor, py::array array) {
                 auto buf = array.request();
+                py::gil_scoped_release release;
                 output_tensor.copy_data(static_cast<void *>(buf.ptr), RocalOutputMemType::ROCAL_MEMCPY_HOST);
             },
             py::return_value_policy::reference,
@@ -266,18 +449,60 @@ PYBIND11_MODULE(rocal_pybind, m) {
             "copy_data", [](rocalTensor &output_tensor, long array) {
                 output_tensor.copy_data((void *)array, RocalOutputMemType::ROCAL_MEMCPY_GPU);
             },
-            py::return_value_policy::reference,
+            py::return_value_policy::reference, py::call_guard<py::gil_scoped_release>(),
             R"code(
                 Copies the ring buffer data to cupy arrays.
                 )code")
         .def(
             "copy_data", [](rocalTensor &output_tensor, py::object p, uint x_offset, uint y_offset, uint roi_width, uint roi_height) {
                 auto ptr = ctypes_void_ptr(p);
+                py::gil_scoped_release release;
                 output_tensor.copy_data(static_cast<void *>(ptr), x_offset, y_offset, roi_width, roi_height);
             },
             R"code(
                 Copies the ring buffer data to python buffer pointers given a ROI with dimensions in x and y direction.
                 )code")
+        .def(
+            "max_roi_dims", [](rocalTensor &output_tensor) {
+                return std::make_pair(rocalGetROIMaxWidth(&output_tensor), rocalGetROIMaxHeight(&output_tensor));
+            },
+            R"code(
+                Returns the largest ROI width and height of the samples of the batch, e.g. the bounds of a size bucket.
+                )code")
+        .def(
+            "ragged_data_size", [](rocalTensor &output_tensor) {
+                return output_tensor.ragged_data_size();
+            },
+            R"code(
+                Returns the bytes the samples take when each keeps only its ROI.
+                )code")
+        .def(
+            "copy_data_ragged", [](rocalTensor &output_tensor, py::array array) {
+                auto buf = array.request();
+                if (static_cast<size_t>(buf.size * buf.itemsize) < output_tensor.ragged_data_size())
+                    throw py::value_error("The array is smaller than ragged_data_size()");
+                std::vector<size_t> sample_offsets(output_tensor.ragged_sample_count());
+                {
+                    py::gil_scoped_release release;
+                    output_tensor.copy_data_ragged(static_cast<void *>(buf.ptr), sample_offsets.data(), RocalOutputMemType::ROCAL_MEMCPY_HOST);
+                }
+                return sample_offsets;
+            },
+            R"code(
+                Copies the ROI of each sample packed one after the other to a numpy array, without the padding up to the max shape. Returns the byte offset of each sample, of each frame for sequences.
+                )code")
+        .def(
+            "copy_data_ragged", [](rocalTensor &output_tensor, long array) {
+                std::vector<size_t> sample_offsets(output_tensor.ragged_sample_count());
+                {
+                    py::gil_scoped_release release;
+                    output_tensor.copy_data_ragged((void *)array, sample_offsets.data(), RocalOutputMemType::ROCAL_MEMCPY_GPU);
+                }
+                return sample_offsets;
+            },
+            R"code(
+                Copies the ROI of each sample packed one after the other to a cupy array, without the padding up to the max shape. Returns the byte offset of each sample, of each frame for sequences.
+                )code")
         .def(
             "at", [](rocalTensor &output_tensor, uint idx) {
                 std::vector<size_t> stride_per_sample(output_tensor.strides());
@@ -375,6 +600,7 @@ PYBIND11_MODULE(rocal_pybind, m) {
     py::enum_<RocalTensorOutputType>(types_m, "RocalTensorOutputType", "Tensor types")
         .value("FLOAT", ROCAL_FP32)
         .value("FLOAT16", ROCAL_FP16)
+        .value("BFLOAT16", ROCAL_BF16)
         .value("UINT8", ROCAL_UINT8)
         .export_values();
     py::enum_<RocalOutputMemType>(types_m, "RocalOutputMemType", "Output memory types")
@@ -454,6 +680,21 @@ PYBIND11_MODULE(rocal_pybind, m) {
         .value("LAST_BATCH_DROP", ROCAL_LAST_BATCH_DROP)
         .value("LAST_BATCH_PARTIAL", ROCAL_LAST_BATCH_PARTIAL)
         .export_values();
+    py::enum_<RocalFileReadMode>(types_m, "RocalFileReadMode", "Rocal File Read Mode")
+        .value("FILE_READ_COPY", ROCAL_FILE_READ_COPY)
+        .value("FILE_READ_MMAP", ROCAL_FILE_READ_MMAP)
+        .value("FILE_READ_MMAP_POPULATE", ROCAL_FILE_READ_MMAP_POPULATE)
+        .export_values();
+    py::enum_<RocalTaskPriority>(types_m, "RocalTaskPriority", "Rocal Task Priority")
+        .value("TASK_PRIORITY_HIGH", ROCAL_TASK_PRIORITY_HIGH)
+        .value("TASK_PRIORITY_NORMAL", ROCAL_TASK_PRIORITY_NORMAL)
+        .value("TASK_PRIORITY_LOW", ROCAL_TASK_PRIORITY_LOW)
+        .export_values();
+    py::enum_<RocalNumaPolicy>(types_m, "RocalNumaPolicy", "Rocal NUMA Policy")
+        .value("NUMA_NONE", ROCAL_NUMA_NONE)
+        .value("NUMA_GPU_LOCAL", ROCAL_NUMA_GPU_LOCAL)
+        .value("NUMA_NODE", ROCAL_NUMA_NODE)
+        .export_values();
     py::class_<ROIxywh>(m, "ROIxywh")
         .def(py::init<>())
         .def_readwrite("x", &ROIxywh::x)
@@ -527,13 +768,56 @@ PYBIND11_MODULE(rocal_pybind, m) {
     // rocal_api_data_transfer.h
     m.def("rocalToTensor", &wrapper_copy_to_tensor);
     m.def("getOutputTensors", [](RocalContext context) {
-        rocalTensorList *output_tensor_list = rocalGetOutputTensors(context);
+        rocalTensorList *output_tensor_list;
+        {
+            // Waits for the batch if the pipeline is behind
+            py::gil_scoped_release release;
+            output_tensor_list = rocalGetOutputTensors(context);
+        }
         py::list list;
         unsigned int size_of_tensor_list = output_tensor_list->size();
         for (uint i = 0; i < size_of_tensor_list; i++)
             list.append(output_tensor_list->at(i));
         return list;
     });
+    py::class_<BorrowedOutputs>(m, "rocalBorrowedOutputs")
+        .def(
+            "__len__",
+            [](BorrowedOutputs &borrowed) {
+                return rocalGetBorrowedTensors(borrowed.get()->handle)->size();
+            })
+        .def(
+            "to_dlpack",
+            [](BorrowedOutputs &borrowed, uint idx) {
+                return to_dlpack(borrowed.get(), idx);
+            },
+            "idx"_a,
+            R"code(
+                Returns a DLPack capsule viewing the output tensor at given position in place.
+                The batch stays out of the ring buffer until the outputs are released and every tensor made from the capsules is freed.
+                )code")
+        .def(
+            "release",
+            [](BorrowedOutputs &borrowed) {
+                borrowed.slot.reset();
+            },
+            R"code(
+                Drops the reference of this object to the borrowed batch, the tensors made from its capsules keep theirs.
+                )code");
+    m.def(
+        "borrowOutputTensors", [](RocalContext context) {
+            RocalBorrowedOutput borrowed_output;
+            {
+                py::gil_scoped_release release;
+                borrowed_output = rocalBorrowOutputTensors(context);
+            }
+            if (!borrowed_output)
+                throw std::runtime_error(rocalGetErrorMessage(context));
+            return BorrowedOutputs{std::make_shared<BorrowedSlot>(borrowed_output)};
+        },
+        R"code(
+            Lends the outputs of the last processed batch without copying them out of the ring buffer.
+            )code");
     m.def("getBoundingBoxCount", &rocalGetBoundingBoxCount);
     m.def("getImageLabels", [](RocalContext context) {
         rocalTensorList *labels = rocalGetImageLabels(context);
@@ -700,7 +984,11 @@ PYBIND11_MODULE(rocal_pybind, m) {
             py::return_value_policy::reference);
     m.def("audioDecoder", &rocalAudioFileSource, "Reads file from the source given and decodes it",
             py::return_value_policy::reference);
-    m.def("rocalResetLoaders", &rocalResetLoaders);
+    m.def("rocalResetLoaders", &rocalResetLoaders, py::call_guard<py::gil_scoped_release>());
+    m.def("rocalSetFileReadMode", &rocalSetFileReadMode);
+    m.def("rocalSetDatasetManifestDir", &rocalSetDatasetManifestDir);
+    m.def("rocalSetImageSizeEvaluationSampling", &rocalSetImageSizeEvaluationSampling);
+    m.def("rocalSetSizeBucketing", &rocalSetSizeBucketing);
     m.def("videoMetaDataReader", &rocalCreateVideoLabelReader, py::return_value_policy::reference);
     // rocal_api_augmentation.h
     m.def("ssdRandomCrop", &rocalSSDRandomCrop,
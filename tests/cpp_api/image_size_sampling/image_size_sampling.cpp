@@ -0,0 +1,165 @@
+/*
+MIT License
+
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "opencv2/opencv.hpp"
+#include "rocal_api.h"
+
+// Writes a TFRecord file of JPEG images growing in size, then finds the decode size of the TFRecord loader from a sample
+// of them. The readers of record files move to the next item in read_data() instead of open(), the size evaluation must
+// still move past the images left out of the sample.
+
+namespace {
+void append_varint(std::string &out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+// Appends a length delimited protobuf field
+void append_field(std::string &out, unsigned field, const std::string &value) {
+    append_varint(out, (field << 3) | 2);
+    append_varint(out, value.size());
+    out.append(value);
+}
+
+// Feature { BytesList bytes_list = 1; }, BytesList { repeated bytes value = 1; }
+std::string bytes_feature(const std::string &key, const std::string &value) {
+    std::string bytes_list, feature, entry;
+    append_field(bytes_list, 1, value);
+    append_field(feature, 1, bytes_list);
+    append_field(entry, 1, key);
+    append_field(entry, 2, feature);
+    return entry;
+}
+
+// Example { Features features = 1; }, Features { map<string, Feature> feature = 1; }
+std::string example(const std::string &file_name, const std::vector<uchar> &jpeg) {
+    std::string features, serialized;
+    append_field(features, 1, bytes_feature("image/encoded", std::string(jpeg.begin(), jpeg.end())));
+    append_field(features, 1, bytes_feature("image/filename", file_name));
+    append_field(serialized, 1, features);
+    return serialized;
+}
+
+// uint64 length, uint32 crc of the length, data, uint32 crc of the data, the crcs are not checked by rocAL
+void write_record(std::ofstream &file, const std::string &data) {
+    uint64_t length = data.size();
+    uint32_t crc = 0;
+    file.write(reinterpret_cast<const char *>(&length), sizeof(length));
+    file.write(reinterpret_cast<const char *>(&crc), sizeof(crc));
+    file.write(data.data(), data.size());
+    file.write(reinterpret_cast<const char *>(&crc), sizeof(crc));
+}
+}  // namespace
+
+int main(int argc, const char **argv) {
+    int argIdx = 0;
+    int image_count = 16;
+    int batch_size = 4;
+    float sample_fraction = 0.5;
+    if (argc > ++argIdx)
+        image_count = atoi(argv[argIdx]);
+    if (argc > ++argIdx)
+        batch_size = atoi(argv[argIdx]);
+    if (argc > ++argIdx)
+        sample_fraction = atof(argv[argIdx]);
+    if (image_count < 1 || batch_size < 1 || sample_fraction <= 0 || sample_fraction > 1) {
+        printf("Usage: image_size_sampling <image count> <batch size> <sample fraction in (0, 1]>\n");
+        return -1;
+    }
+
+    char folder_template[] = "/tmp/rocal_image_size_sampling_XXXXXX";
+    if (!mkdtemp(folder_template)) {
+        std::cerr << "Could not create a temporary folder" << std::endl;
+        return -1;
+    }
+    std::string folder(folder_template);
+    std::string record_path = folder + "/images.tfrecord";
+    int max_width = 0, max_height = 0;
+    {
+        std::ofstream record(record_path, std::ios::binary);
+        for (int i = 0; i < image_count; i++) {
+            int width = 64 + 16 * i, height = 48 + 8 * i;
+            cv::Mat image(height, width, CV_8UC3, cv::Scalar(i * 16 % 256, 128, 255 - i * 16 % 256));
+            std::vector<uchar> jpeg;
+            cv::imencode(".jpg", image, jpeg);
+            write_record(record, example("image_" + std::to_string(i) + ".jpg", jpeg));
+            max_width = std::max(max_width, width);
+            max_height = std::max(max_height, height);
+        }
+    }
+
+    int status = 0;
+    auto handle = rocalCreate(batch_size, RocalProcessMode::ROCAL_PROCESS_CPU, 0, 1);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cerr << "Could not create the Rocal context" << std::endl;
+        status = -1;
+    } else {
+        // The last image, the largest one, is part of the sample
+        rocalSetImageSizeEvaluationSampling(handle, sample_fraction, 0.1);
+        rocalJpegTFRecordSource(handle, folder.c_str(), RocalImageColor::ROCAL_COLOR_RGB24, 1, true, "image/encoded", "image/filename", false, false, ROCAL_USE_MAX_SIZE);
+        if (rocalGetStatus(handle) != ROCAL_OK || rocalVerify(handle) != ROCAL_OK) {
+            std::cerr << "Could not build the pipeline: " << rocalGetErrorMessage(handle) << std::endl;
+            status = -1;
+        } else {
+            int width = rocalGetOutputWidth(handle);
+            int height = rocalGetOutputHeight(handle);
+            std::cout << "Decode size " << width << "x" << height << " found from " << sample_fraction * 100 << "% of " << image_count << " images of up to " << max_width << "x" << max_height << std::endl;
+            if (width < max_width || height < max_height) {
+                std::cerr << "The decode size is smaller than the largest image" << std::endl;
+                status = -1;
+            }
+            int processed = 0;
+            while (!rocalIsEmpty(handle) && rocalRun(handle) == ROCAL_OK)
+                processed += batch_size;
+            if (processed < image_count) {
+                std::cerr << "Only " << processed << " of the " << image_count << " images were loaded" << std::endl;
+                status = -1;
+            }
+        }
+        rocalRelease(handle);
+    }
+
+    // Removes the record file, the index rocAL writes next to it and the folder
+    unlink((record_path + ".rocal.idx").c_str());
+    unlink(record_path.c_str());
+    if (rmdir(folder.c_str()) != 0)
+        std::cerr << "Could not remove " << folder << std::endl;
+    if (status == 0)
+        std::cout << "PASSED" << std::endl;
+    return status;
+}
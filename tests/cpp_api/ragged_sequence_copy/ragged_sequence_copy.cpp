@@ -0,0 +1,170 @@
+/*
+MIT License
+
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "opencv2/opencv.hpp"
+#include "rocal_api.h"
+
+// Loads sequences of frames of different sizes and copies them as ragged batches. A batch of sequences holds
+// batch size * sequence length frames, each with its own ROI, the ragged copy must pack all of them and match
+// the ROIs of the padded copy.
+
+namespace {
+// Compares each frame packed by copy_data_ragged() with its ROI in the padded copy of the batch, returns the number of mismatches
+int check_ragged_copy(RocalTensor tensor) {
+    auto dims = tensor->dims();  // N, F, H, W, C
+    if (dims.size() != 5 || tensor->layout() != RocalTensorLayout::ROCAL_NFHWC) {
+        std::cerr << "Expected an NFHWC sequence tensor" << std::endl;
+        return 1;
+    }
+    size_t frame_count = dims[0] * dims[1];
+    if (tensor->ragged_sample_count() != frame_count) {
+        std::cerr << "ragged_sample_count() is " << tensor->ragged_sample_count() << ", the batch has " << frame_count << " frames" << std::endl;
+        return 1;
+    }
+    size_t max_height = dims[2], max_width = dims[3], channels = dims[4];
+    std::vector<unsigned char> padded(tensor->data_size());
+    tensor->copy_data(padded.data());
+    std::vector<unsigned> roi(frame_count * 4);
+    tensor->copy_roi(roi.data());
+    std::vector<unsigned char> ragged(tensor->ragged_data_size());
+    // One more offset than frames, a copy sized with the sample count of a batch of images would write past it
+    std::vector<size_t> sample_offsets(frame_count + 1, SIZE_MAX);
+    tensor->copy_data_ragged(ragged.data(), sample_offsets.data());
+    if (sample_offsets[frame_count] != SIZE_MAX) {
+        std::cerr << "copy_data_ragged() wrote more offsets than frames" << std::endl;
+        return 1;
+    }
+
+    int mismatches = 0;
+    size_t expected_offset = 0;
+    for (size_t frame = 0; frame < frame_count; frame++) {
+        size_t x = roi[frame * 4], y = roi[frame * 4 + 1], width = roi[frame * 4 + 2], height = roi[frame * 4 + 3];
+        if (tensor->roi_type() == RocalROICordsType::ROCAL_LTRB) {
+            width = width - x + 1;
+            height = height - y + 1;
+        }
+        if (sample_offsets[frame] != expected_offset) {
+            std::cerr << "Frame " << frame << " is at offset " << sample_offsets[frame] << " instead of " << expected_offset << std::endl;
+            return mismatches + 1;
+        }
+        size_t row_size = width * channels;
+        auto src = padded.data() + frame * max_height * max_width * channels + (y * max_width + x) * channels;
+        for (size_t row = 0; row < height; row++)
+            if (memcmp(ragged.data() + expected_offset + row * row_size, src + row * max_width * channels, row_size) != 0)
+                mismatches++;
+        expected_offset += row_size * height;
+    }
+    if (expected_offset != ragged.size()) {
+        std::cerr << "The frames take " << expected_offset << " bytes, ragged_data_size() is " << ragged.size() << std::endl;
+        mismatches++;
+    }
+    return mismatches;
+}
+}  // namespace
+
+int main(int argc, const char **argv) {
+    int argIdx = 0;
+    int batch_size = 2;
+    int sequence_length = 3;
+    int sequence_count = 4;
+    if (argc > ++argIdx)
+        batch_size = atoi(argv[argIdx]);
+    if (argc > ++argIdx)
+        sequence_length = atoi(argv[argIdx]);
+    if (argc > ++argIdx)
+        sequence_count = atoi(argv[argIdx]);
+    if (batch_size < 1 || sequence_length < 1 || sequence_count < batch_size) {
+        printf("Usage: ragged_sequence_copy <batch size> <sequence length> <sequence count, at least the batch size>\n");
+        return -1;
+    }
+
+    // The frames of all the sequences are in one folder, the reader splits them in sequences of sequence_length frames
+    char folder_template[] = "/tmp/rocal_ragged_sequence_copy_XXXXXX";
+    if (!mkdtemp(folder_template)) {
+        std::cerr << "Could not create a temporary folder" << std::endl;
+        return -1;
+    }
+    std::string folder(folder_template);
+    std::string frame_folder = folder + "/video0";
+    mkdir(frame_folder.c_str(), 0755);
+    std::vector<std::string> frame_paths;
+    int frame_count = sequence_length * sequence_count;
+    for (int i = 0; i < frame_count; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "/frame_%04d.jpg", i);
+        frame_paths.push_back(frame_folder + name);
+        cv::Mat frame(48 + 4 * (i % 5), 64 + 8 * (i % 7), CV_8UC3, cv::Scalar(i * 20 % 256, 100, 255 - i * 20 % 256));
+        cv::imwrite(frame_paths.back(), frame);
+    }
+
+    int status = 0;
+    auto handle = rocalCreate(batch_size, RocalProcessMode::ROCAL_PROCESS_CPU, 0, 1);
+    if (rocalGetStatus(handle) != ROCAL_OK) {
+        std::cerr << "Could not create the Rocal context" << std::endl;
+        status = -1;
+    } else {
+        rocalSequenceReader(handle, folder.c_str(), RocalImageColor::ROCAL_COLOR_RGB24, 1, sequence_length, true, false, false, sequence_length, 1);
+        if (rocalGetStatus(handle) != ROCAL_OK || rocalVerify(handle) != ROCAL_OK) {
+            std::cerr << "Could not build the pipeline: " << rocalGetErrorMessage(handle) << std::endl;
+            status = -1;
+        } else {
+            int batches = 0;
+            while (!rocalIsEmpty(handle) && rocalRun(handle) == ROCAL_OK) {
+                auto outputs = rocalGetOutputTensors(handle);
+                int mismatches = check_ragged_copy(outputs->at(0));
+                if (mismatches) {
+                    std::cerr << "Batch " << batches << ": " << mismatches << " mismatches in the ragged copy" << std::endl;
+                    status = -1;
+                }
+                batches++;
+            }
+            if (batches == 0) {
+                std::cerr << "No batch was loaded" << std::endl;
+                status = -1;
+            }
+            std::cout << "Checked the ragged copy of " << batches << " batches of " << batch_size << " sequences of " << sequence_length << " frames" << std::endl;
+        }
+        rocalRelease(handle);
+    }
+
+    for (auto &path : frame_paths)
+        unlink(path.c_str());
+    rmdir(frame_folder.c_str());
+    if (rmdir(folder.c_str()) != 0)
+        std::cerr << "Could not remove " << folder << std::endl;
+    if (status == 0)
+        std::cout << "PASSED" << std::endl;
+    return status;
+}
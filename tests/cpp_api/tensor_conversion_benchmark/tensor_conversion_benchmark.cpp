@@ -0,0 +1,217 @@
+/*
+MIT License
+
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "pipeline/tensor_conversion.h"
+
+using namespace std::chrono;
+using tensor_conversion::ConvertArgs;
+using tensor_conversion::Isa;
+
+struct Case {
+    RocalTensorlayout layout;
+    RocalTensorDataType type;
+    unsigned channels;
+    bool reverse_channels;
+    bool planar_source;
+};
+
+static const char *type_name(RocalTensorDataType type) {
+    switch (type) {
+        case RocalTensorDataType::FP32:
+            return "FP32";
+        case RocalTensorDataType::FP16:
+            return "FP16";
+        case RocalTensorDataType::BF16:
+            return "BF16";
+        default:
+            return "UINT8";
+    }
+}
+
+static float half_to_float(uint16_t half) {
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1F;
+    const uint32_t mantissa = half & 0x3FF;
+    float value;
+    if (exponent == 0)
+        value = std::ldexp(static_cast<float>(mantissa), -24);
+    else if (exponent == 31)
+        value = mantissa ? NAN : INFINITY;
+    else
+        value = std::ldexp(static_cast<float>(mantissa | 0x400), static_cast<int>(exponent) - 25);
+    return sign ? -value : value;
+}
+
+static float element(const std::vector<uint8_t> &buffer, RocalTensorDataType type, size_t idx) {
+    if (type == RocalTensorDataType::FP32) {
+        float value;
+        std::memcpy(&value, buffer.data() + idx * sizeof(float), sizeof(float));
+        return value;
+    }
+    if (type == RocalTensorDataType::UINT8)
+        return buffer[idx];
+    uint16_t bits;
+    std::memcpy(&bits, buffer.data() + idx * sizeof(uint16_t), sizeof(uint16_t));
+    if (type == RocalTensorDataType::FP16)
+        return half_to_float(bits);
+    uint32_t bits32 = static_cast<uint32_t>(bits) << 16;
+    float value;
+    std::memcpy(&value, &bits32, sizeof(float));
+    return value;
+}
+
+//! Largest difference allowed with the scalar output, the vector kernels may fuse the multiply add and round once
+static bool matches(float value, float reference, RocalTensorDataType type) {
+    float tolerance;
+    switch (type) {
+        case RocalTensorDataType::FP32:
+            tolerance = 1e-5f * std::fabs(reference) + 1e-6f;
+            break;
+        case RocalTensorDataType::FP16:
+            tolerance = 1e-3f * std::fabs(reference) + 1e-6f;
+            break;
+        case RocalTensorDataType::BF16:
+            tolerance = 8e-3f * std::fabs(reference) + 1e-6f;
+            break;
+        default:
+            tolerance = 1.0f;
+            break;
+    }
+    return std::fabs(value - reference) <= tolerance;
+}
+
+int main(int argc, const char **argv) {
+    if (argc > 1 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help")) {
+        printf("Usage: tensor_conversion_benchmark <width> <height> <batch_size> <iterations> <roi_width> <roi_height>\n");
+        return 0;
+    }
+    int argIdx = 0;
+    const unsigned width = argc > ++argIdx ? atoi(argv[argIdx]) : 224;
+    const unsigned height = argc > ++argIdx ? atoi(argv[argIdx]) : 224;
+    const unsigned batch_size = argc > ++argIdx ? atoi(argv[argIdx]) : 64;
+    const unsigned iterations = argc > ++argIdx ? atoi(argv[argIdx]) : 20;
+    const unsigned roi_width = argc > ++argIdx ? atoi(argv[argIdx]) : width;
+    const unsigned roi_height = argc > ++argIdx ? atoi(argv[argIdx]) : height;
+    if (!width || !height || !batch_size || !iterations || !roi_width || !roi_height || roi_width > width || roi_height > height) {
+        printf("ERROR: invalid image or roi dimensions\n");
+        return -1;
+    }
+
+    std::vector<Isa> isas;
+    for (Isa isa : {Isa::SCALAR, Isa::SSE42, Isa::AVX2, Isa::AVX512})
+        if (tensor_conversion::is_supported(isa))
+            isas.push_back(isa);
+    printf("Image %ux%u, roi %ux%u, batch %u, %u iterations, fastest kernels: %s\n", width, height, roi_width, roi_height,
+           batch_size, iterations, tensor_conversion::isa_name(tensor_conversion::best_supported_isa()));
+
+    std::vector<Case> cases;
+    for (auto layout : {RocalTensorlayout::NHWC, RocalTensorlayout::NCHW})
+        for (auto type : {RocalTensorDataType::FP32, RocalTensorDataType::FP16, RocalTensorDataType::BF16, RocalTensorDataType::UINT8}) {
+            cases.push_back({layout, type, 1, false, false});
+            for (bool planar_source : {false, true})
+                for (bool reverse_channels : {false, true})
+                    cases.push_back({layout, type, 3, reverse_channels, planar_source});
+        }
+
+    std::mt19937 generator(42);
+    std::vector<uint8_t> input(static_cast<size_t>(width) * height * 3 * batch_size);
+    for (auto &value : input)
+        value = static_cast<uint8_t>(generator());
+
+    int failures = 0;
+    printf("%-5s %-5s %-2s %-8s %-11s", "out", "type", "c", "reverse", "source");
+    for (Isa isa : isas)
+        printf(" %13s", tensor_conversion::isa_name(isa));
+    printf("   (ms per batch, speedup over scalar)\n");
+    for (auto &test : cases) {
+        const size_t image_size = static_cast<size_t>(width) * height * test.channels;
+        const size_t output_image_elements = static_cast<size_t>(roi_width) * roi_height * test.channels;
+        const size_t element_size = tensor_conversion::output_element_size(test.type);
+        std::vector<uint8_t> reference(output_image_elements * batch_size * element_size);
+        std::vector<uint8_t> output(reference.size());
+        ConvertArgs args;
+        args.channels = test.channels;
+        args.width = roi_width;
+        args.height = roi_height;
+        args.src_row_stride = test.planar_source ? width : static_cast<size_t>(width) * test.channels;
+        args.src_plane_stride = test.planar_source ? static_cast<size_t>(width) * height : 0;
+        args.dst_layout = test.layout;
+        args.dst_type = test.type;
+        args.reverse_channels = test.reverse_channels;
+        const float multiplier[3] = {1.0f / (0.229f * 255.0f), 1.0f / (0.224f * 255.0f), 1.0f / (0.225f * 255.0f)};
+        const float offset[3] = {-0.485f / 0.229f, -0.456f / 0.224f, -0.406f / 0.225f};
+        for (unsigned channel = 0; channel < 3; channel++) {
+            // Keeps the UINT8 outputs in range
+            args.multiplier[channel] = test.type == RocalTensorDataType::UINT8 ? 0.5f + 0.25f * channel : multiplier[channel];
+            args.offset[channel] = test.type == RocalTensorDataType::UINT8 ? 10.0f * channel : offset[channel];
+        }
+
+        printf("%-5s %-5s %-2u %-8s %-11s", test.layout == RocalTensorlayout::NHWC ? "NHWC" : "NCHW", type_name(test.type),
+               test.channels, test.reverse_channels ? "yes" : "no", test.planar_source ? "planar" : "interleaved");
+        double scalar_time = 0;
+        for (Isa isa : isas) {
+            auto &out = isa == Isa::SCALAR ? reference : output;
+            auto run_batch = [&]() {
+                for (unsigned sample = 0; sample < batch_size; sample++) {
+                    args.src = input.data() + image_size * sample;
+                    args.dst = out.data() + output_image_elements * element_size * sample;
+                    tensor_conversion::convert(args, isa);
+                }
+            };
+            run_batch();
+            auto start = high_resolution_clock::now();
+            for (unsigned iteration = 0; iteration < iterations; iteration++)
+                run_batch();
+            double time = duration_cast<duration<double, std::milli>>(high_resolution_clock::now() - start).count() / iterations;
+            if (isa == Isa::SCALAR) {
+                scalar_time = time;
+                printf(" %13.3f", time);
+                continue;
+            }
+            printf(" %7.3f %4.1fx", time, scalar_time / time);
+            for (size_t idx = 0; idx < output_image_elements * batch_size; idx++) {
+                if (!matches(element(output, test.type, idx), element(reference, test.type, idx), test.type)) {
+                    printf("\nERROR: %s output differs from scalar at element %zu: %f vs %f\n", tensor_conversion::isa_name(isa), idx,
+                           element(output, test.type, idx), element(reference, test.type, idx));
+                    failures++;
+                    break;
+                }
+            }
+        }
+        printf("\n");
+    }
+    if (failures)
+        printf("%d kernel outputs differ from the scalar kernel\n", failures);
+    return failures ? -1 : 0;
+}